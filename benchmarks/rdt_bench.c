@@ -0,0 +1,472 @@
+/*
+ * RDT Benchmark Harness - C Implementation
+ * ========================================
+ * See rdt_bench.h.
+ *
+ * Author: Steven Reid
+ * ORCID: 0009-0003-9132-3410
+ * License: MIT
+ */
+
+#define _GNU_SOURCE
+#include "rdt_bench.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RDT_BENCH_TSC 1
+#endif
+
+/* ========================================================================== */
+/* Clocks                                                                     */
+/* ========================================================================== */
+
+uint64_t rdt_bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int rdt_bench_have_tsc(void) {
+#ifdef RDT_BENCH_TSC
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+uint64_t rdt_bench_tsc(void) {
+#ifdef RDT_BENCH_TSC
+    return (uint64_t)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+double rdt_bench_tsc_hz(void) {
+    static double hz = -1.0;
+
+    if (hz < 0.0) {
+        uint64_t t0, c0, t1, c1;
+
+        if (!rdt_bench_have_tsc()) {
+            hz = 0.0;
+            return hz;
+        }
+        t0 = rdt_bench_now_ns();
+        c0 = rdt_bench_tsc();
+        do {
+            t1 = rdt_bench_now_ns();
+        } while (t1 - t0 < 50000000ull);
+        c1 = rdt_bench_tsc();
+        hz = (double)(c1 - c0) * 1e9 / (double)(t1 - t0);
+    }
+    return hz;
+}
+
+uint64_t rdt_bench_ticks_overhead(void) {
+    uint64_t best = UINT64_MAX;
+
+    for (int i = 0; i < 10000; i++) {
+        uint64_t t0 = rdt_bench_ticks_begin();
+        uint64_t t1 = rdt_bench_ticks_end();
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    return best;
+}
+
+/* ========================================================================== */
+/* Environment                                                                */
+/* ========================================================================== */
+
+int rdt_bench_nth_cpu(unsigned n) {
+    cpu_set_t set;
+
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return -1;
+    for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set) && n-- == 0) return (int)cpu;
+    }
+    return -1;
+}
+
+unsigned rdt_bench_cpu_count(void) {
+    cpu_set_t set;
+
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) return 1;
+    return (unsigned)CPU_COUNT(&set);
+}
+
+int rdt_bench_pin(int cpu) {
+    cpu_set_t set;
+
+    if (cpu < 0) cpu = rdt_bench_nth_cpu(0);
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return -1;
+    CPU_ZERO(&set);
+    CPU_SET((size_t)cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) return -1;
+    return cpu;
+}
+
+void rdt_bench_cpu_model(char *buf, size_t len) {
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    char line[512];
+
+    snprintf(buf, len, "unknown");
+    if (!f) return;
+    while (fgets(line, sizeof(line), f)) {
+        char *colon = strchr(line, ':');
+        if (strncmp(line, "model name", 10) == 0 && colon) {
+            char *v = colon + 1;
+            while (*v == ' ' || *v == '\t') v++;
+            v[strcspn(v, "\n")] = '\0';
+            snprintf(buf, len, "%s", v);
+            break;
+        }
+    }
+    fclose(f);
+}
+
+/* ========================================================================== */
+/* Hardware counters                                                          */
+/* ========================================================================== */
+
+static const char *const perf_names[RDT_BENCH_PERF_EVENTS] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses"
+};
+
+const char *rdt_bench_perf_name(unsigned event) {
+    return event < RDT_BENCH_PERF_EVENTS ? perf_names[event] : "unknown";
+}
+
+#ifdef __linux__
+static int perf_open_event(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+unsigned rdt_bench_perf_open(rdt_bench_perf *p) {
+    p->opened = 0;
+    for (unsigned e = 0; e < RDT_BENCH_PERF_EVENTS; e++) p->fd[e] = -1;
+#ifdef __linux__
+    p->fd[RDT_BENCH_PERF_CYCLES] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    p->fd[RDT_BENCH_PERF_INSTRUCTIONS] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    p->fd[RDT_BENCH_PERF_BRANCH_MISSES] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    p->fd[RDT_BENCH_PERF_L1D_MISSES] =
+        perf_open_event(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    p->fd[RDT_BENCH_PERF_LLC_MISSES] = perf_open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    for (unsigned e = 0; e < RDT_BENCH_PERF_EVENTS; e++) {
+        if (p->fd[e] >= 0) p->opened++;
+        else p->fd[e] = -1;
+    }
+#endif
+    rdt_bench_perf_clear(p);
+    return p->opened;
+}
+
+void rdt_bench_perf_close(rdt_bench_perf *p) {
+    for (unsigned e = 0; e < RDT_BENCH_PERF_EVENTS; e++) {
+#ifdef __linux__
+        if (p->fd[e] >= 0) close(p->fd[e]);
+#endif
+        p->fd[e] = -1;
+    }
+    p->opened = 0;
+}
+
+void rdt_bench_perf_clear(rdt_bench_perf *p) {
+    for (unsigned e = 0; e < RDT_BENCH_PERF_EVENTS; e++) p->count[e] = p->fd[e] >= 0 ? 0.0 : NAN;
+}
+
+void rdt_bench_perf_start(rdt_bench_perf *p) {
+#ifdef __linux__
+    for (unsigned e = 0; e < RDT_BENCH_PERF_EVENTS; e++) {
+        if (p->fd[e] < 0) continue;
+        ioctl(p->fd[e], PERF_EVENT_IOC_RESET, 0);
+        ioctl(p->fd[e], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)p;
+#endif
+}
+
+void rdt_bench_perf_stop(rdt_bench_perf *p) {
+#ifdef __linux__
+    uint64_t v[3];  /* value, time enabled, time running */
+
+    for (unsigned e = 0; e < RDT_BENCH_PERF_EVENTS; e++) {
+        if (p->fd[e] >= 0) ioctl(p->fd[e], PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (unsigned e = 0; e < RDT_BENCH_PERF_EVENTS; e++) {
+        if (p->fd[e] < 0 || read(p->fd[e], v, sizeof(v)) != (ssize_t)sizeof(v)) continue;
+        if (v[2] == 0) continue;
+        p->count[e] += (double)v[0] * ((double)v[1] / (double)v[2]);
+    }
+#else
+    (void)p;
+#endif
+}
+
+/* ========================================================================== */
+/* Statistics                                                                 */
+/* ========================================================================== */
+
+/* Two-sided 95% Student t critical values for 1..30 degrees of freedom */
+static const double t975[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+void rdt_bench_summarize(const double *samples, size_t n, rdt_bench_summary *out) {
+    double sum = 0.0, ss = 0.0, half = 0.0;
+    double *sorted;
+
+    memset(out, 0, sizeof(*out));
+    out->n = n;
+    if (!n) return;
+
+    for (size_t i = 0; i < n; i++) sum += samples[i];
+    out->mean = sum / (double)n;
+    for (size_t i = 0; i < n; i++) ss += (samples[i] - out->mean) * (samples[i] - out->mean);
+    if (n > 1) {
+        double t = (n - 1u <= 30u) ? t975[n - 2u] : 1.960;
+        out->stddev = sqrt(ss / (double)(n - 1u));
+        half = t * out->stddev / sqrt((double)n);
+    }
+    out->ci95_low = out->mean - half;
+    out->ci95_high = out->mean + half;
+
+    sorted = (double *)malloc(n * sizeof(double));
+    if (sorted) {
+        memcpy(sorted, samples, n * sizeof(double));
+        qsort(sorted, n, sizeof(double), compare_double);
+        out->min = sorted[0];
+        out->max = sorted[n - 1u];
+        out->median = (n & 1u) ? sorted[n / 2u] : 0.5 * (sorted[n / 2u - 1u] + sorted[n / 2u]);
+        free(sorted);
+    } else {
+        out->min = out->max = out->median = out->mean;
+    }
+}
+
+#define HIST_SUB (1u << RDT_BENCH_HIST_SUB_BITS)
+
+static size_t hist_index(uint64_t v) {
+    unsigned e;
+
+    if (v < HIST_SUB) return (size_t)v;
+    e = 63u - (unsigned)__builtin_clzll(v);
+    return ((size_t)(e - RDT_BENCH_HIST_SUB_BITS + 1u) << RDT_BENCH_HIST_SUB_BITS) +
+           (size_t)((v >> (e - RDT_BENCH_HIST_SUB_BITS)) & (HIST_SUB - 1u));
+}
+
+/* Largest value that lands in bucket i */
+static uint64_t hist_bucket_top(size_t i) {
+    size_t band = i >> RDT_BENCH_HIST_SUB_BITS;
+    unsigned shift;
+
+    if (band == 0) return (uint64_t)i;
+    shift = (unsigned)band - 1u;
+    return ((((uint64_t)HIST_SUB + (i & (HIST_SUB - 1u))) + 1u) << shift) - 1u;
+}
+
+void rdt_bench_hist_reset(rdt_bench_hist *h) {
+    memset(h, 0, sizeof(*h));
+    h->min = UINT64_MAX;
+}
+
+void rdt_bench_hist_record(rdt_bench_hist *h, uint64_t value) {
+    h->counts[hist_index(value)]++;
+    h->total++;
+    h->sum += (double)value;
+    if (value < h->min) h->min = value;
+    if (value > h->max) h->max = value;
+}
+
+uint64_t rdt_bench_hist_percentile(const rdt_bench_hist *h, double p) {
+    uint64_t rank, seen = 0;
+
+    if (!h->total) return 0;
+    if (p >= 100.0) return h->max;
+    rank = (uint64_t)ceil(p / 100.0 * (double)h->total);
+    if (rank == 0) rank = 1;
+    for (size_t i = 0; i < RDT_BENCH_HIST_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) {
+            uint64_t top = hist_bucket_top(i);
+            return top < h->max ? top : h->max;
+        }
+    }
+    return h->max;
+}
+
+/* ========================================================================== */
+/* Output                                                                     */
+/* ========================================================================== */
+
+static void json_indent(rdt_bench_json *j) {
+    for (int i = 0; i < j->depth; i++) fputs("  ", j->f);
+}
+
+/* Comma, newline and indent before the next member, then "key": */
+static void json_key(rdt_bench_json *j, const char *key) {
+    if (!j->first[j->depth]) fputc(',', j->f);
+    j->first[j->depth] = 0;
+    fputc('\n', j->f);
+    json_indent(j);
+    if (key) fprintf(j->f, "\"%s\": ", key);
+}
+
+static void json_open(rdt_bench_json *j, const char *key, char c) {
+    json_key(j, key);
+    fputc(c, j->f);
+    if (j->depth + 1 < (int)(sizeof(j->first) / sizeof(j->first[0]))) j->depth++;
+    j->first[j->depth] = 1;
+}
+
+static void json_close(rdt_bench_json *j, char c) {
+    int empty = j->first[j->depth];
+    if (j->depth > 0) j->depth--;
+    if (!empty) {
+        fputc('\n', j->f);
+        json_indent(j);
+    }
+    fputc(c, j->f);
+}
+
+void rdt_bench_json_begin(rdt_bench_json *j, FILE *f) {
+    memset(j, 0, sizeof(*j));
+    j->f = f;
+    fputc('{', f);
+    j->first[0] = 1;
+}
+
+void rdt_bench_json_end(rdt_bench_json *j) {
+    fputs("\n}\n", j->f);
+}
+
+void rdt_bench_json_object(rdt_bench_json *j, const char *key) {
+    json_open(j, key, '{');
+}
+
+void rdt_bench_json_array(rdt_bench_json *j, const char *key) {
+    json_open(j, key, '[');
+}
+
+void rdt_bench_json_close_object(rdt_bench_json *j) {
+    json_close(j, '}');
+}
+
+void rdt_bench_json_close_array(rdt_bench_json *j) {
+    json_close(j, ']');
+}
+
+void rdt_bench_json_string(rdt_bench_json *j, const char *key, const char *value) {
+    json_key(j, key);
+    fputc('"', j->f);
+    for (; *value; value++) {
+        if (*value == '"' || *value == '\\') fputc('\\', j->f);
+        if ((unsigned char)*value >= 0x20u) fputc(*value, j->f);
+    }
+    fputc('"', j->f);
+}
+
+void rdt_bench_json_number(rdt_bench_json *j, const char *key, double value) {
+    json_key(j, key);
+    if (isfinite(value)) {
+        fprintf(j->f, "%.17g", value);
+    } else {
+        fputs("null", j->f);
+    }
+}
+
+void rdt_bench_json_uint(rdt_bench_json *j, const char *key, uint64_t value) {
+    json_key(j, key);
+    fprintf(j->f, "%llu", (unsigned long long)value);
+}
+
+void rdt_bench_json_summary(rdt_bench_json *j, const char *key, const rdt_bench_summary *s) {
+    char name[128];
+
+    rdt_bench_json_number(j, key, s->mean);
+    snprintf(name, sizeof(name), "%s_ci95", key);
+    json_key(j, name);
+    if (isfinite(s->ci95_low) && isfinite(s->ci95_high)) {
+        fprintf(j->f, "[%.17g, %.17g]", s->ci95_low, s->ci95_high);
+    } else {
+        fputs("null", j->f);
+    }
+    snprintf(name, sizeof(name), "%s_stddev", key);
+    rdt_bench_json_number(j, name, s->stddev);
+    snprintf(name, sizeof(name), "%s_median", key);
+    rdt_bench_json_number(j, name, s->median);
+    snprintf(name, sizeof(name), "%s_min", key);
+    rdt_bench_json_number(j, name, s->min);
+    snprintf(name, sizeof(name), "%s_max", key);
+    rdt_bench_json_number(j, name, s->max);
+}
+
+void rdt_bench_json_environment(rdt_bench_json *j, int pinned_cpu) {
+    char model[256];
+
+    rdt_bench_cpu_model(model, sizeof(model));
+    rdt_bench_json_object(j, "environment");
+    rdt_bench_json_string(j, "cpu", model);
+#if defined(__clang__)
+    rdt_bench_json_string(j, "compiler", "clang " __clang_version__);
+#elif defined(__GNUC__)
+    rdt_bench_json_string(j, "compiler", "gcc " __VERSION__);
+#else
+    rdt_bench_json_string(j, "compiler", "unknown");
+#endif
+    rdt_bench_json_uint(j, "cpus", rdt_bench_cpu_count());
+    if (pinned_cpu >= 0) {
+        rdt_bench_json_number(j, "pinned_cpu", (double)pinned_cpu);
+    } else {
+        rdt_bench_json_number(j, "pinned_cpu", NAN);
+    }
+    rdt_bench_json_number(j, "tsc_hz", rdt_bench_have_tsc() ? rdt_bench_tsc_hz() : NAN);
+    rdt_bench_json_close_object(j);
+}
+
+FILE *rdt_bench_open(const char *path) {
+    if (!path || strcmp(path, "-") == 0) return stdout;
+    return fopen(path, "w");
+}
+
+void rdt_bench_close(FILE *f) {
+    if (f && f != stdout) {
+        fclose(f);
+    } else if (f) {
+        fflush(f);
+    }
+}
@@ -0,0 +1,225 @@
+/*
+ * RDT Benchmark Harness
+ * =====================
+ * Shared pieces of the in-process C benchmarks: clocks, CPU pinning,
+ * trial statistics and the JSON / Markdown writers that produce the
+ * results/ files. Each benchmark program links the generators directly,
+ * so nothing is measured through a pipe.
+ *
+ * Author: Steven Reid
+ * ORCID: 0009-0003-9132-3410
+ * License: MIT
+ */
+
+#ifndef RDT_BENCH_H
+#define RDT_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* Clocks                                                                     */
+/* ========================================================================== */
+
+/* CLOCK_MONOTONIC in nanoseconds */
+uint64_t rdt_bench_now_ns(void);
+
+/*
+ * Time-stamp counter, or 0 where there is none. The TSC counts reference
+ * cycles at a fixed rate, not core cycles, so cycles/byte from it does not
+ * move with turbo or frequency scaling.
+ */
+int rdt_bench_have_tsc(void);
+uint64_t rdt_bench_tsc(void);
+
+/* TSC ticks per second, measured against CLOCK_MONOTONIC once; 0 without a TSC */
+double rdt_bench_tsc_hz(void);
+
+/*
+ * Ticks for timing one short call: the TSC fenced so the timed code cannot
+ * move across the reads, or CLOCK_MONOTONIC nanoseconds without a TSC.
+ * rdt_bench_ticks_hz() converts.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+
+static inline uint64_t rdt_bench_ticks_begin(void) {
+    _mm_lfence();
+    return (uint64_t)__rdtsc();
+}
+
+static inline uint64_t rdt_bench_ticks_end(void) {
+    unsigned aux;
+    uint64_t t = (uint64_t)__rdtscp(&aux);
+    _mm_lfence();
+    return t;
+}
+
+static inline double rdt_bench_ticks_hz(void) {
+    return rdt_bench_tsc_hz();
+}
+#else
+static inline uint64_t rdt_bench_ticks_begin(void) {
+    return rdt_bench_now_ns();
+}
+
+static inline uint64_t rdt_bench_ticks_end(void) {
+    return rdt_bench_now_ns();
+}
+
+static inline double rdt_bench_ticks_hz(void) {
+    return 1e9;
+}
+#endif
+
+/* Smallest begin/end difference with nothing in between, in ticks */
+uint64_t rdt_bench_ticks_overhead(void);
+
+/* ========================================================================== */
+/* Environment                                                                */
+/* ========================================================================== */
+
+/*
+ * Pin the calling thread to cpu, or to the first CPU it may run on when cpu
+ * is negative. Returns the CPU pinned to, or -1 if pinning is unavailable.
+ */
+int rdt_bench_pin(int cpu);
+
+/* The n-th CPU (0-based) in the process affinity mask, or -1 */
+int rdt_bench_nth_cpu(unsigned n);
+
+/* CPUs in the process affinity mask */
+unsigned rdt_bench_cpu_count(void);
+
+/* "model name" from /proc/cpuinfo, or "unknown" */
+void rdt_bench_cpu_model(char *buf, size_t len);
+
+/* ========================================================================== */
+/* Hardware counters                                                          */
+/* ========================================================================== */
+
+/*
+ * Optional perf_event_open counters for the calling thread, user space only.
+ * Each event is opened on its own, so a PMU that lacks one event still
+ * reports the others, and counts are scaled by enabled / running time when
+ * the kernel multiplexes. Where perf events are unavailable (not Linux, a VM
+ * without a PMU, perf_event_paranoid) nothing opens, the calls below do
+ * nothing and the counts stay NaN: the benchmark is then timing only.
+ */
+enum {
+    RDT_BENCH_PERF_CYCLES,
+    RDT_BENCH_PERF_INSTRUCTIONS,
+    RDT_BENCH_PERF_BRANCH_MISSES,
+    RDT_BENCH_PERF_L1D_MISSES,      /* L1 data cache read misses */
+    RDT_BENCH_PERF_LLC_MISSES,
+    RDT_BENCH_PERF_EVENTS
+};
+
+typedef struct {
+    int fd[RDT_BENCH_PERF_EVENTS];         /* -1 where the event did not open */
+    double count[RDT_BENCH_PERF_EVENTS];   /* summed over start/stop pairs; NaN if not open */
+    unsigned opened;
+} rdt_bench_perf;
+
+/* Open the events; returns how many opened (0: timing only) */
+unsigned rdt_bench_perf_open(rdt_bench_perf *p);
+void rdt_bench_perf_close(rdt_bench_perf *p);
+
+/* Zero the accumulated counts */
+void rdt_bench_perf_clear(rdt_bench_perf *p);
+
+/* Count between start and stop, adding to count[] */
+void rdt_bench_perf_start(rdt_bench_perf *p);
+void rdt_bench_perf_stop(rdt_bench_perf *p);
+
+/* "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses" */
+const char *rdt_bench_perf_name(unsigned event);
+
+/* ========================================================================== */
+/* Statistics                                                                 */
+/* ========================================================================== */
+
+/*
+ * Summary of n trial measurements. The 95% interval is for the mean:
+ * mean +/- t(0.975, n - 1) * stddev / sqrt(n).
+ */
+typedef struct {
+    size_t n;
+    double mean;
+    double stddev;
+    double ci95_low;
+    double ci95_high;
+    double median;
+    double min;
+    double max;
+} rdt_bench_summary;
+
+void rdt_bench_summarize(const double *samples, size_t n, rdt_bench_summary *out);
+
+/*
+ * HDR-style latency histogram over 64-bit values: exact below
+ * 2^RDT_BENCH_HIST_SUB_BITS, then 2^RDT_BENCH_HIST_SUB_BITS linear buckets
+ * per power of two, so any recorded value is known to within 1/32 of
+ * itself. Percentiles report the top of the bucket they fall in (never
+ * above the true maximum), the conservative reading for latency.
+ */
+#define RDT_BENCH_HIST_SUB_BITS 5u
+#define RDT_BENCH_HIST_BUCKETS (64u << RDT_BENCH_HIST_SUB_BITS)
+
+typedef struct {
+    uint64_t counts[RDT_BENCH_HIST_BUCKETS];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    double sum;
+} rdt_bench_hist;
+
+void rdt_bench_hist_reset(rdt_bench_hist *h);
+void rdt_bench_hist_record(rdt_bench_hist *h, uint64_t value);
+
+/* Value at percentile p (0..100); 0 for an empty histogram */
+uint64_t rdt_bench_hist_percentile(const rdt_bench_hist *h, double p);
+
+/* ========================================================================== */
+/* Output                                                                     */
+/* ========================================================================== */
+
+/*
+ * JSON in the shape of the other results/ files: one object per result,
+ * flat keys, a summary written as key (the mean), key_ci95 [low, high],
+ * key_stddev, key_median, key_min and key_max. The writer tracks commas.
+ */
+typedef struct {
+    FILE *f;
+    int depth;
+    int first[8];
+} rdt_bench_json;
+
+void rdt_bench_json_begin(rdt_bench_json *j, FILE *f);
+void rdt_bench_json_end(rdt_bench_json *j);
+void rdt_bench_json_object(rdt_bench_json *j, const char *key);  /* key NULL inside arrays */
+void rdt_bench_json_array(rdt_bench_json *j, const char *key);
+void rdt_bench_json_close_object(rdt_bench_json *j);
+void rdt_bench_json_close_array(rdt_bench_json *j);
+void rdt_bench_json_string(rdt_bench_json *j, const char *key, const char *value);
+void rdt_bench_json_number(rdt_bench_json *j, const char *key, double value);  /* NaN as null */
+void rdt_bench_json_uint(rdt_bench_json *j, const char *key, uint64_t value);
+void rdt_bench_json_summary(rdt_bench_json *j, const char *key, const rdt_bench_summary *s);
+
+/* "environment" object: CPU, compiler, TSC rate and the pinned CPU */
+void rdt_bench_json_environment(rdt_bench_json *j, int pinned_cpu);
+
+/* Open path for writing, or stdout for NULL / "-"; NULL on failure */
+FILE *rdt_bench_open(const char *path);
+void rdt_bench_close(FILE *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RDT_BENCH_H */
@@ -0,0 +1,410 @@
+/*
+ * RDT Latency Benchmark
+ * =====================
+ * Per-call latency of the generators for request sizes from 8 B to 64 KiB.
+ * Every call is timed on its own with fenced TSC reads (less the measured
+ * timer overhead) and recorded in an HDR-style histogram, reported as
+ * p50 / p90 / p99 / p99.9 / max.
+ *
+ * Besides plain requests, a few series isolate the DRBG state steps:
+ * generate with additional input (one extra update before the output),
+ * reseed on its own, and generate with a reseed every RESEED_EVERY calls,
+ * whose cost shows up in the tail percentiles only.
+ *
+ * Author: Steven Reid
+ * ORCID: 0009-0003-9132-3410
+ * License: MIT
+ *
+ * Usage:
+ *   rdt_bench_latency [--calls N] [--min-calls N] [--max-time S] [--cpu N]
+ *                     [--only a,b,...] [--out FILE.json] [--report FILE.md]
+ */
+
+#include "rdt_bench.h"
+#include "rdt256_stream_v2.h"
+#include "rdt_drbg.h"
+#include "rdt_drbg_v2.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LATENCY_MAX_BYTES (64u * 1024u)
+#define RESEED_EVERY 256u
+
+static const size_t sizes[] = {8, 16, 32, 64, 256, 1024, 4096, 16384, 65536};
+#define N_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+static rdt_drbg_v2_ctx drbg_v2;
+static rdt_drbg_ctx drbg;
+static uint64_t calls_made;
+static volatile uint64_t sink;
+
+static const uint8_t additional[32] = {
+    0x61, 0x64, 0x64, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x61, 0x6c, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74,
+    0x2d, 0x72, 0x64, 0x74, 0x2d, 0x6c, 0x61, 0x74, 0x65, 0x6e, 0x63, 0x79, 0x2d, 0x62, 0x65, 0x6e
+};
+static const uint8_t entropy[48] = {
+    0x9d, 0x3c, 0x1f, 0x5e, 0xa2, 0x47, 0x0b, 0xe6, 0x71, 0x28, 0xc4, 0x93, 0x5a, 0x0e, 0xf7, 0x36,
+    0x8b, 0xd2, 0x19, 0x64, 0xaf, 0x03, 0x5c, 0xe8, 0x27, 0x91, 0x4d, 0xb6, 0x0a, 0x73, 0xce, 0x15,
+    0x58, 0xe4, 0x2b, 0x96, 0x3f, 0xc1, 0x7a, 0x0d, 0xb2, 0x69, 0xf0, 0x14, 0x87, 0x5d, 0x2e, 0xa9
+};
+
+/* ========================================================================== */
+/* Series                                                                     */
+/* ========================================================================== */
+
+/* One call of a series: request bytes into buf */
+typedef void (*call_fn)(uint8_t *buf, size_t request);
+
+typedef struct {
+    const char *name;   /* series name, the request size is appended */
+    const char *api;
+    const char *step;   /* which DRBG steps one call performs */
+    call_fn call;
+    int sized;          /* run at every entry of sizes[], else once at request */
+    size_t request;
+} series;
+
+static void call_prng_v2_next(uint8_t *buf, size_t request) {
+    (void)buf;
+    (void)request;
+    sink ^= rdt_prng_v2_next();
+}
+
+static void call_prng_v2_fill(uint8_t *buf, size_t request) {
+    rdt_prng_v2_fill(buf, request);
+}
+
+static void call_drbg_v2_next_u64(uint8_t *buf, size_t request) {
+    uint64_t v;
+    (void)buf;
+    (void)request;
+    rdt_drbg_v2_next_u64(&drbg_v2, &v);
+    sink ^= v;
+}
+
+static void call_drbg_v2_generate(uint8_t *buf, size_t request) {
+    rdt_drbg_v2_generate(&drbg_v2, buf, request, NULL, 0, 0);
+}
+
+static void call_drbg_v2_generate_additional(uint8_t *buf, size_t request) {
+    rdt_drbg_v2_generate(&drbg_v2, buf, request, additional, sizeof(additional), 0);
+}
+
+static void call_drbg_v2_reseed(uint8_t *buf, size_t request) {
+    (void)buf;
+    (void)request;
+    rdt_drbg_v2_reseed(&drbg_v2, entropy, sizeof(entropy), NULL, 0);
+}
+
+static void call_drbg_v2_generate_reseeding(uint8_t *buf, size_t request) {
+    if (++calls_made % RESEED_EVERY == 0) {
+        rdt_drbg_v2_reseed(&drbg_v2, entropy, sizeof(entropy), NULL, 0);
+    }
+    rdt_drbg_v2_generate(&drbg_v2, buf, request, NULL, 0, 0);
+}
+
+static void call_drbg_next_u64(uint8_t *buf, size_t request) {
+    (void)buf;
+    (void)request;
+    sink ^= rdt_drbg_ctx_next_u64(&drbg);
+}
+
+static void call_drbg_generate(uint8_t *buf, size_t request) {
+    rdt_drbg_ctx_generate(&drbg, buf, request, NULL, 0, 0);
+}
+
+static void call_drbg_generate_additional(uint8_t *buf, size_t request) {
+    rdt_drbg_ctx_generate(&drbg, buf, request, additional, sizeof(additional), 0);
+}
+
+static void call_drbg_reseed(uint8_t *buf, size_t request) {
+    (void)buf;
+    (void)request;
+    rdt_drbg_ctx_reseed(&drbg, entropy, sizeof(entropy), NULL, 0);
+}
+
+static void call_drbg_generate_reseeding(uint8_t *buf, size_t request) {
+    if (++calls_made % RESEED_EVERY == 0) {
+        rdt_drbg_ctx_reseed(&drbg, entropy, sizeof(entropy), NULL, 0);
+    }
+    rdt_drbg_ctx_generate(&drbg, buf, request, NULL, 0, 0);
+}
+
+static const series all_series[] = {
+    {"rdt_prng_v2_next", "rdt_prng_v2_next", "output", call_prng_v2_next, 0, 8},
+    {"rdt_prng_v2_fill", "rdt_prng_v2_fill", "output", call_prng_v2_fill, 1, 0},
+    {"rdt_drbg_v2_next_u64", "rdt_drbg_v2_next_u64", "output + update", call_drbg_v2_next_u64, 0, 8},
+    {"rdt_drbg_v2_generate", "rdt_drbg_v2_generate", "output + update", call_drbg_v2_generate, 1, 0},
+    {"rdt_drbg_v2_generate_additional", "rdt_drbg_v2_generate (32 B additional input)",
+     "update + output + update", call_drbg_v2_generate_additional, 0, 16},
+    {"rdt_drbg_v2_reseed", "rdt_drbg_v2_reseed (48 B entropy)", "reseed", call_drbg_v2_reseed, 0, 0},
+    {"rdt_drbg_v2_generate_reseed_256", "rdt_drbg_v2_generate, reseed every 256 calls",
+     "output + update, reseed on 1 in 256", call_drbg_v2_generate_reseeding, 0, 16},
+    {"rdt_drbg_next_u64", "rdt_drbg_ctx_next_u64 (legacy)", "output + update", call_drbg_next_u64, 0, 8},
+    {"rdt_drbg_generate", "rdt_drbg_ctx_generate (legacy)", "output + update", call_drbg_generate, 1, 0},
+    {"rdt_drbg_generate_additional", "rdt_drbg_ctx_generate (legacy, 32 B additional input)",
+     "update + output + update", call_drbg_generate_additional, 0, 16},
+    {"rdt_drbg_reseed", "rdt_drbg_ctx_reseed (legacy, 48 B entropy)", "reseed", call_drbg_reseed, 0, 0},
+    {"rdt_drbg_generate_reseed_256", "rdt_drbg_ctx_generate (legacy), reseed every 256 calls",
+     "output + update, reseed on 1 in 256", call_drbg_generate_reseeding, 0, 16},
+};
+
+#define N_SERIES (sizeof(all_series) / sizeof(all_series[0]))
+#define MAX_ROWS (N_SERIES * N_SIZES)
+
+/* ========================================================================== */
+/* Measurement                                                                */
+/* ========================================================================== */
+
+typedef struct {
+    const series *s;
+    size_t request;
+    uint64_t calls;
+    double p50, p90, p99, p999, max, min, mean;  /* nanoseconds */
+} row;
+
+typedef struct {
+    uint64_t calls;
+    uint64_t min_calls;
+    double max_time;
+    int cpu;
+} config;
+
+static double ticks_to_ns(uint64_t ticks) {
+    return (double)ticks * 1e9 / rdt_bench_ticks_hz();
+}
+
+static void measure(const series *s, size_t request, const config *cfg, uint64_t overhead, uint8_t *buf,
+                    rdt_bench_hist *h, row *out) {
+    uint64_t warmup = cfg->min_calls < 100u ? cfg->min_calls : 100u;
+    uint64_t start, calls;
+
+    for (uint64_t i = 0; i < warmup; i++) s->call(buf, request);
+    calls_made = 0;
+
+    rdt_bench_hist_reset(h);
+    start = rdt_bench_now_ns();
+    for (calls = 0; calls < cfg->calls; calls++) {
+        uint64_t t0, t1, d;
+
+        if (calls >= cfg->min_calls && (calls & 15u) == 0 &&
+            (double)(rdt_bench_now_ns() - start) * 1e-9 >= cfg->max_time) {
+            break;
+        }
+        t0 = rdt_bench_ticks_begin();
+        s->call(buf, request);
+        t1 = rdt_bench_ticks_end();
+        d = t1 - t0;
+        rdt_bench_hist_record(h, d > overhead ? d - overhead : 0);
+    }
+
+    out->s = s;
+    out->request = request;
+    out->calls = calls;
+    out->p50 = ticks_to_ns(rdt_bench_hist_percentile(h, 50.0));
+    out->p90 = ticks_to_ns(rdt_bench_hist_percentile(h, 90.0));
+    out->p99 = ticks_to_ns(rdt_bench_hist_percentile(h, 99.0));
+    out->p999 = ticks_to_ns(rdt_bench_hist_percentile(h, 99.9));
+    out->max = ticks_to_ns(h->max);
+    out->min = ticks_to_ns(h->min);
+    out->mean = h->sum / (double)h->total * 1e9 / rdt_bench_ticks_hz();
+}
+
+/* ========================================================================== */
+/* Output                                                                     */
+/* ========================================================================== */
+
+static void write_json(FILE *f, const config *cfg, int pinned, double overhead_ns, const row *rows, size_t n) {
+    rdt_bench_json j;
+
+    rdt_bench_json_begin(&j, f);
+    rdt_bench_json_environment(&j, pinned);
+    rdt_bench_json_object(&j, "config");
+    rdt_bench_json_uint(&j, "max_calls", cfg->calls);
+    rdt_bench_json_uint(&j, "min_calls", cfg->min_calls);
+    rdt_bench_json_number(&j, "max_time_per_series_s", cfg->max_time);
+    rdt_bench_json_number(&j, "timer_overhead_ns", overhead_ns);
+    rdt_bench_json_uint(&j, "histogram_sub_buckets", 1u << RDT_BENCH_HIST_SUB_BITS);
+    rdt_bench_json_uint(&j, "reseed_every", RESEED_EVERY);
+    rdt_bench_json_close_object(&j);
+
+    rdt_bench_json_array(&j, "results");
+    for (size_t i = 0; i < n; i++) {
+        const row *r = &rows[i];
+        rdt_bench_json_object(&j, NULL);
+        rdt_bench_json_string(&j, "name", r->s->name);
+        rdt_bench_json_string(&j, "api", r->s->api);
+        rdt_bench_json_string(&j, "steps", r->s->step);
+        rdt_bench_json_uint(&j, "request_bytes", r->request);
+        rdt_bench_json_uint(&j, "calls", r->calls);
+        rdt_bench_json_number(&j, "latency_ns_min", r->min);
+        rdt_bench_json_number(&j, "latency_ns_mean", r->mean);
+        rdt_bench_json_number(&j, "latency_ns_p50", r->p50);
+        rdt_bench_json_number(&j, "latency_ns_p90", r->p90);
+        rdt_bench_json_number(&j, "latency_ns_p99", r->p99);
+        rdt_bench_json_number(&j, "latency_ns_p99_9", r->p999);
+        rdt_bench_json_number(&j, "latency_ns_max", r->max);
+        rdt_bench_json_number(&j, "ns_per_byte_p50", r->request ? r->p50 / (double)r->request : 0.0);
+        rdt_bench_json_close_object(&j);
+    }
+    rdt_bench_json_close_array(&j);
+    rdt_bench_json_end(&j);
+}
+
+static void write_report(FILE *f, const config *cfg, int pinned, double overhead_ns, const row *rows, size_t n) {
+    char model[256];
+
+    rdt_bench_cpu_model(model, sizeof(model));
+    fprintf(f, "# RDT256 Per-Call Latency Benchmark\n\n");
+    fprintf(f, "- CPU: `%s`", model);
+    if (pinned >= 0) fprintf(f, " (pinned to CPU %d)", pinned);
+    fprintf(f, "\n- up to `%llu` calls per row (at least `%llu`, about `%.3g s`), timer overhead `%.1f ns` subtracted\n",
+            (unsigned long long)cfg->calls, (unsigned long long)cfg->min_calls, cfg->max_time, overhead_ns);
+    fprintf(f, "- percentiles from a log-linear histogram, accurate to 1/%u of the value\n\n",
+            1u << RDT_BENCH_HIST_SUB_BITS);
+    fprintf(f, "| call | bytes | steps | calls | p50 ns | p90 ns | p99 ns | p99.9 ns | max ns |\n");
+    fprintf(f, "|---|---:|---|---:|---:|---:|---:|---:|---:|\n");
+    for (size_t i = 0; i < n; i++) {
+        const row *r = &rows[i];
+        fprintf(f, "| %s | %zu | %s | %llu | %.0f | %.0f | %.0f | %.0f | %.0f |\n", r->s->api, r->request,
+                r->s->step, (unsigned long long)r->calls, r->p50, r->p90, r->p99, r->p999, r->max);
+    }
+    fprintf(f, "\n- The reseed-every-%u rows differ from the plain rows only above p99: ", RESEED_EVERY);
+    fprintf(f, "one call in %u pays for the reseed.\n", RESEED_EVERY);
+    fprintf(f, "- Additional input costs one extra state update before the output is generated.\n");
+}
+
+/* ========================================================================== */
+/* Main                                                                       */
+/* ========================================================================== */
+
+static int selected(const char *only, const char *name) {
+    size_t len = strlen(name);
+
+    if (!only) return 1;
+    for (const char *p = only; *p;) {
+        size_t n = strcspn(p, ",");
+        if (n == len && strncmp(p, name, n) == 0) return 1;
+        p += n;
+        if (*p) p++;
+    }
+    return 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [--calls N] [--min-calls N] [--max-time S] [--cpu N]\n"
+            "          [--only a,b,...] [--out FILE.json] [--report FILE.md]\n"
+            "\n"
+            "Series:",
+            prog);
+    for (size_t i = 0; i < N_SERIES; i++) fprintf(stderr, " %s", all_series[i].name);
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char **argv) {
+    config cfg = {100000, 1000, 0.25, -1};
+    const char *only = NULL, *out_path = NULL, *report_path = NULL;
+    row *rows;
+    rdt_bench_hist *h;
+    uint8_t *buf;
+    uint64_t overhead;
+    double overhead_ns;
+    size_t n = 0;
+    int pinned;
+    FILE *f;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--calls") == 0 && i + 1 < argc) {
+            cfg.calls = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--min-calls") == 0 && i + 1 < argc) {
+            cfg.min_calls = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--max-time") == 0 && i + 1 < argc) {
+            cfg.max_time = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            cfg.cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--only") == 0 && i + 1 < argc) {
+            only = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            report_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (cfg.calls == 0 || cfg.min_calls > cfg.calls || !(cfg.max_time > 0.0)) {
+        fprintf(stderr, "Error: need calls >= 1, min-calls <= calls and max-time > 0\n");
+        return 1;
+    }
+
+    pinned = rdt_bench_pin(cfg.cpu);
+    if (pinned < 0) fprintf(stderr, "Warning: could not pin to a CPU; running unpinned\n");
+    rdt_bench_ticks_hz();
+    overhead = rdt_bench_ticks_overhead();
+    overhead_ns = ticks_to_ns(overhead);
+
+    rows = (row *)calloc(MAX_ROWS, sizeof(row));
+    h = (rdt_bench_hist *)malloc(sizeof(*h));
+    buf = (uint8_t *)calloc(1, LATENCY_MAX_BYTES);
+    if (!rows || !h || !buf) {
+        fprintf(stderr, "Error: out of memory\n");
+        free(rows);
+        free(h);
+        free(buf);
+        return 1;
+    }
+    rdt_prng_v2_init((const uint64_t[4]){1, 2, 3, 4});
+    rdt_drbg_ctx_init_u64(&drbg, 0xe607dabdfc9538b5ULL, 0x0050f7866258289cULL, 0xedc2d97a03b312adULL);
+    rdt_drbg_v2_init_u64(&drbg_v2, 0xe607dabdfc9538b5ULL, 0x0050f7866258289cULL, 0xedc2d97a03b312adULL);
+
+    for (size_t i = 0; i < N_SERIES; i++) {
+        const series *s = &all_series[i];
+        size_t count = s->sized ? N_SIZES : 1u;
+
+        if (!selected(only, s->name)) continue;
+        for (size_t k = 0; k < count; k++) {
+            size_t request = s->sized ? sizes[k] : s->request;
+            measure(s, request, &cfg, overhead, buf, h, &rows[n]);
+            fprintf(stderr, "%-32s %6zu B  p50 %9.0f ns  p99 %9.0f ns  p99.9 %9.0f ns  max %9.0f ns\n", s->name,
+                    request, rows[n].p50, rows[n].p99, rows[n].p999, rows[n].max);
+            n++;
+        }
+    }
+    free(buf);
+    free(h);
+    if (n == 0) {
+        fprintf(stderr, "Error: no series matches --only %s\n", only);
+        free(rows);
+        return 1;
+    }
+
+    f = rdt_bench_open(out_path);
+    if (!f) {
+        fprintf(stderr, "Error: cannot write %s\n", out_path);
+        free(rows);
+        return 1;
+    }
+    write_json(f, &cfg, pinned, overhead_ns, rows, n);
+    rdt_bench_close(f);
+    if (out_path && strcmp(out_path, "-") != 0) fprintf(stderr, "Wrote JSON: %s\n", out_path);
+
+    if (report_path) {
+        f = rdt_bench_open(report_path);
+        if (!f) {
+            fprintf(stderr, "Error: cannot write %s\n", report_path);
+            free(rows);
+            return 1;
+        }
+        write_report(f, &cfg, pinned, overhead_ns, rows, n);
+        rdt_bench_close(f);
+        fprintf(stderr, "Wrote report: %s\n", report_path);
+    }
+    free(rows);
+    return 0;
+}
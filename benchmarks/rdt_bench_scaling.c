@@ -0,0 +1,698 @@
+/*
+ * RDT Scaling Benchmark
+ * =====================
+ * Aggregate throughput of the generators on 1..N threads, each thread
+ * pinned to its own CPU, with per-thread efficiency (speedup / threads) and
+ * the thread count at which scaling flattens out.
+ *
+ * Workloads:
+ *   - one rdt_drbg_v2_ctx / legacy rdt_drbg_ctx per thread
+ *   - one rdt_mix4 counter-mode key and counter per thread (rdt_prng_v2
+ *     keeps process-wide state, so this is the per-thread PRNG core)
+ *   - the shared rdt_pool, driven by one caller with N pool threads
+ *
+ * Two checks run alongside, both on 8-byte rdt_drbg_v2_next_u64 calls so
+ * that every call writes its context:
+ *   - false sharing: contexts packed back to back (sharing cache lines)
+ *     against contexts padded to their own lines
+ *   - contention: one context behind a mutex shared by all threads
+ *
+ * CPUs are taken from the affinity mask in order, or interleaved across
+ * NUMA nodes with --spread numa.
+ *
+ * Author: Steven Reid
+ * ORCID: 0009-0003-9132-3410
+ * License: MIT
+ *
+ * Usage:
+ *   rdt_bench_scaling [--max-threads N] [--trials N] [--warmup N]
+ *                     [--time S] [--spread compact|numa] [--efficiency E]
+ *                     [--only a,b,...] [--out FILE.json] [--report FILE.md]
+ */
+
+#define _GNU_SOURCE
+
+#include "rdt_bench.h"
+#include "rdt_core.h"
+#include "rdt_drbg.h"
+#include "rdt_drbg_v2.h"
+#include "rdt_pool.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SCALING_MAX_THREADS 256u
+#define SCALING_MAX_TRIALS 100u
+#define SCALING_LINE 128u  /* two cache lines: keeps the adjacent-line prefetcher out too */
+#define SCALING_MAX_CPUS 4096
+#define SCALING_MAX_NODES 1024
+
+static const uint64_t mix_key[4] = {
+    0xA3B1C6E5D4879F12ULL,
+    0xC1D2E3F4A596B708ULL,
+    0x9A7B6C5D4E3F2A19ULL,
+    0x123456789ABCDEF0ULL
+};
+
+/* ========================================================================== */
+/* Workloads                                                                  */
+/* ========================================================================== */
+
+enum { PER_THREAD, SHARED, POOLED };
+
+/*
+ * init prepares one thread's state (or, for SHARED, the single state) and
+ * run produces request bytes into buf from it.
+ */
+typedef struct {
+    const char *name;
+    const char *api;
+    int mode;
+    int packed;         /* PER_THREAD states back to back instead of padded */
+    size_t state_size;
+    size_t request;
+    void (*init)(void *state, unsigned index);
+    void (*run)(void *state, uint8_t *buf, size_t request);
+} workload;
+
+typedef struct {
+    uint64_t K[4];
+    uint64_t counter;
+} mix4_state;
+
+typedef struct {
+    pthread_mutex_t lock;
+    rdt_drbg_v2_ctx ctx;
+} locked_drbg_v2;
+
+static void init_drbg_v2(void *state, unsigned index) {
+    rdt_drbg_v2_init_u64((rdt_drbg_v2_ctx *)state, 0xe607dabdfc9538b5ULL + index, 0x0050f7866258289cULL,
+                         0xedc2d97a03b312adULL);
+}
+
+static void run_drbg_v2(void *state, uint8_t *buf, size_t request) {
+    rdt_drbg_v2_generate((rdt_drbg_v2_ctx *)state, buf, request, NULL, 0, 0);
+}
+
+static void run_drbg_v2_u64(void *state, uint8_t *buf, size_t request) {
+    uint64_t v;
+    (void)request;
+    rdt_drbg_v2_next_u64((rdt_drbg_v2_ctx *)state, &v);
+    memcpy(buf, &v, sizeof(v));
+}
+
+static void init_drbg(void *state, unsigned index) {
+    rdt_drbg_ctx_init_u64((rdt_drbg_ctx *)state, 0xe607dabdfc9538b5ULL + index, 0x0050f7866258289cULL,
+                          0xedc2d97a03b312adULL);
+}
+
+static void run_drbg(void *state, uint8_t *buf, size_t request) {
+    rdt_drbg_ctx_generate((rdt_drbg_ctx *)state, buf, request, NULL, 0, 0);
+}
+
+static void init_mix4(void *state, unsigned index) {
+    mix4_state *s = (mix4_state *)state;
+    memcpy(s->K, mix_key, sizeof(s->K));
+    s->K[0] ^= index;
+    s->counter = 0;
+}
+
+static void run_mix4(void *state, uint8_t *buf, size_t request) {
+    mix4_state *s = (mix4_state *)state;
+
+    for (size_t off = 0; off + 32u <= request; off += 32u) {
+        uint64_t x[4] = {s->counter, s->counter + 1u, s->counter + 2u, s->counter + 3u};
+        uint64_t out[4];
+        rdt_mix4(x, s->K, out);
+        memcpy(buf + off, out, sizeof(out));
+        s->counter += 4u;
+    }
+}
+
+static void init_locked(void *state, unsigned index) {
+    locked_drbg_v2 *s = (locked_drbg_v2 *)state;
+    pthread_mutex_init(&s->lock, NULL);
+    init_drbg_v2(&s->ctx, index);
+}
+
+static void run_locked_u64(void *state, uint8_t *buf, size_t request) {
+    locked_drbg_v2 *s = (locked_drbg_v2 *)state;
+    pthread_mutex_lock(&s->lock);
+    run_drbg_v2_u64(&s->ctx, buf, request);
+    pthread_mutex_unlock(&s->lock);
+}
+
+static const workload workloads[] = {
+    {"drbg_v2_ctx", "rdt_drbg_v2_generate, one context per thread", PER_THREAD, 0, sizeof(rdt_drbg_v2_ctx),
+     4096, init_drbg_v2, run_drbg_v2},
+    {"drbg_ctx", "rdt_drbg_ctx_generate (legacy), one context per thread", PER_THREAD, 0, sizeof(rdt_drbg_ctx),
+     4096, init_drbg, run_drbg},
+    {"mix4_ctr", "rdt_mix4 counter mode, one key and counter per thread", PER_THREAD, 0, sizeof(mix4_state), 4096,
+     init_mix4, run_mix4},
+    {"drbg_pool", "rdt_drbg_ctx_generate (legacy), one caller, 4 MiB requests on rdt_pool", POOLED, 0,
+     sizeof(rdt_drbg_ctx), 4u * 1024u * 1024u, init_drbg, run_drbg},
+    {"drbg_v2_u64_padded", "rdt_drbg_v2_next_u64, contexts on separate cache lines", PER_THREAD, 0,
+     sizeof(rdt_drbg_v2_ctx), 8, init_drbg_v2, run_drbg_v2_u64},
+    {"drbg_v2_u64_packed", "rdt_drbg_v2_next_u64, contexts packed back to back", PER_THREAD, 1,
+     sizeof(rdt_drbg_v2_ctx), 8, init_drbg_v2, run_drbg_v2_u64},
+    {"drbg_v2_u64_mutex", "rdt_drbg_v2_next_u64, one context shared behind a mutex", SHARED, 0,
+     sizeof(locked_drbg_v2), 8, init_locked, run_locked_u64},
+};
+
+#define N_WORKLOADS (sizeof(workloads) / sizeof(workloads[0]))
+
+/* ========================================================================== */
+/* CPU placement                                                              */
+/* ========================================================================== */
+
+/*
+ * NUMA node of every CPU from /sys, numbered densely from 0 in node order;
+ * everything on node 0 when the system does not say. Returns the node count.
+ */
+static unsigned read_numa_nodes(int *node_of) {
+    int nodes = 0;
+    char path[96], list[4096];
+
+    for (int c = 0; c < SCALING_MAX_CPUS; c++) node_of[c] = 0;
+    for (int node = 0; node < SCALING_MAX_NODES; node++) {
+        FILE *f;
+        char *p;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        f = fopen(path, "r");
+        if (!f) continue;
+        if (!fgets(list, sizeof(list), f)) list[0] = '\0';
+        fclose(f);
+        for (p = list; *p && *p != '\n';) {
+            long lo = strtol(p, &p, 10), hi = lo;
+            if (*p == '-') hi = strtol(p + 1, &p, 10);
+            for (long c = lo < 0 ? 0 : lo; c <= hi && c < SCALING_MAX_CPUS; c++) node_of[c] = nodes;
+            if (*p != ',') break;
+            p++;
+        }
+        nodes++;
+    }
+    return nodes ? (unsigned)nodes : 1u;
+}
+
+/*
+ * Order the usable CPUs: affinity-mask order for compact, or round-robin
+ * over NUMA nodes for numa. Returns the number of CPUs written to cpus.
+ */
+static unsigned place_cpus(int spread_numa, const int *node_of, unsigned nodes, int *cpus, unsigned max) {
+    unsigned count = rdt_bench_cpu_count(), n = 0;
+
+    if (count > max) count = max;
+    if (!spread_numa || nodes < 2) {
+        for (unsigned i = 0; i < count; i++) cpus[n++] = rdt_bench_nth_cpu(i);
+        return n;
+    }
+    /* Take the next unused CPU of each node in turn */
+    for (unsigned round = 0; n < count; round++) {
+        unsigned added = 0;
+        for (unsigned node = 0; node < nodes && n < count; node++) {
+            unsigned seen = 0;
+            for (unsigned i = 0; i < rdt_bench_cpu_count(); i++) {
+                int c = rdt_bench_nth_cpu(i);
+                if (c < 0 || node_of[c] != (int)node) continue;
+                if (seen++ == round) {
+                    cpus[n++] = c;
+                    added++;
+                    break;
+                }
+            }
+        }
+        if (!added) break;
+    }
+    return n;
+}
+
+/* ========================================================================== */
+/* Measurement                                                                */
+/* ========================================================================== */
+
+/* Holds the workers until all are pinned and initialised, then starts them together */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cv;
+    unsigned ready;
+    int go;
+} start_gate;
+
+static void gate_wait(start_gate *g) {
+    pthread_mutex_lock(&g->lock);
+    g->ready++;
+    pthread_cond_broadcast(&g->cv);
+    while (!g->go) pthread_cond_wait(&g->cv, &g->lock);
+    pthread_mutex_unlock(&g->lock);
+}
+
+/* Wait for count workers to be ready (0: do not wait), then release them */
+static void gate_open(start_gate *g, unsigned count) {
+    pthread_mutex_lock(&g->lock);
+    while (g->ready < count) pthread_cond_wait(&g->cv, &g->lock);
+    g->go = 1;
+    pthread_cond_broadcast(&g->cv);
+    pthread_mutex_unlock(&g->lock);
+}
+
+typedef struct {
+    const workload *w;
+    void *state;
+    uint8_t *buf;
+    int cpu;
+    unsigned index;
+    start_gate *start;
+    atomic_int *stop;
+    uint64_t bytes;   /* results, written once at the end */
+    double seconds;
+} worker;
+
+static void *worker_main(void *arg) {
+    worker *wk = (worker *)arg;
+    const workload *w = wk->w;
+    uint64_t bytes = 0, t0, t1;
+
+    if (wk->cpu >= 0) rdt_bench_pin(wk->cpu);
+    if (w->mode != SHARED) w->init(wk->state, wk->index);
+    w->run(wk->state, wk->buf, w->request);
+
+    gate_wait(wk->start);
+    t0 = rdt_bench_now_ns();
+    while (!atomic_load_explicit(wk->stop, memory_order_relaxed)) {
+        w->run(wk->state, wk->buf, w->request);
+        bytes += w->request;
+    }
+    t1 = rdt_bench_now_ns();
+
+    wk->bytes = bytes;
+    wk->seconds = (double)(t1 - t0) * 1e-9;
+    return NULL;
+}
+
+typedef struct {
+    unsigned max_threads;
+    size_t trials;
+    size_t warmup;
+    double seconds;
+    int spread_numa;
+    double efficiency;
+} config;
+
+typedef struct {
+    const workload *w;
+    unsigned threads;
+    rdt_bench_summary mib_s;        /* aggregate */
+    double per_thread_min_mib_s;    /* slowest and fastest thread, last trial */
+    double per_thread_max_mib_s;
+    double speedup;
+    double efficiency;
+} point;
+
+static void sleep_seconds(double s) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)s;
+    ts.tv_nsec = (long)((s - (double)ts.tv_sec) * 1e9);
+    while (nanosleep(&ts, &ts) != 0) {
+    }
+}
+
+/* One timed run on threads workers; aggregate MiB/s, or -1 on setup failure */
+static double run_once(const workload *w, unsigned threads, const int *cpus, unsigned ncpus, double seconds,
+                       double *slowest, double *fastest) {
+    unsigned workers = w->mode == POOLED ? 1u : threads;
+    size_t stride = w->packed ? w->state_size : (w->state_size + SCALING_LINE - 1u) / SCALING_LINE * SCALING_LINE;
+    size_t buf_stride = (w->request + SCALING_LINE - 1u) / SCALING_LINE * SCALING_LINE;
+    worker *wk = (worker *)calloc(workers, sizeof(worker));
+    uint8_t *states = (uint8_t *)aligned_alloc(SCALING_LINE, (stride * workers + SCALING_LINE - 1u) / SCALING_LINE * SCALING_LINE);
+    uint8_t *bufs = (uint8_t *)aligned_alloc(SCALING_LINE, buf_stride * workers);
+    pthread_t *tids = (pthread_t *)calloc(workers, sizeof(pthread_t));
+    start_gate start = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0};
+    atomic_int stop;
+    double mib_s = -1.0;
+    unsigned started = 0;
+
+    if (!wk || !states || !bufs || !tids) goto done;
+    if (w->mode == SHARED) w->init(states, 0);
+    if (w->mode == POOLED) rdt_pool_set_threads(threads);
+    atomic_init(&stop, 0);
+
+    for (; started < workers; started++) {
+        worker *k = &wk[started];
+        k->w = w;
+        k->state = w->mode == SHARED ? states : states + stride * started;
+        k->buf = bufs + buf_stride * started;
+        k->cpu = ncpus ? cpus[started % ncpus] : -1;
+        k->index = started;
+        k->start = &start;
+        k->stop = &stop;
+        if (pthread_create(&tids[started], NULL, worker_main, k) != 0) break;
+    }
+
+    if (started == workers) {
+        gate_open(&start, workers);
+        sleep_seconds(seconds);
+        atomic_store(&stop, 1);
+        mib_s = 0.0;
+        *slowest = INFINITY;
+        *fastest = 0.0;
+        for (unsigned i = 0; i < workers; i++) {
+            double rate;
+            pthread_join(tids[i], NULL);
+            rate = (double)wk[i].bytes / (1024.0 * 1024.0) / wk[i].seconds;
+            mib_s += rate;
+            if (rate < *slowest) *slowest = rate;
+            if (rate > *fastest) *fastest = rate;
+        }
+    } else {
+        atomic_store(&stop, 1);
+        gate_open(&start, 0);
+        for (unsigned i = 0; i < started; i++) pthread_join(tids[i], NULL);
+    }
+    if (w->mode == SHARED) pthread_mutex_destroy(&((locked_drbg_v2 *)states)->lock);
+    if (w->mode == POOLED) rdt_pool_set_threads(0);
+
+done:
+    free(tids);
+    free(bufs);
+    free(states);
+    free(wk);
+    return mib_s;
+}
+
+static int measure(const workload *w, unsigned threads, const config *cfg, const int *cpus, unsigned ncpus,
+                   point *out) {
+    double mib_s[SCALING_MAX_TRIALS];
+    double slowest = 0.0, fastest = 0.0;
+
+    memset(out, 0, sizeof(*out));
+    out->w = w;
+    out->threads = threads;
+    for (size_t t = 0; t < cfg->warmup + cfg->trials; t++) {
+        double v = run_once(w, threads, cpus, ncpus, cfg->seconds, &slowest, &fastest);
+        if (v < 0.0) return -1;
+        if (t >= cfg->warmup) mib_s[t - cfg->warmup] = v;
+    }
+    rdt_bench_summarize(mib_s, cfg->trials, &out->mib_s);
+    out->per_thread_min_mib_s = slowest;
+    out->per_thread_max_mib_s = fastest;
+    return 0;
+}
+
+/*
+ * Speedup and efficiency against the one-thread point of the same workload,
+ * and the first thread count whose efficiency falls below the threshold (0
+ * when scaling holds to the end).
+ */
+static unsigned analyse(point *pts, unsigned n, double threshold, unsigned *best) {
+    unsigned flat = 0;
+
+    *best = n ? pts[0].threads : 0;
+    for (unsigned i = 0; i < n; i++) {
+        pts[i].speedup = pts[i].mib_s.mean / pts[0].mib_s.mean;
+        pts[i].efficiency = pts[i].speedup / (double)pts[i].threads;
+        if (!flat && pts[i].threads > 1 && pts[i].efficiency < threshold) flat = pts[i].threads;
+        if (pts[i].mib_s.mean > pts[*best - 1u].mib_s.mean) *best = pts[i].threads;
+    }
+    return flat;
+}
+
+/* ========================================================================== */
+/* Output                                                                     */
+/* ========================================================================== */
+
+typedef struct {
+    const workload *w;
+    point *pts;
+    unsigned flat;
+    unsigned best;
+} curve;
+
+static const curve *find(const curve *curves, size_t n, const char *name) {
+    for (size_t i = 0; i < n; i++) {
+        if (strcmp(curves[i].w->name, name) == 0) return &curves[i];
+    }
+    return NULL;
+}
+
+/* Aggregate of a against b at the largest thread count; NaN when either is missing or n < 2 */
+static double ratio_at_max(const curve *a, const curve *b, unsigned n) {
+    if (!a || !b || n < 2) return NAN;
+    return a->pts[n - 1u].mib_s.mean / b->pts[n - 1u].mib_s.mean;
+}
+
+static void write_json(FILE *f, const config *cfg, const int *cpus, unsigned ncpus, unsigned nodes,
+                       const curve *curves, size_t n) {
+    const curve *padded = find(curves, n, "drbg_v2_u64_padded");
+    rdt_bench_json j;
+
+    rdt_bench_json_begin(&j, f);
+    rdt_bench_json_environment(&j, ncpus ? cpus[0] : -1);
+    rdt_bench_json_object(&j, "config");
+    rdt_bench_json_uint(&j, "max_threads", cfg->max_threads);
+    rdt_bench_json_uint(&j, "trials", cfg->trials);
+    rdt_bench_json_uint(&j, "warmup_trials", cfg->warmup);
+    rdt_bench_json_number(&j, "trial_s", cfg->seconds);
+    rdt_bench_json_string(&j, "spread", cfg->spread_numa ? "numa" : "compact");
+    rdt_bench_json_uint(&j, "numa_nodes", nodes);
+    rdt_bench_json_uint(&j, "usable_cpus", ncpus);
+    rdt_bench_json_number(&j, "flat_efficiency_threshold", cfg->efficiency);
+    rdt_bench_json_close_object(&j);
+
+    rdt_bench_json_array(&j, "results");
+    for (size_t i = 0; i < n; i++) {
+        for (unsigned t = 0; t < cfg->max_threads; t++) {
+            const point *p = &curves[i].pts[t];
+            rdt_bench_json_object(&j, NULL);
+            rdt_bench_json_string(&j, "name", p->w->name);
+            rdt_bench_json_string(&j, "api", p->w->api);
+            rdt_bench_json_uint(&j, "request_bytes", p->w->request);
+            rdt_bench_json_uint(&j, "threads", p->threads);
+            rdt_bench_json_number(&j, "cpu", ncpus ? (double)cpus[t % ncpus] : NAN);
+            rdt_bench_json_summary(&j, "aggregate_mib_s", &p->mib_s);
+            rdt_bench_json_number(&j, "per_thread_mib_s", p->mib_s.mean / (double)p->threads);
+            rdt_bench_json_number(&j, "slowest_thread_mib_s", p->w->mode == POOLED ? NAN : p->per_thread_min_mib_s);
+            rdt_bench_json_number(&j, "fastest_thread_mib_s", p->w->mode == POOLED ? NAN : p->per_thread_max_mib_s);
+            rdt_bench_json_number(&j, "speedup", p->speedup);
+            rdt_bench_json_number(&j, "efficiency", p->efficiency);
+            rdt_bench_json_close_object(&j);
+        }
+    }
+    rdt_bench_json_close_array(&j);
+
+    rdt_bench_json_object(&j, "findings");
+    for (size_t i = 0; i < n; i++) {
+        char key[96];
+        snprintf(key, sizeof(key), "%s_flattens_at_threads", curves[i].w->name);
+        rdt_bench_json_number(&j, key, curves[i].flat ? (double)curves[i].flat : NAN);
+        snprintf(key, sizeof(key), "%s_best_threads", curves[i].w->name);
+        rdt_bench_json_uint(&j, key, curves[i].best);
+    }
+    rdt_bench_json_number(&j, "false_sharing_packed_vs_padded_at_max",
+                          ratio_at_max(find(curves, n, "drbg_v2_u64_packed"), padded, cfg->max_threads));
+    rdt_bench_json_number(&j, "contention_mutex_vs_padded_at_max",
+                          ratio_at_max(find(curves, n, "drbg_v2_u64_mutex"), padded, cfg->max_threads));
+    rdt_bench_json_close_object(&j);
+    rdt_bench_json_end(&j);
+}
+
+static void write_report(FILE *f, const config *cfg, unsigned ncpus, unsigned nodes,
+                         const curve *curves, size_t n) {
+    const curve *padded = find(curves, n, "drbg_v2_u64_padded");
+    double fs = ratio_at_max(find(curves, n, "drbg_v2_u64_packed"), padded, cfg->max_threads);
+    double ct = ratio_at_max(find(curves, n, "drbg_v2_u64_mutex"), padded, cfg->max_threads);
+    char model[256];
+
+    rdt_bench_cpu_model(model, sizeof(model));
+    fprintf(f, "# RDT256 Multi-Thread Scaling Benchmark\n\n");
+    fprintf(f, "- CPU: `%s`, `%u` usable CPU(s) on `%u` NUMA node(s), `%s` placement\n", model, ncpus, nodes,
+            cfg->spread_numa ? "numa" : "compact");
+    fprintf(f, "- `1..%u` threads, `%zu` trials of `%.3g s` after `%zu` warmup\n", cfg->max_threads, cfg->trials,
+            cfg->seconds, cfg->warmup);
+    if (ncpus < 2) {
+        fprintf(f, "- only one usable CPU: this run records the single-thread baseline, not a curve\n");
+    }
+    if (cfg->max_threads > ncpus) {
+        fprintf(f, "- more threads than CPUs: counts above `%u` share CPUs and are not a scaling result\n", ncpus);
+    }
+    fprintf(f, "- efficiency = speedup / threads; scaling counts as flat below `%.2f`\n\n", cfg->efficiency);
+
+    fprintf(f, "| workload | threads | aggregate MiB/s | 95%% CI | per thread MiB/s | speedup | efficiency |\n");
+    fprintf(f, "|---|---:|---:|---:|---:|---:|---:|\n");
+    for (size_t i = 0; i < n; i++) {
+        for (unsigned t = 0; t < cfg->max_threads; t++) {
+            const point *p = &curves[i].pts[t];
+            fprintf(f, "| %s | %u | %.2f | %.2f-%.2f | %.2f | %.2f | %.2f |\n", p->w->name, p->threads,
+                    p->mib_s.mean, p->mib_s.ci95_low, p->mib_s.ci95_high, p->mib_s.mean / (double)p->threads,
+                    p->speedup, p->efficiency);
+        }
+    }
+
+    fprintf(f, "\n");
+    for (size_t i = 0; i < n; i++) {
+        if (curves[i].flat) {
+            fprintf(f, "- `%s` flattens at %u threads (best aggregate at %u)\n", curves[i].w->name,
+                    curves[i].flat, curves[i].best);
+        } else {
+            fprintf(f, "- `%s` holds its efficiency up to %u thread%s (best aggregate at %u)\n", curves[i].w->name,
+                    cfg->max_threads, cfg->max_threads == 1 ? "" : "s", curves[i].best);
+        }
+    }
+    if (!isnan(fs)) {
+        fprintf(f, "- false sharing: packed contexts run at %.2fx the padded ones at %u threads\n", fs,
+                cfg->max_threads);
+    }
+    if (!isnan(ct)) {
+        fprintf(f, "- contention: one mutex-shared context runs at %.2fx per-thread contexts at %u threads\n", ct,
+                cfg->max_threads);
+    }
+}
+
+/* ========================================================================== */
+/* Main                                                                       */
+/* ========================================================================== */
+
+static int selected(const char *only, const char *name) {
+    size_t len = strlen(name);
+
+    if (!only) return 1;
+    for (const char *p = only; *p;) {
+        size_t n = strcspn(p, ",");
+        if (n == len && strncmp(p, name, n) == 0) return 1;
+        p += n;
+        if (*p) p++;
+    }
+    return 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [--max-threads N] [--trials N] [--warmup N] [--time S]\n"
+            "          [--spread compact|numa] [--efficiency E]\n"
+            "          [--only a,b,...] [--out FILE.json] [--report FILE.md]\n"
+            "\n"
+            "Workloads:",
+            prog);
+    for (size_t i = 0; i < N_WORKLOADS; i++) fprintf(stderr, " %s", workloads[i].name);
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char **argv) {
+    config cfg = {0, 3, 1, 0.2, 0, 0.8};
+    const char *only = NULL, *out_path = NULL, *report_path = NULL;
+    static int node_of[SCALING_MAX_CPUS];
+    int cpus[SCALING_MAX_THREADS];
+    curve curves[N_WORKLOADS];
+    unsigned ncpus, nodes;
+    size_t n = 0;
+    int status = 0;
+    FILE *f;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--max-threads") == 0 && i + 1 < argc) {
+            cfg.max_threads = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+            cfg.trials = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            cfg.warmup = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            cfg.seconds = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--spread") == 0 && i + 1 < argc) {
+            const char *s = argv[++i];
+            if (strcmp(s, "numa") == 0) cfg.spread_numa = 1;
+            else if (strcmp(s, "compact") == 0) cfg.spread_numa = 0;
+            else {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--efficiency") == 0 && i + 1 < argc) {
+            cfg.efficiency = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--only") == 0 && i + 1 < argc) {
+            only = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            report_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    nodes = read_numa_nodes(node_of);
+    ncpus = place_cpus(cfg.spread_numa, node_of, nodes, cpus, SCALING_MAX_THREADS);
+    if (cfg.max_threads == 0) cfg.max_threads = ncpus ? ncpus : 1u;
+    if (cfg.max_threads > SCALING_MAX_THREADS || cfg.trials < 2 || cfg.trials > SCALING_MAX_TRIALS ||
+        !(cfg.seconds > 0.0)) {
+        fprintf(stderr, "Error: need 1..%u threads, 2..%u trials and time > 0\n", SCALING_MAX_THREADS,
+                SCALING_MAX_TRIALS);
+        return 1;
+    }
+    if (cfg.max_threads > ncpus) {
+        fprintf(stderr, "Warning: %u threads on %u CPU(s); counts above %u share CPUs\n", cfg.max_threads, ncpus,
+                ncpus);
+    }
+
+    for (size_t i = 0; i < N_WORKLOADS; i++) {
+        const workload *w = &workloads[i];
+        curve *c;
+
+        if (!selected(only, w->name)) continue;
+        c = &curves[n];
+        c->w = w;
+        c->pts = (point *)calloc(cfg.max_threads, sizeof(point));
+        if (!c->pts) {
+            fprintf(stderr, "Error: out of memory\n");
+            status = 1;
+            goto out;
+        }
+        n++;
+        for (unsigned t = 1; t <= cfg.max_threads; t++) {
+            if (measure(w, t, &cfg, cpus, ncpus, &c->pts[t - 1u]) != 0) {
+                fprintf(stderr, "Error: could not start %u threads for %s\n", t, w->name);
+                status = 1;
+                goto out;
+            }
+            fprintf(stderr, "%-20s %3u thread(s)  %10.2f MiB/s  per thread %9.2f\n", w->name, t,
+                    c->pts[t - 1u].mib_s.mean, c->pts[t - 1u].mib_s.mean / (double)t);
+        }
+        c->flat = analyse(c->pts, cfg.max_threads, cfg.efficiency, &c->best);
+    }
+    if (n == 0) {
+        fprintf(stderr, "Error: no workload matches --only %s\n", only);
+        return 1;
+    }
+
+    f = rdt_bench_open(out_path);
+    if (!f) {
+        fprintf(stderr, "Error: cannot write %s\n", out_path);
+        status = 1;
+        goto out;
+    }
+    write_json(f, &cfg, cpus, ncpus, nodes, curves, n);
+    rdt_bench_close(f);
+    if (out_path && strcmp(out_path, "-") != 0) fprintf(stderr, "Wrote JSON: %s\n", out_path);
+
+    if (report_path) {
+        f = rdt_bench_open(report_path);
+        if (!f) {
+            fprintf(stderr, "Error: cannot write %s\n", report_path);
+            status = 1;
+            goto out;
+        }
+        write_report(f, &cfg, ncpus, nodes, curves, n);
+        rdt_bench_close(f);
+        fprintf(stderr, "Wrote report: %s\n", report_path);
+    }
+
+out:
+    for (size_t i = 0; i < n; i++) free(curves[i].pts);
+    return status;
+}
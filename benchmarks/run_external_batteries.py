@@ -73,8 +73,9 @@ def try_compile_testu01(binary: Path, testu01_prefix: Path | None) -> bool:
         library_prefix = f"-L{shlex.quote(str(testu01_prefix / 'lib'))} "
         rpath_prefix = f"-Wl,-rpath,{shlex.quote(str(testu01_prefix / 'lib'))} "
     compile_cmd = (
-        f"cc -O3 -std=c11 -I./src {include_prefix}"
-        "benchmarks/testu01_rdt_drbg_v2.c src/rdt_core.c src/rdt_sha256.c src/rdt_drbg_v2.c "
+        f"cc -O3 -std=c11 -pthread -I./src {include_prefix}"
+        "benchmarks/testu01_rdt_drbg_v2.c src/rdt_core.c src/rdt_pool.c src/rdt_sha256.c "
+        "src/rdt_health.c src/rdt_drbg_v2.c "
         f"-o {shlex.quote(str(binary))} {library_prefix}{rpath_prefix}"
         "-ltestu01 -lprobdist -lmylib -lm"
     )
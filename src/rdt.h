@@ -6,6 +6,7 @@
 
 /* Core */
 uint64_t rdt_mix(uint64_t x, const uint64_t K[4]);
+void rdt_mix4(const uint64_t x[4], const uint64_t K[4], uint64_t out[4]);
 
 /* PRNG */
 void rdt_prng_init(uint64_t seed);
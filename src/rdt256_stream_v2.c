@@ -20,6 +20,7 @@
  */
 
 #include "rdt256_stream_v2.h"
+#include "rdt_stats.h"
 #include <stdint.h>
 #include <string.h>
 
@@ -88,6 +89,7 @@ static uint64_t rdt_mix(uint64_t x) {
     uint32_t d = rdt_depth_fast(x);
     uint32_t g = scalar_field(x);
     uint64_t m = (x + (uint64_t)g) * 0x9E3779B97F4A7C15ULL;
+    RDT_STATS_ADD(RDT_STAT_MIX_DEPTH + d, 1);
     uint64_t p = m ^ ((uint64_t)d * 0xBF58476D1CE4E5B9ULL);
 
     /* Epsilon-channel mixing */
@@ -196,6 +198,7 @@ uint64_t rdt_prng_v2_next(void) {
     S[1] ^= rotl64(S[2], 35);
     S[2] ^= rotl64(S[3], 49);
     S[3] ^= rotl64(S[0], 11);
+    RDT_STATS_ADD(RDT_STAT_PRNG_V2_BYTES, 8);
 
     return S[0];
 }
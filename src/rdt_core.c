@@ -1,4 +1,5 @@
 #include "rdt_core.h"
+#include "rdt_stats.h"
 #include <stdint.h>
 
 static inline uint32_t bit_length(uint64_t x) {
@@ -32,6 +33,18 @@ static inline uint32_t isqrt32(uint32_t x) {
     return r;
 }
 
+/* Branch-free isqrt32: the leading steps skipped above leave r == 0 anyway */
+static inline uint32_t isqrt32_fixed(uint32_t x) {
+    uint32_t r = 0, bit = 1u << 30;
+    for (int s = 0; s < 16; s++) {
+        uint32_t take = (uint32_t)0 - (uint32_t)(x >= r + bit);
+        x -= (r + bit) & take;
+        r = (r + ((bit << 1) & take)) >> 1;
+        bit >>= 2;
+    }
+    return r;
+}
+
 static inline uint32_t scalar_field(uint64_t x) {
     uint32_t a = (uint32_t)(x & 0xFFFFu);
     uint32_t b = (uint32_t)((x >> 16) & 0xFFFFu);
@@ -47,6 +60,7 @@ uint64_t rdt_mix(uint64_t x, const uint64_t K[4])
     uint32_t d = rdt_depth_fast(x);
     uint32_t g = scalar_field(x);
     uint64_t m = (x + g) * 0x9E3779B97F4A7C15ULL;
+    RDT_STATS_ADD(RDT_STAT_MIX_DEPTH + d, 1);
     uint64_t p = m ^ ((uint64_t)d * 0xBF58476D1CE4E5B9ULL);
 
     /* epsilon mixing */
@@ -77,3 +91,51 @@ uint64_t rdt_mix(uint64_t x, const uint64_t K[4])
 
     return rotl64(z, (d ^ rp));
 }
+
+/*
+ * Four independent rdt_mix evaluations, interleaved lane by lane.
+ * The epsilon loop always runs the full 7 rounds and masks off the rounds a
+ * lane would have skipped, and isqrt32 runs its fixed 16 steps, so there are
+ * no data-dependent branches and the lanes can be scheduled side by side.
+ * out[i] == rdt_mix(x[i], K) for every lane.
+ */
+void rdt_mix4(const uint64_t x[4], const uint64_t K[4], uint64_t out[4])
+{
+    static const uint32_t ROT[3] = {13,23,43};
+    static const uint64_t MUL[3] = {19,29,47};
+    uint32_t d[4];
+    uint64_t p[4], eps[4], z[4];
+    int l;
+
+    for (l = 0; l < 4; l++) {
+        uint32_t a = (uint32_t)(x[l] & 0xFFFFu);
+        uint32_t b = (uint32_t)((x[l] >> 16) & 0xFFFFu);
+        uint32_t g = rdt_depth_fast(isqrt32_fixed(a*a + b*b));
+        d[l] = rdt_depth_fast(x[l]);
+        RDT_STATS_ADD(RDT_STAT_MIX_DEPTH + d[l], 1);
+        p[l] = ((x[l] + g) * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)d[l] * 0xBF58476D1CE4E5B9ULL);
+        eps[l] = 0;
+    }
+
+    for (uint32_t i = 0; i <= 6; i++) {
+        for (l = 0; l < 4; l++) {
+            uint64_t c = p[l] * (P[i] * 0xC2B2AE3D27D4EB4FULL);
+            c ^= (p[l] >> (i + 1)) * P[i];
+            c ^= K[i & 3];
+            c = rotl64(c, 13 + 7*i);
+            eps[l] ^= c & ((uint64_t)0 - (uint64_t)(i <= d[l]));
+        }
+    }
+
+    for (l = 0; l < 4; l++) {
+        uint32_t rp = ROT[d[l] % 3];
+        uint64_t mp = MUL[d[l] % 3] * 0xD6E8FEB86659FD93ULL;
+
+        z[l] = p[l] ^ eps[l];
+        z[l] ^= (z[l] << rp);
+        z[l] ^= (z[l] >> (rp >> 1));
+        z[l] *= mp;
+        z[l] ^= K[(d[l] ^ rp) & 3];
+        out[l] = rotl64(z[l], (d[l] ^ rp));
+    }
+}
@@ -6,4 +6,7 @@
 /* Core nonlinear RDT mixing primitive */
 uint64_t rdt_mix(uint64_t x, const uint64_t K[4]);
 
+/* Four independent rdt_mix evaluations: out[i] = rdt_mix(x[i], K) */
+void rdt_mix4(const uint64_t x[4], const uint64_t K[4], uint64_t out[4]);
+
 #endif /* RDT_CORE_H */
@@ -1,13 +1,13 @@
 #include "rdt_drbg.h"
 #include "rdt_core.h"
+#include "rdt_pool.h"
+#include "rdt_stats.h"
 #include <string.h>
 
 /* -----------------------
-   Internal DRBG state
+   Default context behind the context-free API
    ----------------------- */
-static uint64_t Kd[4];     /* 256-bit key */
-static uint64_t Vd[2];     /* 128-bit counter */
-static uint64_t reseed_counter = 0;
+static rdt_drbg_ctx default_ctx;
 
 /* -----------------------
    Low-level helpers
@@ -25,10 +25,16 @@ static uint64_t splitmix64_next(uint64_t *x) {
     return z ^ (z >> 31);
 }
 
-/* 128-bit increment of V */
-static inline void inc_V(void) {
-    Vd[0] += 1;
-    if (Vd[0] == 0) Vd[1] += 1;
+/* 128-bit V += n */
+static inline void add_V(uint64_t V[2], uint64_t n) {
+    V[0] += n;
+    if (V[0] < n) V[1] += 1;
+}
+
+static inline void store_u64_le(uint8_t *out, uint64_t x) {
+    for (unsigned i = 0; i < 8u; i++) {
+        out[i] = (uint8_t)(x >> (8u * i));
+    }
 }
 
 /*
@@ -70,6 +76,12 @@ static inline uint32_t rdt_shell64(uint64_t x) {
     return (bl ^ (pc << 1) ^ (uint32_t)mid) & 63u;
 }
 
+/* Permutation family indexed by shell & 7 */
+static const uint8_t drbg_perm[8][4] = {
+    {0, 1, 2, 3}, {1, 0, 3, 2}, {2, 3, 0, 1}, {3, 2, 1, 0},
+    {0, 2, 1, 3}, {1, 3, 2, 0}, {2, 0, 3, 1}, {3, 1, 0, 2}
+};
+
 /*
 Block function built from your rdt_mix, but with a shell-controlled schedule.
 Returns 64-bit block.
@@ -83,17 +95,7 @@ static uint64_t rdt_drbg_block(uint64_t V0, uint64_t V1, const uint64_t K[4]) {
     uint32_t rounds = 3u + (shell & 3u);
 
     /* small permutation family based on shell */
-    uint8_t perm[4];
-    switch (shell) {
-        case 0: perm[0]=0; perm[1]=1; perm[2]=2; perm[3]=3; break;
-        case 1: perm[0]=1; perm[1]=0; perm[2]=3; perm[3]=2; break;
-        case 2: perm[0]=2; perm[1]=3; perm[2]=0; perm[3]=1; break;
-        case 3: perm[0]=3; perm[1]=2; perm[2]=1; perm[3]=0; break;
-        case 4: perm[0]=0; perm[1]=2; perm[2]=1; perm[3]=3; break;
-        case 5: perm[0]=1; perm[1]=3; perm[2]=2; perm[3]=0; break;
-        case 6: perm[0]=2; perm[1]=0; perm[2]=3; perm[3]=1; break;
-        default:perm[0]=3; perm[1]=1; perm[2]=0; perm[3]=2; break;
-    }
+    const uint8_t *perm = drbg_perm[shell];
 
     /* local lanes */
     uint64_t x[4];
@@ -125,36 +127,137 @@ static uint64_t rdt_drbg_block(uint64_t V0, uint64_t V1, const uint64_t K[4]) {
     return rdt_mix(x[0] ^ x[1] ^ x[2] ^ x[3] ^ ((uint64_t)d << 56), K);
 }
 
-/* absorb bytes into 4 words using rdt_mix keyed by current K */
+/*
+RDT_DRBG_LANES-way block function: out[l] = rdt_drbg_block(V + 1 + l), i.e.
+exactly what four successive "++V; Block(K, V)" steps would produce. Shell,
+permutation and round count are chosen per lane; each round's two rdt_mix
+steps are then issued for all lanes together through rdt_mix4. Lanes whose
+round count is already exhausted still go through the batched mix but
+discard the result.
+*/
+static void rdt_drbg_block4(const uint64_t V[2], const uint64_t K[4],
+                            uint64_t out[RDT_DRBG_LANES]) {
+    uint64_t x[RDT_DRBG_LANES][4];
+    uint64_t in[RDT_DRBG_LANES], mixed[RDT_DRBG_LANES];
+    uint32_t d[RDT_DRBG_LANES], shell[RDT_DRBG_LANES], rounds[RDT_DRBG_LANES];
+    const uint8_t *perm[RDT_DRBG_LANES];
+    uint32_t max_rounds = 0;
+    unsigned l;
+
+    for (l = 0; l < RDT_DRBG_LANES; l++) {
+        uint64_t V0 = V[0] + (uint64_t)(l + 1u);
+        uint64_t V1 = V[1] + (uint64_t)(V0 < V[0]);
+        d[l] = rdt_shell64((V0 ^ K[0]) ^ rotl64(V1, 17));
+        shell[l] = d[l] & 7u;
+        rounds[l] = 3u + (shell[l] & 3u);
+        perm[l] = drbg_perm[shell[l]];
+        if (rounds[l] > max_rounds) max_rounds = rounds[l];
+
+        x[l][0] = V0 + K[0] + 0xD1342543DE82EF95ULL;
+        x[l][1] = V1 + K[1] + 0xC42B7E5E3A6C1B47ULL;
+        x[l][2] = (V0 ^ V1) + K[2] + 0x9E3779B97F4A7C15ULL;
+        x[l][3] = (rotl64(V0, 32) ^ V1) + K[3] + 0xBF58476D1CE4E5B9ULL;
+    }
+
+    for (uint32_t r = 0; r < max_rounds; r++) {
+        for (l = 0; l < RDT_DRBG_LANES; l++) {
+            uint8_t a = perm[l][(r + 0u) & 3u];
+            uint8_t b = perm[l][(r + 1u) & 3u];
+            uint8_t c = perm[l][(r + 2u) & 3u];
+            uint8_t e = perm[l][(r + 3u) & 3u];
+            if (r < rounds[l]) {
+                x[l][a] += x[l][b] + (uint64_t)(shell[l] + 1u) * 0x9E3779B97F4A7C15ULL;
+                x[l][e] ^= rotl64(x[l][a], 13u + 7u * (r & 3u));
+            }
+            in[l] = x[l][c] ^ x[l][e] ^ ((uint64_t)r << 32) ^ (uint64_t)shell[l];
+        }
+        rdt_mix4(in, K, mixed);
+
+        for (l = 0; l < RDT_DRBG_LANES; l++) {
+            uint8_t b = perm[l][(r + 1u) & 3u];
+            uint8_t c = perm[l][(r + 2u) & 3u];
+            if (r < rounds[l]) x[l][c] = mixed[l];
+            in[l] = x[l][b] + x[l][c] + (uint64_t)(r + shell[l]);
+        }
+        rdt_mix4(in, K, mixed);
+
+        for (l = 0; l < RDT_DRBG_LANES; l++) {
+            uint8_t a = perm[l][(r + 0u) & 3u];
+            uint8_t b = perm[l][(r + 1u) & 3u];
+            uint8_t c = perm[l][(r + 2u) & 3u];
+            uint8_t e = perm[l][(r + 3u) & 3u];
+            if (r >= rounds[l]) continue;
+            x[l][b] = mixed[l];
+            x[l][(a + 1u) & 3u] ^= rotl64(x[l][(c + 2u) & 3u], 23u + (shell[l] & 7u));
+            x[l][(b + 2u) & 3u] += x[l][(e + 3u) & 3u] ^ (uint64_t)d[l];
+        }
+    }
+
+    for (l = 0; l < RDT_DRBG_LANES; l++) {
+        in[l] = x[l][0] ^ x[l][1] ^ x[l][2] ^ x[l][3] ^ ((uint64_t)d[l] << 56);
+    }
+    rdt_mix4(in, K, out);
+}
+
+static inline uint64_t load_u64_le(const uint8_t *in) {
+    uint64_t x;
+    memcpy(&x, in, sizeof(x));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    return x;
+}
+
+/*
+absorb bytes into 4 words using rdt_mix keyed by current K.
+
+Word wi (little-endian, 8 bytes) is mixed with 0xA5A5.. + wi and folded into
+W[wi & 3]; a trailing partial word is zero-padded and tagged 0xC2B2.. + wi.
+Four consecutive words land in four distinct W entries, so each group of 32
+input bytes costs one rdt_mix4. The leftover full words and the partial word
+(at most four in total) share a final rdt_mix4, and each diffusion round
+mixes all four W entries at once.
+*/
 static void absorb_bytes(uint64_t W[4], const uint8_t *in, size_t in_len, const uint64_t K[4]) {
-    uint64_t lane = 0;
-    unsigned shift = 0;
+    uint64_t x[4], m[4];
+    size_t full = in_len / 8u;
     size_t wi = 0;
+    unsigned n = 0;
 
-    for (size_t i = 0; i < in_len; i++) {
-        lane |= ((uint64_t)in[i]) << shift;
-        shift += 8;
-        if (shift == 64) {
-            W[wi & 3u] ^= rdt_mix(lane ^ (0xA5A5A5A5A5A5A5A5ULL + (uint64_t)wi), K);
-            wi++;
-            lane = 0;
-            shift = 0;
+    for (; wi + 4u <= full; wi += 4u) {
+        for (unsigned l = 0; l < 4u; l++) {
+            x[l] = load_u64_le(in + 8u * (wi + l)) ^ (0xA5A5A5A5A5A5A5A5ULL + (uint64_t)(wi + l));
         }
+        rdt_mix4(x, K, m);
+        for (unsigned l = 0; l < 4u; l++) W[l] ^= m[l];
+    }
+
+    for (; wi + n < full; n++) {
+        x[n] = load_u64_le(in + 8u * (wi + n)) ^ (0xA5A5A5A5A5A5A5A5ULL + (uint64_t)(wi + n));
+    }
+    if (in_len % 8u) {
+        uint8_t pad[8] = {0};
+        memcpy(pad, in + 8u * full, in_len % 8u);
+        x[n] = load_u64_le(pad) ^ (0xC2B2AE3D27D4EB4FULL + (uint64_t)(wi + n));
+        n++;
     }
-    if (shift) {
-        W[wi & 3u] ^= rdt_mix(lane ^ (0xC2B2AE3D27D4EB4FULL + (uint64_t)wi), K);
+    if (n) {
+        for (unsigned l = n; l < 4u; l++) x[l] = 0;
+        rdt_mix4(x, K, m);
+        for (unsigned l = 0; l < n; l++) W[(wi + l) & 3u] ^= m[l];
     }
 
     /* diffuse */
     for (int r = 0; r < 2; r++) {
         for (int j = 0; j < 4; j++) {
-            W[j] = rdt_mix(W[j] + 0x9E3779B97F4A7C15ULL * (uint64_t)(j + 1 + 4*r), K);
+            x[j] = W[j] + 0x9E3779B97F4A7C15ULL * (uint64_t)(j + 1 + 4*r);
         }
+        rdt_mix4(x, K, W);
     }
 }
 
 /* make provided_data PD[4] from (entropy||additional) */
-static void make_PD(uint64_t PD[4],
+static void make_PD(uint64_t PD[4], const uint64_t K[4],
                     const uint8_t *entropy, size_t entropy_len,
                     const uint8_t *additional, size_t additional_len) {
     PD[0] = 0x243F6A8885A308D3ULL;
@@ -162,11 +265,11 @@ static void make_PD(uint64_t PD[4],
     PD[2] = 0xA4093822299F31D0ULL;
     PD[3] = 0x082EFA98EC4E6C89ULL;
 
-    if (entropy && entropy_len) absorb_bytes(PD, entropy, entropy_len, Kd);
-    if (additional && additional_len) absorb_bytes(PD, additional, additional_len, Kd);
+    if (entropy && entropy_len) absorb_bytes(PD, entropy, entropy_len, K);
+    if (additional && additional_len) absorb_bytes(PD, additional, additional_len, K);
 
     for (int i = 0; i < 4; i++) {
-        PD[i] = rdt_mix(PD[i] ^ (uint64_t)(0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1)), Kd);
+        PD[i] = rdt_mix(PD[i] ^ (uint64_t)(0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1)), K);
     }
 }
 
@@ -177,47 +280,96 @@ temp ^= PD (if present)
 K <- mix(temp, oldK)
 V <- mix(temp, newK)
 */
-static void drbg_update(const uint64_t PD[4], int has_pd) {
+static void drbg_update(rdt_drbg_ctx *ctx, const uint64_t PD[4], int has_pd) {
     uint64_t temp[4];
 
-    for (int i = 0; i < 4; i++) {
-        inc_V();
-        temp[i] = rdt_drbg_block(Vd[0], Vd[1], Kd);
-    }
+    RDT_STATS_ADD(RDT_STAT_DRBG_UPDATES, 1);
+    rdt_drbg_block4(ctx->V, ctx->K, temp);
+    add_V(ctx->V, RDT_DRBG_LANES);
     if (has_pd) {
         for (int i = 0; i < 4; i++) temp[i] ^= PD[i];
     }
 
     /* update key */
-    uint64_t oldK[4] = {Kd[0], Kd[1], Kd[2], Kd[3]};
+    uint64_t oldK[4] = {ctx->K[0], ctx->K[1], ctx->K[2], ctx->K[3]};
     for (int i = 0; i < 4; i++) {
-        Kd[i] = rdt_mix(temp[i] + 0x9E3779B97F4A7C15ULL * (uint64_t)i, oldK);
+        ctx->K[i] = rdt_mix(temp[i] + 0x9E3779B97F4A7C15ULL * (uint64_t)i, oldK);
     }
 
     /* update counter state from temp under new key (avoid pure counter V) */
-    Vd[0] ^= rdt_mix(temp[0] ^ temp[2], Kd);
-    Vd[1] ^= rdt_mix(temp[1] ^ temp[3], Kd);
+    ctx->V[0] ^= rdt_mix(temp[0] ^ temp[2], ctx->K);
+    ctx->V[1] ^= rdt_mix(temp[1] ^ temp[3], ctx->K);
+
+    ctx->reseed_counter++;
+}
+
+/* Fill out[0..len) (len a multiple of 8 * RDT_DRBG_LANES) with Block(K, V + 1 ...) */
+static void drbg_fill(const uint64_t V[2], const uint64_t K[4], uint8_t *out, size_t len) {
+    uint64_t ctr[2] = {V[0], V[1]};
+    uint64_t blocks[RDT_DRBG_LANES];
+
+    for (size_t pos = 0; pos < len; pos += 8u * RDT_DRBG_LANES) {
+        rdt_drbg_block4(ctr, K, blocks);
+        add_V(ctr, RDT_DRBG_LANES);
+        for (unsigned l = 0; l < RDT_DRBG_LANES; l++) {
+            store_u64_le(out + pos + 8u * l, blocks[l]);
+        }
+    }
+    memset(blocks, 0, sizeof(blocks));
+}
+
+/*
+Large requests: the counter range is cut into RDT_DRBG_PARALLEL_SLICE_BYTES
+slices and each pool task fills its own slice of out, starting from V advanced
+by the blocks that precede the slice. The bytes are the same as drbg_fill over
+the whole range. Neither V nor K is modified here.
+*/
+#define RDT_DRBG_PARALLEL_SLICE_BYTES (256u * 1024u)
+
+typedef struct {
+    const rdt_drbg_ctx *ctx;
+    uint8_t *out;
+    size_t len;
+} drbg_parallel_job;
+
+static void drbg_fill_slice(void *arg, size_t index) {
+    const drbg_parallel_job *job = (const drbg_parallel_job *)arg;
+    size_t offset = index * RDT_DRBG_PARALLEL_SLICE_BYTES;
+    size_t len = job->len - offset;
+    uint64_t V[2] = {job->ctx->V[0], job->ctx->V[1]};
+
+    if (len > RDT_DRBG_PARALLEL_SLICE_BYTES) len = RDT_DRBG_PARALLEL_SLICE_BYTES;
+    add_V(V, (uint64_t)(offset / 8u));
+    drbg_fill(V, job->ctx->K, job->out + offset, len);
+}
 
-    reseed_counter++;
+static void drbg_fill_parallel(const rdt_drbg_ctx *ctx, uint8_t *out, size_t len) {
+    drbg_parallel_job job = {ctx, out, len};
+    size_t slices = (len + RDT_DRBG_PARALLEL_SLICE_BYTES - 1u) / RDT_DRBG_PARALLEL_SLICE_BYTES;
+
+    rdt_pool_run(slices, drbg_fill_slice, &job);
 }
 
 /* -----------------------
    Public API
    ----------------------- */
 
-void rdt_drbg_init_u64(uint64_t entropy_seed,
-                       uint64_t nonce,
-                       uint64_t personalization) {
+void rdt_drbg_ctx_init_u64(rdt_drbg_ctx *ctx,
+                           uint64_t entropy_seed,
+                           uint64_t nonce,
+                           uint64_t personalization) {
+    if (!ctx) return;
+
     uint64_t sm = entropy_seed
                 ^ rotl64(nonce, 13)
                 ^ rotl64(personalization, 27)
                 ^ 0xA5A5A5A5A5A5A5A5ULL;
 
-    for (int i = 0; i < 4; i++) Kd[i] = splitmix64_next(&sm);
-    Vd[0] = splitmix64_next(&sm);
-    Vd[1] = splitmix64_next(&sm);
+    for (int i = 0; i < 4; i++) ctx->K[i] = splitmix64_next(&sm);
+    ctx->V[0] = splitmix64_next(&sm);
+    ctx->V[1] = splitmix64_next(&sm);
 
-    reseed_counter = 1;
+    ctx->reseed_counter = 1;
 
     /* one-time diffusion using PD derived from (seed,nonce,personalization) */
     uint8_t mat[24];
@@ -226,61 +378,189 @@ void rdt_drbg_init_u64(uint64_t entropy_seed,
     memcpy(mat + 16, &personalization, 8);
 
     uint64_t PD[4];
-    make_PD(PD, mat, sizeof(mat), NULL, 0);
-    drbg_update(PD, 1);
+    make_PD(PD, ctx->K, mat, sizeof(mat), NULL, 0);
+    drbg_update(ctx, PD, 1);
 }
 
-void rdt_drbg_reseed(const uint8_t *entropy, size_t entropy_len,
-                     const uint8_t *additional, size_t additional_len) {
+void rdt_drbg_ctx_reseed(rdt_drbg_ctx *ctx,
+                         const uint8_t *entropy, size_t entropy_len,
+                         const uint8_t *additional, size_t additional_len) {
+    if (!ctx) return;
+
     uint64_t PD[4];
-    make_PD(PD, entropy, entropy_len, additional, additional_len);
-    reseed_counter = 1;
-    drbg_update(PD, 1);
+    RDT_STATS_ADD(RDT_STAT_DRBG_RESEEDS, 1);
+    make_PD(PD, ctx->K, entropy, entropy_len, additional, additional_len);
+    ctx->reseed_counter = 1;
+    drbg_update(ctx, PD, 1);
 }
 
-int rdt_drbg_generate(uint8_t *out, size_t out_len,
-                      const uint8_t *additional, size_t additional_len,
-                      int prediction_resistance) {
-    if (!out && out_len) return -1;
+int rdt_drbg_ctx_generate(rdt_drbg_ctx *ctx,
+                          uint8_t *out, size_t out_len,
+                          const uint8_t *additional, size_t additional_len,
+                          int prediction_resistance) {
+    if (!ctx || (!out && out_len)) return -1;
 
     (void)prediction_resistance; /* policy is caller-driven reseed for true PR */
 
     /* pre-update with additional input (standard DRBG practice) */
     if (additional && additional_len) {
         uint64_t PD[4];
-        make_PD(PD, NULL, 0, additional, additional_len);
-        drbg_update(PD, 1);
+        make_PD(PD, ctx->K, NULL, 0, additional, additional_len);
+        drbg_update(ctx, PD, 1);
     }
 
-    /* generate bytes via Block(K, ++V) */
-    size_t produced = 0;
-    while (produced < out_len) {
-        inc_V();
-        uint64_t block = rdt_drbg_block(Vd[0], Vd[1], Kd);
-
-        size_t take = (out_len - produced < 8) ? (out_len - produced) : 8;
-        for (size_t i = 0; i < take; i++) {
-            out[produced + i] = (uint8_t)(block >> (8u * i));
+    /* generate bytes via Block(K, ++V), RDT_DRBG_LANES blocks per step */
+    uint64_t blocks[RDT_DRBG_LANES];
+    size_t produced = out_len - out_len % (8u * RDT_DRBG_LANES);
+    if (produced >= RDT_DRBG_PARALLEL_MIN_BYTES) {
+        drbg_fill_parallel(ctx, out, produced);
+    } else {
+        drbg_fill(ctx->V, ctx->K, out, produced);
+    }
+    add_V(ctx->V, (uint64_t)(produced / 8u));
+
+    /* tail: the counter only advances past the blocks actually emitted */
+    if (produced < out_len) {
+        size_t rest = out_len - produced;
+        size_t nblocks = (rest + 7u) / 8u;
+
+        if (nblocks == 1u) {
+            add_V(ctx->V, 1u);
+            blocks[0] = rdt_drbg_block(ctx->V[0], ctx->V[1], ctx->K);
+        } else {
+            rdt_drbg_block4(ctx->V, ctx->K, blocks);
+            add_V(ctx->V, (uint64_t)nblocks);
         }
-        produced += take;
+        for (size_t i = 0; i < rest; i++) {
+            out[produced + i] = (uint8_t)(blocks[i / 8u] >> (8u * (i % 8u)));
+        }
+        memset(blocks, 0, sizeof(blocks));
     }
 
     /* post-update with no PD for backtracking resistance */
-    drbg_update(NULL, 0);
+    drbg_update(ctx, NULL, 0);
+    RDT_STATS_ADD(RDT_STAT_DRBG_GENERATES, 1);
+    RDT_STATS_ADD(RDT_STAT_DRBG_BYTES, out_len);
 
     return 0;
 }
 
-uint64_t rdt_drbg_next_u64(void) {
+uint64_t rdt_drbg_ctx_next_u64(rdt_drbg_ctx *ctx) {
     uint64_t x = 0;
-    (void)rdt_drbg_generate((uint8_t*)&x, sizeof(x), NULL, 0, 0);
+    (void)rdt_drbg_ctx_generate(ctx, (uint8_t*)&x, sizeof(x), NULL, 0, 0);
     return x;
 }
 
-void rdt_drbg_zeroize(void) {
-    volatile uint64_t *p = (volatile uint64_t*)Kd;
+void rdt_drbg_ctx_zeroize(rdt_drbg_ctx *ctx) {
+    if (!ctx) return;
+    volatile uint64_t *p = (volatile uint64_t*)ctx->K;
     for (int i = 0; i < 4; i++) p[i] = 0;
-    volatile uint64_t *q = (volatile uint64_t*)Vd;
+    volatile uint64_t *q = (volatile uint64_t*)ctx->V;
     q[0] = q[1] = 0;
-    reseed_counter = 0;
+    ctx->reseed_counter = 0;
+}
+
+/* -----------------------
+   Buffered word interface
+   ----------------------- */
+
+static void secure_zero(void *ptr, size_t len) {
+    volatile uint8_t *p = (volatile uint8_t *)ptr;
+    for (size_t i = 0; i < len; i++) p[i] = 0;
+}
+
+static void drbg_buf_refill(rdt_drbg_buf *buf) {
+    uint8_t *bytes = (uint8_t *)buf->words;
+    size_t len = buf->batch_words * 8u;
+
+    (void)rdt_drbg_ctx_generate(buf->drbg, bytes, len, NULL, 0, 0);
+    /* generate emits little-endian words; read them back portably */
+    for (size_t i = 0; i < buf->batch_words; i++) {
+        uint64_t w = 0;
+        for (unsigned j = 0; j < 8u; j++) {
+            w |= (uint64_t)bytes[8u * i + j] << (8u * j);
+        }
+        buf->words[i] = w;
+    }
+    buf->pos = 0;
+}
+
+int rdt_drbg_buf_init(rdt_drbg_buf *buf, rdt_drbg_ctx *drbg, size_t batch_words) {
+    if (!buf || !drbg) return -1;
+    if (batch_words == 0) batch_words = RDT_DRBG_BUF_DEFAULT_WORDS;
+    if (batch_words > RDT_DRBG_BUF_MAX_WORDS) return -1;
+
+    secure_zero(buf, sizeof(*buf));
+    buf->drbg = drbg;
+    buf->batch_words = batch_words;
+    buf->pos = batch_words;
+    return 0;
+}
+
+uint64_t rdt_drbg_buf_next_u64(rdt_drbg_buf *buf) {
+    uint64_t x;
+
+    if (buf->pos >= buf->batch_words) drbg_buf_refill(buf);
+    x = buf->words[buf->pos];
+    buf->words[buf->pos++] = 0;
+    return x;
+}
+
+uint32_t rdt_drbg_buf_next_u32(rdt_drbg_buf *buf) {
+    uint32_t x;
+
+    if (buf->have_half) {
+        x = (uint32_t)buf->half;
+        buf->half = 0;
+        buf->have_half = 0;
+        return x;
+    }
+    buf->half = rdt_drbg_buf_next_u64(buf);
+    x = (uint32_t)buf->half;
+    buf->half >>= 32;
+    buf->have_half = 1;
+    return x;
+}
+
+void rdt_drbg_buf_discard(rdt_drbg_buf *buf) {
+    if (!buf) return;
+    secure_zero(buf->words, sizeof(buf->words));
+    buf->pos = buf->batch_words;
+    buf->half = 0;
+    buf->have_half = 0;
+}
+
+void rdt_drbg_buf_zeroize(rdt_drbg_buf *buf) {
+    if (!buf) return;
+    secure_zero(buf, sizeof(*buf));
+}
+
+/* -----------------------
+   Context-free API over default_ctx
+   ----------------------- */
+
+void rdt_drbg_init_u64(uint64_t entropy_seed,
+                       uint64_t nonce,
+                       uint64_t personalization) {
+    rdt_drbg_ctx_init_u64(&default_ctx, entropy_seed, nonce, personalization);
+}
+
+void rdt_drbg_reseed(const uint8_t *entropy, size_t entropy_len,
+                     const uint8_t *additional, size_t additional_len) {
+    rdt_drbg_ctx_reseed(&default_ctx, entropy, entropy_len, additional, additional_len);
+}
+
+int rdt_drbg_generate(uint8_t *out, size_t out_len,
+                      const uint8_t *additional, size_t additional_len,
+                      int prediction_resistance) {
+    return rdt_drbg_ctx_generate(&default_ctx, out, out_len,
+                                 additional, additional_len, prediction_resistance);
+}
+
+uint64_t rdt_drbg_next_u64(void) {
+    return rdt_drbg_ctx_next_u64(&default_ctx);
+}
+
+void rdt_drbg_zeroize(void) {
+    rdt_drbg_ctx_zeroize(&default_ctx);
 }
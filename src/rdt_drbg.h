@@ -8,6 +8,81 @@
 extern "C" {
 #endif
 
+/*
+Caller-owned DRBG state. The rdt_drbg_ctx_* functions touch nothing but the
+context they are given, so independent contexts may be used from different
+threads. The context-free functions further down operate on one process-wide
+default context and are kept for existing callers; they are not thread-safe.
+*/
+typedef struct {
+    uint64_t K[4];              /* 256-bit key */
+    uint64_t V[2];              /* 128-bit counter */
+    uint64_t reseed_counter;
+} rdt_drbg_ctx;
+
+/* Number of consecutive counter blocks the block function evaluates at once */
+#define RDT_DRBG_LANES 4u
+
+/*
+Requests of at least this many bytes are split across the rdt_pool worker
+threads (see rdt_pool.h). The output is byte-identical to the serial path.
+*/
+#define RDT_DRBG_PARALLEL_MIN_BYTES (1024u * 1024u)
+
+void rdt_drbg_ctx_init_u64(rdt_drbg_ctx *ctx,
+                           uint64_t entropy_seed,
+                           uint64_t nonce,
+                           uint64_t personalization);
+
+void rdt_drbg_ctx_reseed(rdt_drbg_ctx *ctx,
+                         const uint8_t *entropy, size_t entropy_len,
+                         const uint8_t *additional, size_t additional_len);
+
+/* Same contract as rdt_drbg_generate; also returns -1 if ctx is NULL. */
+int rdt_drbg_ctx_generate(rdt_drbg_ctx *ctx,
+                          uint8_t *out, size_t out_len,
+                          const uint8_t *additional, size_t additional_len,
+                          int prediction_resistance);
+
+uint64_t rdt_drbg_ctx_next_u64(rdt_drbg_ctx *ctx);
+
+void rdt_drbg_ctx_zeroize(rdt_drbg_ctx *ctx);
+
+/*
+Buffered word interface.
+
+rdt_drbg_ctx_next_u64 pays a full generate (one block plus the four-block
+post-update and re-key) for every 64-bit word. rdt_drbg_buf instead pulls
+batch_words words from one rdt_drbg_ctx_generate call and serves them one at a
+time, so the re-key cadence is explicit: the DRBG key is updated once per
+batch_words words served (RDT_DRBG_BUF_DEFAULT_WORDS = every 2 KiB by default).
+
+Words still waiting in the buffer were produced under the previous key, so
+backtracking resistance only covers whole batches. Each word is wiped from the
+buffer as it is served. After reseeding the underlying context, call
+rdt_drbg_buf_discard so no pre-reseed output is served.
+
+next_u32 returns the low half of a word and then its high half.
+*/
+#define RDT_DRBG_BUF_MAX_WORDS 512u
+#define RDT_DRBG_BUF_DEFAULT_WORDS 256u
+
+typedef struct {
+    rdt_drbg_ctx *drbg;
+    size_t batch_words;
+    size_t pos;                  /* next unread word; == batch_words when empty */
+    uint64_t words[RDT_DRBG_BUF_MAX_WORDS];
+    uint64_t half;               /* pending high half for next_u32 */
+    int have_half;
+} rdt_drbg_buf;
+
+/* batch_words 0 selects the default; returns -1 on NULL ctx or batch > max */
+int rdt_drbg_buf_init(rdt_drbg_buf *buf, rdt_drbg_ctx *drbg, size_t batch_words);
+uint64_t rdt_drbg_buf_next_u64(rdt_drbg_buf *buf);
+uint32_t rdt_drbg_buf_next_u32(rdt_drbg_buf *buf);
+void rdt_drbg_buf_discard(rdt_drbg_buf *buf);
+void rdt_drbg_buf_zeroize(rdt_drbg_buf *buf);
+
 /* Instantiate */
 void rdt_drbg_init_u64(uint64_t entropy_seed,
                        uint64_t nonce,
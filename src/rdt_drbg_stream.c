@@ -8,6 +8,8 @@ int main(int argc, char **argv) {
     uint64_t entropy_seed = 0x0123456789ABCDEFULL;
     uint64_t nonce = 0xFEDCBA9876543210ULL;
     uint64_t personalization = 0xA5A5A5A5A5A5A5A5ULL;
+    rdt_drbg_ctx drbg;
+    rdt_drbg_buf words;
     uint64_t buf[4096];
     size_t i;
     static char io_buf[1 << 20];
@@ -23,11 +25,14 @@ int main(int argc, char **argv) {
     }
 
     setvbuf(stdout, io_buf, _IOFBF, sizeof(io_buf));
-    rdt_drbg_init_u64(entropy_seed, nonce, personalization);
+    rdt_drbg_ctx_init_u64(&drbg, entropy_seed, nonce, personalization);
+    if (rdt_drbg_buf_init(&words, &drbg, RDT_DRBG_BUF_MAX_WORDS) != 0) {
+        return 1;
+    }
 
     for (;;) {
         for (i = 0; i < sizeof(buf) / sizeof(buf[0]); i++) {
-            buf[i] = rdt_drbg_next_u64();
+            buf[i] = rdt_drbg_buf_next_u64(&words);
         }
         if (fwrite(buf, sizeof(buf[0]), sizeof(buf) / sizeof(buf[0]), stdout)
             != sizeof(buf) / sizeof(buf[0])) {
@@ -35,5 +40,7 @@ int main(int argc, char **argv) {
         }
     }
 
+    rdt_drbg_buf_zeroize(&words);
+    rdt_drbg_ctx_zeroize(&drbg);
     return 0;
 }
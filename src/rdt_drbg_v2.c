@@ -2,6 +2,7 @@
 
 #include "rdt_core.h"
 #include "rdt_sha256.h"
+#include "rdt_stats.h"
 
 #include <fcntl.h>
 #include <stdlib.h>
@@ -58,6 +59,7 @@ static void drbg_v2_update(rdt_drbg_v2_ctx *ctx, const uint8_t *provided_data, s
     uint8_t sep0 = 0x00u;
     uint8_t sep1 = 0x01u;
 
+    RDT_STATS_ADD(RDT_STAT_DRBG_V2_UPDATES, 1);
     hmac_sha256_parts(ctx->K, ctx->V, sizeof(ctx->V), &sep0, 1u, provided_data, provided_len, ctx->K);
     rdt_hmac_sha256(ctx->K, sizeof(ctx->K), ctx->V, sizeof(ctx->V), ctx->V);
 
@@ -273,6 +275,7 @@ int rdt_drbg_v2_reseed(rdt_drbg_v2_ctx *ctx,
 
     drbg_v2_update(ctx, seed_material, seed_material_len);
     ctx->reseed_counter = 1;
+    RDT_STATS_ADD(RDT_STAT_DRBG_V2_RESEEDS, 1);
 
     if (seed_material) {
         secure_zero(seed_material, seed_material_len);
@@ -281,6 +284,18 @@ int rdt_drbg_v2_reseed(rdt_drbg_v2_ctx *ctx,
     return RDT_DRBG_V2_OK;
 }
 
+int rdt_drbg_v2_reseed_health(rdt_drbg_v2_ctx *ctx, rdt_health *health,
+                              const uint8_t *entropy, size_t entropy_len,
+                              const uint8_t *additional, size_t additional_len) {
+    if (!ctx || !ctx->seeded || !health || !entropy || !entropy_len) {
+        return RDT_DRBG_V2_ERR_ARGS;
+    }
+    if (rdt_health_feed(health, entropy, entropy_len) != 0) {
+        return RDT_DRBG_V2_ERR_HEALTH;
+    }
+    return rdt_drbg_v2_reseed(ctx, entropy, entropy_len, additional, additional_len);
+}
+
 int rdt_drbg_v2_reseed_system(rdt_drbg_v2_ctx *ctx,
                               const uint8_t *additional, size_t additional_len) {
     uint8_t entropy[RDT_DRBG_V2_SEED_BYTES];
@@ -338,6 +353,8 @@ int rdt_drbg_v2_generate(rdt_drbg_v2_ctx *ctx,
 
     drbg_v2_update(ctx, additional, additional_len);
     ctx->reseed_counter += 1;
+    RDT_STATS_ADD(RDT_STAT_DRBG_V2_GENERATES, 1);
+    RDT_STATS_ADD(RDT_STAT_DRBG_V2_BYTES, out_len);
     return RDT_DRBG_V2_OK;
 }
 
@@ -4,6 +4,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "rdt_health.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -21,7 +23,8 @@ enum {
     RDT_DRBG_V2_ERR_REQUEST_TOO_LARGE = -4,
     RDT_DRBG_V2_ERR_PREDICTION_RESISTANCE = -5,
     RDT_DRBG_V2_ERR_ALLOC = -6,
-    RDT_DRBG_V2_ERR_ENTROPY = -7
+    RDT_DRBG_V2_ERR_ENTROPY = -7,
+    RDT_DRBG_V2_ERR_HEALTH = -8
 };
 
 typedef struct {
@@ -48,6 +51,15 @@ int rdt_drbg_v2_reseed(rdt_drbg_v2_ctx *ctx,
                        const uint8_t *entropy, size_t entropy_len,
                        const uint8_t *additional, size_t additional_len);
 
+/*
+ * Reseed from raw noise samples: entropy is first run through the health
+ * monitor, and if the monitor has failed (now or earlier) the reseed is
+ * refused with RDT_DRBG_V2_ERR_HEALTH and the state is left unchanged.
+ */
+int rdt_drbg_v2_reseed_health(rdt_drbg_v2_ctx *ctx, rdt_health *health,
+                              const uint8_t *entropy, size_t entropy_len,
+                              const uint8_t *additional, size_t additional_len);
+
 int rdt_drbg_v2_reseed_system(rdt_drbg_v2_ctx *ctx,
                               const uint8_t *additional, size_t additional_len);
 
@@ -0,0 +1,1289 @@
+/*
+ * RDT Entropy Assessment - C Implementation
+ * =========================================
+ * NIST SP 800-90B section 6.3 non-IID min-entropy estimators.
+ *
+ * Author: Steven Reid
+ * ORCID: 0009-0003-9132-3410
+ * License: MIT
+ *
+ * Layout:
+ *   1. Confidence bounds and the predictor (global / local) estimate
+ *   2. Counting estimators: MCV, collision, Markov, compression
+ *   3. t-tuple and LRS from one suffix array + LCP pass
+ *   4. Predictors: MultiMCW, Lag, MultiMMC, LZ78Y
+ *   5. Scheduling on rdt_pool and file input
+ *
+ * Compile:
+ *   gcc -O3 -pthread -DRDT_ENTROPY_MAIN -o rdt_entropy \
+ *       rdt_entropy.c rdt_pool.c -lm
+ */
+
+#define _DEFAULT_SOURCE
+#include "rdt_entropy.h"
+#include "rdt_pool.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define Z_99 2.576           /* one-sided 99% bound used throughout 6.3 */
+#define TUPLE_CUTOFF 35u     /* t-tuple: most common tuple seen at least this often */
+#define COMPRESSION_B 6u
+#define COMPRESSION_D 1000u
+#define MCW_WINDOWS 4
+#define LAG_DEPTH 128u
+#define MMC_DEPTH 16u
+#define MMC_MAX_ENTRIES 100000u
+#define LZ78Y_DEPTH 16u
+#define LZ78Y_MAX_ENTRIES 65536u
+#define CONTEXT_DEPTH 16u    /* longest context the dictionaries key on */
+#define NO_PREDICTION 0xFFFFu
+
+static const uint32_t mcw_windows[MCW_WINDOWS] = {63u, 255u, 1023u, 4095u};
+
+/* ========================================================================== */
+/* Bounds and Predictor Estimate                                              */
+/* ========================================================================== */
+
+static double upper_bound(double p, double n) {
+    double pu = p + Z_99 * sqrt(p * (1.0 - p) / (n - 1.0));
+    return (pu > 1.0) ? 1.0 : pu;
+}
+
+static double min_entropy_of(double p) {
+    return (p >= 1.0) ? 0.0 : -log2(p);
+}
+
+typedef struct {
+    uint64_t n;
+    uint64_t correct;
+    uint64_t run;
+    uint64_t longest;
+} prediction_tally;
+
+static void tally(prediction_tally *t, int hit) {
+    t->n++;
+    if (hit) {
+        t->correct++;
+        if (++t->run > t->longest) t->longest = t->run;
+    } else {
+        t->run = 0;
+    }
+}
+
+/*
+ * log of the probability that n trials with success probability p contain
+ * no run of r successes (6.3.7 step 4). x = 1 + e is the root of
+ * 1 - x + q p^r x^(r+1) = 0 near 1; working with e keeps log(x) accurate
+ * when n is in the billions.
+ */
+static double no_run_log_prob(double p, double r, double n) {
+    double q = 1.0 - p;
+    double e = 0.0;
+
+    if (p <= 0.0) return 0.0;
+    if (q <= 0.0) return -INFINITY;
+    for (int j = 0; j < 10; j++) {
+        e = exp(log(q) + r * log(p) + (r + 1.0) * log1p(e));
+        if (!isfinite(e)) return -INFINITY;
+    }
+    if (q - p * e <= 0.0 || 1.0 - r * e <= 0.0) return -INFINITY;
+    return log(q - p * e) - log((1.0 - r * e) * q) - (n + 1.0) * log1p(e);
+}
+
+/* Min-entropy from a predictor's hit count and longest run of hits */
+static double predictor_estimate(const prediction_tally *t, unsigned k) {
+    double n = (double)t->n;
+    double pg;
+    double lo = 0.0;
+    double hi = 1.0;
+    double target = log(0.99);
+    double r = (double)t->longest + 1.0;
+    double p;
+
+    if (t->n < 2u) return -1.0;
+    if (t->correct == 0) {
+        pg = 1.0 - pow(0.01, 1.0 / n);
+    } else {
+        pg = upper_bound((double)t->correct / n, n);
+    }
+    for (int it = 0; it < 64; it++) {
+        double mid = 0.5 * (lo + hi);
+        if (no_run_log_prob(mid, r, n) > target) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    p = (pg > hi) ? pg : hi;
+    if (p < 1.0 / (double)k) p = 1.0 / (double)k;
+    return min_entropy_of(p);
+}
+
+/* ========================================================================== */
+/* Counting Estimators                                                        */
+/* ========================================================================== */
+
+/* Each estimator writes its slot(s) of est; -1 return means out of memory. */
+typedef int (*estimator_fn)(const uint8_t *s, size_t len, unsigned k, double *est);
+
+static int estimate_mcv(const uint8_t *s, size_t len, unsigned k, double *est) {
+    uint64_t counts[4][256];
+    uint64_t top = 0;
+    size_t i = 0;
+
+    (void)k;
+    memset(counts, 0, sizeof(counts));
+    for (; i + 4u <= len; i += 4u) {
+        counts[0][s[i]]++;
+        counts[1][s[i + 1u]]++;
+        counts[2][s[i + 2u]]++;
+        counts[3][s[i + 3u]]++;
+    }
+    for (; i < len; i++) {
+        counts[0][s[i]]++;
+    }
+    for (unsigned v = 0; v < 256u; v++) {
+        uint64_t c = counts[0][v] + counts[1][v] + counts[2][v] + counts[3][v];
+        if (c > top) top = c;
+    }
+    est[RDT_ENTROPY_MCV] = min_entropy_of(upper_bound((double)top / (double)len, (double)len));
+    return 0;
+}
+
+/*
+ * Binary input: every collision time is 2 or 3 and the expected time is
+ * 2 + 2p(1-p), so the bound on the mean solves for p in closed form.
+ */
+static int estimate_collision(const uint8_t *s, size_t len, unsigned k, double *est) {
+    uint64_t v = 0;
+    uint64_t threes = 0;
+    size_t i = 0;
+    double mean;
+    double sd;
+    double bound;
+    double p;
+
+    (void)k;
+    while (i + 1u < len) {
+        if (s[i] == s[i + 1u]) {
+            v++;
+            i += 2u;
+        } else if (i + 2u < len) {
+            v++;
+            threes++;
+            i += 3u;
+        } else {
+            break;
+        }
+    }
+    if (v < 2u) {
+        est[RDT_ENTROPY_COLLISION] = -1.0;
+        return 0;
+    }
+    mean = 2.0 + (double)threes / (double)v;
+    sd = sqrt((double)threes * (double)(v - threes) / ((double)v * (double)(v - 1u)));
+    bound = mean - Z_99 * sd / sqrt((double)v);
+    if (bound >= 2.5) {
+        p = 0.5;
+    } else if (bound <= 2.0) {
+        p = 1.0;
+    } else {
+        p = 0.5 + sqrt(0.25 - (bound - 2.0) / 2.0);
+    }
+    est[RDT_ENTROPY_COLLISION] = min_entropy_of(p);
+    return 0;
+}
+
+static double log2_or_neg_inf(double x) {
+    return (x > 0.0) ? log2(x) : -INFINITY;
+}
+
+static int estimate_markov(const uint8_t *s, size_t len, unsigned k, double *est) {
+    uint64_t trans[2][2] = {{0, 0}, {0, 0}};
+    uint64_t ones = 0;
+    double p0, p1, p00, p01, p10, p11;
+    double paths[6];
+    double best = -INFINITY;
+
+    (void)k;
+    for (size_t i = 0; i + 1u < len; i++) {
+        trans[s[i]][s[i + 1u]]++;
+        ones += s[i];
+    }
+    ones += s[len - 1u];
+
+    p1 = log2_or_neg_inf((double)ones / (double)len);
+    p0 = log2_or_neg_inf((double)(len - ones) / (double)len);
+    p00 = p01 = p10 = p11 = -INFINITY;
+    if (trans[0][0] + trans[0][1]) {
+        p00 = log2_or_neg_inf((double)trans[0][0] / (double)(trans[0][0] + trans[0][1]));
+        p01 = log2_or_neg_inf((double)trans[0][1] / (double)(trans[0][0] + trans[0][1]));
+    }
+    if (trans[1][0] + trans[1][1]) {
+        p10 = log2_or_neg_inf((double)trans[1][0] / (double)(trans[1][0] + trans[1][1]));
+        p11 = log2_or_neg_inf((double)trans[1][1] / (double)(trans[1][0] + trans[1][1]));
+    }
+
+    /* Most likely 128-bit sequences: 0..0, 0101.., 01..1, 10..0, 1010.., 1..1 */
+    paths[0] = p0 + 127.0 * p00;
+    paths[1] = p0 + 64.0 * p01 + 63.0 * p10;
+    paths[2] = p0 + p01 + 126.0 * p11;
+    paths[3] = p1 + p10 + 126.0 * p00;
+    paths[4] = p1 + 64.0 * p10 + 63.0 * p01;
+    paths[5] = p1 + 127.0 * p11;
+    for (int i = 0; i < 6; i++) {
+        if (paths[i] > best) best = paths[i];
+    }
+    est[RDT_ENTROPY_MARKOV] = (-best / 128.0 < 1.0) ? -best / 128.0 : 1.0;
+    return 0;
+}
+
+/*
+ * G(z) of 6.3.4 with the double sum folded over u: for each distance u the
+ * number of test blocks t > u is n - max(d, u), plus the t = u term once
+ * u is past the dictionary. The (1 - z)^(u-1) factor lets the tail be
+ * dropped once it is below double precision.
+ */
+static double compression_g(double z, size_t n, size_t d) {
+    double sum = 0.0;
+    double decay = 1.0;
+
+    for (size_t u = 1; u <= n; u++) {
+        if (u > 1u) {
+            double w = z * z * (double)(n - ((u > d) ? u : d));
+            if (u > d) w += z;
+            sum += log2((double)u) * decay * w;
+        }
+        decay *= 1.0 - z;
+        if (decay < 1e-18 && u > d) break;
+    }
+    return sum / (double)(n - d);
+}
+
+static double compression_expected(double p, size_t n, size_t d) {
+    double others = (double)((1u << COMPRESSION_B) - 1u);
+    return compression_g(p, n, d) + others * compression_g((1.0 - p) / others, n, d);
+}
+
+static int estimate_compression(const uint8_t *s, size_t len, unsigned k, double *est) {
+    size_t n = len / COMPRESSION_B;
+    size_t d = COMPRESSION_D;
+    size_t v;
+    uint64_t last_seen[1u << COMPRESSION_B];
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    double mean;
+    double sd;
+    double bound;
+    double lo = 1.0 / (double)(1u << COMPRESSION_B);
+    double hi = 1.0;
+
+    (void)k;
+    if (n < d + 2u) {
+        est[RDT_ENTROPY_COMPRESSION] = -1.0;
+        return 0;
+    }
+    v = n - d;
+    memset(last_seen, 0, sizeof(last_seen));
+    for (size_t i = 1; i <= n; i++) {
+        const uint8_t *b = s + (i - 1u) * COMPRESSION_B;
+        unsigned block = 0;
+        for (unsigned j = 0; j < COMPRESSION_B; j++) {
+            block = (block << 1) | b[j];
+        }
+        if (i > d) {
+            double dist = (double)(last_seen[block] ? i - last_seen[block] : i);
+            double l = log2(dist);
+            sum += l;
+            sum_sq += l * l;
+        }
+        last_seen[block] = i;
+    }
+    mean = sum / (double)v;
+    sd = sum_sq / (double)(v - 1u) - mean * mean;
+    sd = 0.5907 * sqrt((sd > 0.0) ? sd : 0.0);
+    bound = mean - Z_99 * sd / sqrt((double)v);
+
+    if (bound >= compression_expected(lo, n, d)) {
+        hi = lo;
+    } else {
+        for (int it = 0; it < 50; it++) {
+            double mid = 0.5 * (lo + hi);
+            if (compression_expected(mid, n, d) > bound) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+    }
+    est[RDT_ENTROPY_COMPRESSION] = min_entropy_of(hi) / (double)COMPRESSION_B;
+    return 0;
+}
+
+/* ========================================================================== */
+/* t-Tuple and LRS                                                            */
+/* ========================================================================== */
+
+/*
+ * Suffix array by prefix doubling with counting sorts, O(n log n). On
+ * return rank[] is the inverse of sa[].
+ */
+static void build_suffix_array(const uint8_t *s, uint32_t n, uint32_t *sa, uint32_t *rank,
+                               uint32_t *tmp, uint32_t *cnt) {
+    uint32_t classes = 0;
+
+    memset(cnt, 0, 257u * sizeof(*cnt));
+    for (uint32_t i = 0; i < n; i++) cnt[s[i] + 1u]++;
+    for (uint32_t v = 1; v <= 256u; v++) cnt[v] += cnt[v - 1u];
+    for (uint32_t i = 0; i < n; i++) sa[cnt[s[i]]++] = i;
+    for (uint32_t j = 0; j < n; j++) {
+        if (j == 0 || s[sa[j]] != s[sa[j - 1u]]) classes++;
+        rank[sa[j]] = classes - 1u;
+    }
+
+    for (uint32_t h = 1; classes < n; h <<= 1) {
+        uint32_t p = 0;
+
+        /* Order by the second half, then stable counting sort by the first */
+        for (uint32_t i = n - h; i < n; i++) tmp[p++] = i;
+        for (uint32_t j = 0; j < n; j++) {
+            if (sa[j] >= h) tmp[p++] = sa[j] - h;
+        }
+        memset(cnt, 0, ((size_t)classes + 1u) * sizeof(*cnt));
+        for (uint32_t i = 0; i < n; i++) cnt[rank[i] + 1u]++;
+        for (uint32_t c = 1; c <= classes; c++) cnt[c] += cnt[c - 1u];
+        for (uint32_t j = 0; j < n; j++) sa[cnt[rank[tmp[j]]]++] = tmp[j];
+
+        tmp[sa[0]] = 0;
+        classes = 1;
+        for (uint32_t j = 1; j < n; j++) {
+            uint32_t a = sa[j - 1u];
+            uint32_t b = sa[j];
+            int same = rank[a] == rank[b] && (a + h < n) == (b + h < n) &&
+                       (a + h >= n || rank[a + h] == rank[b + h]);
+            if (!same) classes++;
+            tmp[b] = classes - 1u;
+        }
+        memcpy(rank, tmp, (size_t)n * sizeof(*rank));
+        if (h > n / 2u) break;
+    }
+}
+
+/*
+ * Every lcp-interval of the suffix array is the set of occurrences of one
+ * tuple for all lengths W in (parent lcp, lcp]. Walking the intervals once
+ * gives, for each W, the largest occurrence count (t-tuple's Q[W]) and the
+ * number of matching pairs sum C(count, 2) (LRS's numerator).
+ */
+static int estimate_tuples(const uint8_t *s, size_t len, unsigned k, double *est) {
+    uint32_t n = (uint32_t)len;
+    uint32_t *sa = (uint32_t *)malloc((size_t)n * sizeof(*sa));
+    uint32_t *rank = (uint32_t *)malloc((size_t)n * sizeof(*rank));
+    uint32_t *lcp = (uint32_t *)malloc((size_t)n * sizeof(*lcp));
+    uint32_t *cnt = (uint32_t *)malloc(((size_t)n + 257u) * sizeof(*cnt));
+    uint64_t *pairs = (uint64_t *)calloc((size_t)n + 2u, sizeof(*pairs));
+    uint32_t *top_count = cnt;
+    uint32_t *st_lcp = sa;
+    uint32_t *st_lb = rank;
+    uint32_t longest = 0;
+    uint32_t t_max = 0;
+    size_t top = 0;
+    double p;
+
+    (void)k;
+    if (!sa || !rank || !lcp || !cnt || !pairs) {
+        free(sa);
+        free(rank);
+        free(lcp);
+        free(cnt);
+        free(pairs);
+        return -1;
+    }
+
+    build_suffix_array(s, n, sa, rank, lcp, cnt);
+
+    /* Kasai: lcp[j] = common prefix of suffixes sa[j - 1] and sa[j] */
+    lcp[0] = 0;
+    for (uint32_t i = 0, h = 0; i < n; i++) {
+        if (rank[i] == 0) {
+            h = 0;
+            continue;
+        }
+        uint32_t j = sa[rank[i] - 1u];
+        while (i + h < n && j + h < n && s[i + h] == s[j + h]) h++;
+        lcp[rank[i]] = h;
+        if (h) h--;
+    }
+
+    /* sa and rank are free now and hold the interval stack */
+    memset(top_count, 0, ((size_t)n + 1u) * sizeof(*top_count));
+    st_lcp[0] = 0;
+    st_lb[0] = 0;
+    for (uint32_t i = 1; i <= n; i++) {
+        uint32_t cur = (i < n) ? lcp[i] : 0u;
+        uint32_t lb = i - 1u;
+
+        while (cur < st_lcp[top]) {
+            uint32_t l = st_lcp[top];
+            uint32_t b = st_lb[top];
+            uint64_t size = (uint64_t)(i - b);
+            uint32_t parent;
+
+            top--;
+            parent = (cur > st_lcp[top]) ? cur : st_lcp[top];
+            if (size > top_count[l]) top_count[l] = (uint32_t)size;
+            pairs[parent + 1u] += size * (size - 1u) / 2u;
+            pairs[l + 1u] -= size * (size - 1u) / 2u;
+            if (l > longest) longest = l;
+            lb = b;
+        }
+        if (cur > st_lcp[top]) {
+            top++;
+            st_lcp[top] = cur;
+            st_lb[top] = lb;
+        }
+    }
+
+    /* Q[t] = largest interval at lcp >= t */
+    for (uint32_t l = longest; l > 1u; l--) {
+        if (top_count[l - 1u] < top_count[l]) top_count[l - 1u] = top_count[l];
+    }
+    while (t_max < longest && top_count[t_max + 1u] >= TUPLE_CUTOFF) t_max++;
+
+    if (t_max == 0) {
+        est[RDT_ENTROPY_T_TUPLE] = -1.0;
+    } else {
+        p = 0.0;
+        for (uint32_t t = 1; t <= t_max; t++) {
+            double pt = pow((double)top_count[t] / (double)(n - t + 1u), 1.0 / (double)t);
+            if (pt > p) p = pt;
+        }
+        est[RDT_ENTROPY_T_TUPLE] = min_entropy_of(upper_bound(p, (double)n));
+    }
+
+    if (t_max + 1u > longest) {
+        est[RDT_ENTROPY_LRS] = -1.0;
+    } else {
+        uint64_t running = 0;
+        p = 0.0;
+        for (uint32_t w = 1; w <= longest; w++) {
+            running += pairs[w];
+            if (w > t_max) {
+                double total = (double)(n - w + 1u) * (double)(n - w) / 2.0;
+                double pw = pow((double)running / total, 1.0 / (double)w);
+                if (pw > p) p = pw;
+            }
+        }
+        est[RDT_ENTROPY_LRS] = min_entropy_of(upper_bound(p, (double)n));
+    }
+
+    free(sa);
+    free(rank);
+    free(lcp);
+    free(cnt);
+    free(pairs);
+    return 0;
+}
+
+/* ========================================================================== */
+/* Predictors                                                                 */
+/* ========================================================================== */
+
+/*
+ * MultiMCW: each window keeps symbol counts and its most frequent symbol
+ * (ties to the most recent). Only losing an occurrence of the current
+ * leader forces a rescan of the alphabet.
+ */
+static int estimate_multi_mcw(const uint8_t *s, size_t len, unsigned k, double *est) {
+    uint32_t counts[MCW_WINDOWS][256];
+    size_t last_pos[256];
+    int leader[MCW_WINDOWS];
+    uint32_t lead_count[MCW_WINDOWS];
+    uint64_t score[MCW_WINDOWS];
+    prediction_tally t = {0, 0, 0, 0};
+    int winner = 0;
+
+    memset(counts, 0, sizeof(counts));
+    memset(last_pos, 0, sizeof(last_pos));
+    memset(score, 0, sizeof(score));
+    for (int j = 0; j < MCW_WINDOWS; j++) {
+        leader[j] = -1;
+        lead_count[j] = 0;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        unsigned x = s[i];
+
+        if (i >= mcw_windows[0]) {
+            tally(&t, leader[winner] == (int)x);
+            for (int j = 0; j < MCW_WINDOWS; j++) {
+                if (i >= mcw_windows[j] && leader[j] == (int)x) {
+                    score[j]++;
+                    if (score[j] >= score[winner]) winner = j;
+                }
+            }
+        }
+
+        last_pos[x] = i;
+        for (int j = 0; j < MCW_WINDOWS; j++) {
+            int rescan = 0;
+            if (i >= mcw_windows[j]) {
+                unsigned old = s[i - mcw_windows[j]];
+                counts[j][old]--;
+                rescan = (leader[j] == (int)old && old != x);
+            }
+            counts[j][x]++;
+            if (rescan) {
+                leader[j] = -1;
+                lead_count[j] = 0;
+                for (unsigned v = 0; v < k; v++) {
+                    if (counts[j][v] > lead_count[j] ||
+                        (counts[j][v] && counts[j][v] == lead_count[j] &&
+                         last_pos[v] > last_pos[leader[j]])) {
+                        leader[j] = (int)v;
+                        lead_count[j] = counts[j][v];
+                    }
+                }
+            } else if (counts[j][x] >= lead_count[j]) {
+                leader[j] = (int)x;
+                lead_count[j] = counts[j][x];
+            }
+        }
+    }
+    est[RDT_ENTROPY_MULTI_MCW] = predictor_estimate(&t, k);
+    return 0;
+}
+
+static void lag_hit(uint64_t *score, unsigned *winner, unsigned d) {
+    if (++score[d - 1u] >= score[*winner - 1u]) *winner = d;
+}
+
+/* Lags 32*base+1 .. 32*base+32 that matched, in increasing lag order */
+static void lag_hits_mask(uint64_t *score, unsigned *winner, uint32_t mask, unsigned base) {
+    while (mask) {
+        unsigned b = 31u - (unsigned)__builtin_clz(mask);
+        lag_hit(score, winner, base + 32u - b);
+        mask &= ~(1u << b);
+    }
+}
+
+static int estimate_lag(const uint8_t *s, size_t len, unsigned k, double *est) {
+    uint64_t score[LAG_DEPTH];
+    prediction_tally t = {0, 0, 0, 0};
+    unsigned winner = 1;
+
+    memset(score, 0, sizeof(score));
+    for (size_t i = 1; i < len; i++) {
+        uint8_t x = s[i];
+
+        tally(&t, s[i - winner] == x);
+#if defined(__AVX2__)
+        if (i >= LAG_DEPTH) {
+            __m256i want = _mm256_set1_epi8((char)x);
+            const uint8_t *h = s + i - LAG_DEPTH;
+            uint32_t m0 = (uint32_t)_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)h), want));
+            uint32_t m1 = (uint32_t)_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(h + 32)), want));
+            uint32_t m2 = (uint32_t)_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(h + 64)), want));
+            uint32_t m3 = (uint32_t)_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(h + 96)), want));
+            lag_hits_mask(score, &winner, m3, 0u);
+            lag_hits_mask(score, &winner, m2, 32u);
+            lag_hits_mask(score, &winner, m1, 64u);
+            lag_hits_mask(score, &winner, m0, 96u);
+            continue;
+        }
+#endif
+        for (unsigned d = 1; d <= LAG_DEPTH && d <= i; d++) {
+            if (s[i - d] == x) lag_hit(score, &winner, d);
+        }
+    }
+    est[RDT_ENTROPY_LAG] = predictor_estimate(&t, k);
+    return 0;
+}
+
+/*
+ * Dictionaries for MultiMMC and LZ78Y: an open-addressing table of
+ * (context, next symbol) counts and one of contexts holding their current
+ * best next symbol. Counts only grow, so the best symbol (highest count,
+ * ties to the larger symbol) is kept up to date on each increment.
+ * Contexts are up to 16 symbols packed into two words, newest in the low
+ * byte. The entry limits of 6.3.9 / 6.3.10 count (context, symbol) pairs.
+ *
+ * Long contexts rarely repeat, so most lookups miss. Probing runs over a
+ * byte array of hash fingerprints and only reads a slot on a match, and
+ * the callers hash all context lengths of a step up front and prefetch
+ * them before the first probe.
+ */
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+    uint32_t tag;       /* 1 | length << 1 | symbol << 8 */
+    uint32_t count;
+    uint64_t hash;      /* kept for rehashing */
+} dict_slot;
+
+typedef struct {
+    uint8_t *fp;        /* fingerprint per slot, 0 = empty */
+    dict_slot *slots;
+    size_t mask;
+    size_t used;
+    uint32_t key_mask;  /* tag bits that belong to the key */
+    int failed;
+} dict_table;
+
+typedef struct {
+    dict_table contexts;
+    dict_table pairs;
+    size_t max_pairs;
+} predictor_dict;
+
+/* A context, its hash and the hash of each (context, y) pair derive from it */
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+    uint64_t hash;
+    unsigned len;
+} dict_key;
+
+static uint64_t dict_mix(uint64_t h) {
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 29;
+    h *= 0x94D049BB133111EBULL;
+    return h ^ (h >> 32);
+}
+
+static uint64_t dict_pair_hash(const dict_key *key, unsigned y) {
+    return dict_mix(key->hash + 0x9E3779B97F4A7C15ULL * (y + 1u));
+}
+
+static uint8_t dict_fingerprint(uint64_t h) {
+    return (uint8_t)((h >> 56) | 1u);
+}
+
+static void dict_table_init(dict_table *t, uint32_t key_mask) {
+    t->fp = NULL;
+    t->slots = NULL;
+    t->mask = 0;
+    t->used = 0;
+    t->key_mask = key_mask;
+    t->failed = 0;
+}
+
+static void dict_prefetch(const dict_table *t, uint64_t h) {
+    if (t->fp) __builtin_prefetch(&t->fp[h & t->mask]);
+}
+
+static dict_slot *dict_find(const dict_table *t, uint64_t h, uint64_t lo, uint64_t hi, uint32_t tag) {
+    uint8_t want = dict_fingerprint(h);
+    size_t i;
+
+    if (!t->fp) return NULL;
+    for (i = h & t->mask; t->fp[i]; i = (i + 1u) & t->mask) {
+        const dict_slot *e = &t->slots[i];
+        if (t->fp[i] == want && e->lo == lo && e->hi == hi &&
+            (e->tag & t->key_mask) == (tag & t->key_mask)) {
+            return &t->slots[i];
+        }
+    }
+    return NULL;
+}
+
+static dict_slot *dict_place(dict_table *t, const dict_slot *e) {
+    size_t i = e->hash & t->mask;
+
+    while (t->fp[i]) i = (i + 1u) & t->mask;
+    t->fp[i] = dict_fingerprint(e->hash);
+    t->slots[i] = *e;
+    return &t->slots[i];
+}
+
+/* Caller checked that the key is absent; grows at 3/4 load */
+static dict_slot *dict_insert(dict_table *t, uint64_t h, uint64_t lo, uint64_t hi, uint32_t tag,
+                              uint32_t count) {
+    dict_slot e = {lo, hi, tag, count, h};
+
+    if (t->failed) return NULL;
+    if (!t->fp || (t->used + 1u) * 4u > (t->mask + 1u) * 3u) {
+        size_t cap = t->fp ? (t->mask + 1u) * 2u : 1024u;
+        size_t old_cap = t->fp ? t->mask + 1u : 0u;
+        uint8_t *old_fp = t->fp;
+        dict_slot *old = t->slots;
+        uint8_t *fp = (uint8_t *)calloc(cap, 1u);
+        dict_slot *slots = (dict_slot *)malloc(cap * sizeof(*slots));
+
+        if (!fp || !slots) {
+            free(fp);
+            free(slots);
+            t->failed = 1;
+            return NULL;
+        }
+        t->fp = fp;
+        t->slots = slots;
+        t->mask = cap - 1u;
+        for (size_t i = 0; i < old_cap; i++) {
+            if (old_fp[i]) dict_place(t, &old[i]);
+        }
+        free(old_fp);
+        free(old);
+    }
+    t->used++;
+    return dict_place(t, &e);
+}
+
+static void predictor_dict_init(predictor_dict *d, size_t max_pairs) {
+    dict_table_init(&d->contexts, 0xFFu);
+    dict_table_init(&d->pairs, 0xFFFFu);
+    d->max_pairs = max_pairs;
+}
+
+static void predictor_dict_free(predictor_dict *d) {
+    free(d->contexts.fp);
+    free(d->contexts.slots);
+    free(d->pairs.fp);
+    free(d->pairs.slots);
+}
+
+static int predictor_dict_failed(const predictor_dict *d) {
+    return d->contexts.failed || d->pairs.failed;
+}
+
+static void dict_count(predictor_dict *d, const dict_key *key, unsigned y) {
+    uint32_t ctx_tag = 1u | (key->len << 1);
+    uint32_t pair_tag = ctx_tag | (y << 8);
+    uint64_t pair_h = dict_pair_hash(key, y);
+    dict_slot *pair = dict_find(&d->pairs, pair_h, key->lo, key->hi, pair_tag);
+    dict_slot *ctx;
+    uint32_t c;
+
+    if (pair) {
+        if (pair->count != UINT32_MAX) pair->count++;
+        c = pair->count;
+    } else {
+        if (d->pairs.used >= d->max_pairs ||
+            !dict_insert(&d->pairs, pair_h, key->lo, key->hi, pair_tag, 1u)) {
+            return;
+        }
+        c = 1u;
+    }
+    ctx = dict_find(&d->contexts, key->hash, key->lo, key->hi, ctx_tag);
+    if (!ctx) {
+        dict_insert(&d->contexts, key->hash, key->lo, key->hi, pair_tag, c);
+    } else if (c > ctx->count || (c == ctx->count && y > (ctx->tag >> 8))) {
+        ctx->count = c;
+        ctx->tag = ctx_tag | (y << 8);
+    }
+}
+
+/* Most frequent successor of a context, or NO_PREDICTION */
+static unsigned dict_predict(const predictor_dict *d, const dict_key *key, uint32_t *count) {
+    const dict_slot *ctx = dict_find(&d->contexts, key->hash, key->lo, key->hi, 1u | (key->len << 1));
+
+    if (!ctx) return NO_PREDICTION;
+    *count = ctx->count;
+    return ctx->tag >> 8;
+}
+
+/*
+ * Contexts of lengths 1..16 ending at the newest symbol. The keys for one
+ * step are the update keys of the next, so each is hashed once.
+ */
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+    dict_key cur[CONTEXT_DEPTH + 1u];   /* ending at s[i - 1] */
+    dict_key prev[CONTEXT_DEPTH + 1u];  /* ending at s[i - 2] */
+} context_window;
+
+static void context_window_init(context_window *w) {
+    memset(w, 0, sizeof(*w));
+}
+
+static void context_window_push(context_window *w, uint8_t x) {
+    memcpy(w->prev, w->cur, sizeof(w->cur));
+    w->hi = (w->hi << 8) | (w->lo >> 56);
+    w->lo = (w->lo << 8) | x;
+    for (unsigned j = 1; j <= CONTEXT_DEPTH; j++) {
+        dict_key *key = &w->cur[j];
+        key->lo = w->lo & ((j >= 8u) ? ~0ULL : (1ULL << (8u * j)) - 1u);
+        key->hi = (j <= 8u) ? 0 : w->hi & ((j >= 16u) ? ~0ULL : (1ULL << (8u * (j - 8u))) - 1u);
+        key->len = j;
+        key->hash = dict_mix(key->lo ^ (key->hi * 0xC2B2AE3D27D4EB4FULL) ^ ((uint64_t)j << 58));
+    }
+}
+
+static int estimate_multi_mmc(const uint8_t *s, size_t len, unsigned k, double *est) {
+    predictor_dict dicts[MMC_DEPTH];
+    uint64_t score[MMC_DEPTH];
+    unsigned predicted[MMC_DEPTH];
+    prediction_tally t = {0, 0, 0, 0};
+    context_window *w = (context_window *)malloc(sizeof(*w));
+    unsigned winner = 0;
+    int failed = 0;
+
+    if (!w) return -1;
+    context_window_init(w);
+    memset(score, 0, sizeof(score));
+    for (unsigned d = 0; d < MMC_DEPTH; d++) {
+        predictor_dict_init(&dicts[d], MMC_MAX_ENTRIES);
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        if (i >= 2u) {
+            unsigned x = s[i];
+            unsigned depth = (i - 1u < MMC_DEPTH) ? (unsigned)(i - 1u) : MMC_DEPTH;
+            uint32_t c;
+
+            for (unsigned d = 1; d <= MMC_DEPTH; d++) {
+                dict_prefetch(&dicts[d - 1u].contexts, w->cur[d].hash);
+                if (d <= depth) dict_prefetch(&dicts[d - 1u].pairs, dict_pair_hash(&w->prev[d], s[i - 1u]));
+            }
+            for (unsigned d = 1; d <= depth; d++) {
+                dict_count(&dicts[d - 1u], &w->prev[d], s[i - 1u]);
+            }
+            for (unsigned d = 1; d <= MMC_DEPTH; d++) {
+                predicted[d - 1u] = (d <= i) ? dict_predict(&dicts[d - 1u], &w->cur[d], &c) : NO_PREDICTION;
+            }
+            tally(&t, predicted[winner] == x);
+            for (unsigned d = 0; d < MMC_DEPTH; d++) {
+                if (predicted[d] == x) {
+                    score[d]++;
+                    if (score[d] >= score[winner]) winner = d;
+                }
+            }
+        }
+        context_window_push(w, s[i]);
+    }
+
+    free(w);
+    for (unsigned d = 0; d < MMC_DEPTH; d++) {
+        failed |= predictor_dict_failed(&dicts[d]);
+        predictor_dict_free(&dicts[d]);
+    }
+    if (failed) return -1;
+    est[RDT_ENTROPY_MULTI_MMC] = predictor_estimate(&t, k);
+    return 0;
+}
+
+static int estimate_lz78y(const uint8_t *s, size_t len, unsigned k, double *est) {
+    predictor_dict dict;
+    prediction_tally t = {0, 0, 0, 0};
+    context_window *w = (context_window *)malloc(sizeof(*w));
+    int failed;
+
+    if (!w) return -1;
+    context_window_init(w);
+    predictor_dict_init(&dict, LZ78Y_MAX_ENTRIES);
+    for (size_t i = 0; i < len; i++) {
+        if (i > LZ78Y_DEPTH) {
+            unsigned prediction = NO_PREDICTION;
+            uint32_t best = 0;
+
+            for (unsigned j = LZ78Y_DEPTH; j >= 1u; j--) {
+                dict_prefetch(&dict.pairs, dict_pair_hash(&w->prev[j], s[i - 1u]));
+                dict_prefetch(&dict.contexts, w->cur[j].hash);
+            }
+            for (unsigned j = LZ78Y_DEPTH; j >= 1u; j--) {
+                dict_count(&dict, &w->prev[j], s[i - 1u]);
+            }
+            for (unsigned j = LZ78Y_DEPTH; j >= 1u; j--) {
+                uint32_t c = 0;
+                unsigned y = dict_predict(&dict, &w->cur[j], &c);
+                if (y != NO_PREDICTION && c > best) {
+                    prediction = y;
+                    best = c;
+                }
+            }
+            tally(&t, prediction == s[i]);
+        }
+        context_window_push(w, s[i]);
+    }
+
+    free(w);
+    failed = predictor_dict_failed(&dict);
+    predictor_dict_free(&dict);
+    if (failed) return -1;
+    est[RDT_ENTROPY_LZ78Y] = predictor_estimate(&t, k);
+    return 0;
+}
+
+/* ========================================================================== */
+/* Assessment                                                                 */
+/* ========================================================================== */
+
+static const char *const estimator_names[RDT_ENTROPY_ESTIMATORS] = {
+    "most_common_value", "collision", "markov", "compression", "t_tuple",
+    "lrs", "multi_mcw", "lag", "multi_mmc", "lz78y"
+};
+
+const char *rdt_entropy_estimator_name(unsigned estimator) {
+    return (estimator < RDT_ENTROPY_ESTIMATORS) ? estimator_names[estimator] : NULL;
+}
+
+void rdt_entropy_config_init(rdt_entropy_config *config) {
+    if (!config) return;
+    config->bits_per_symbol = 8u;
+    config->max_samples = 0;
+    config->tuple_samples = RDT_ENTROPY_TUPLE_SAMPLES;
+    config->bitstring_bits = RDT_ENTROPY_BITSTRING_BITS;
+}
+
+typedef struct {
+    estimator_fn fn;
+    const uint8_t *s;
+    size_t len;
+    unsigned k;
+    double *est;
+    int status;
+} assess_task;
+
+static void assess_run(void *arg, size_t index) {
+    assess_task *task = (assess_task *)arg + index;
+    task->status = task->fn(task->s, task->len, task->k, task->est);
+}
+
+/* Slowest first, so the pool does not end on one long pass */
+static size_t add_tasks(assess_task *tasks, size_t n, const uint8_t *s, size_t len,
+                        size_t tuple_len, unsigned k, double *est) {
+    static const estimator_fn order[] = {
+        estimate_multi_mmc, estimate_lz78y, estimate_tuples, estimate_lag, estimate_multi_mcw,
+        estimate_compression, estimate_collision, estimate_markov, estimate_mcv
+    };
+
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        int binary_only = (order[i] == estimate_compression || order[i] == estimate_collision ||
+                           order[i] == estimate_markov);
+        if (binary_only && k != 2u) continue;
+        tasks[n].fn = order[i];
+        tasks[n].s = s;
+        tasks[n].len = (order[i] == estimate_tuples) ? tuple_len : len;
+        tasks[n].k = k;
+        tasks[n].est = est;
+        tasks[n].status = 0;
+        n++;
+    }
+    return n;
+}
+
+static double smallest_estimate(const double *est) {
+    double h = -1.0;
+
+    for (unsigned i = 0; i < RDT_ENTROPY_ESTIMATORS; i++) {
+        if (est[i] >= 0.0 && (h < 0.0 || est[i] < h)) h = est[i];
+    }
+    return h;
+}
+
+int rdt_entropy_assess(const uint8_t *data, size_t len, const rdt_entropy_config *config,
+                       rdt_entropy_report *report) {
+    rdt_entropy_config cfg;
+    assess_task tasks[18];
+    size_t n_tasks;
+    uint8_t *masked = NULL;
+    uint8_t *bits = NULL;
+    const uint8_t *samples = data;
+    size_t n_bits = 0;
+    unsigned width;
+    int rc = 0;
+
+    if (!data || !report) return -1;
+    rdt_entropy_config_init(&cfg);
+    if (config) {
+        if (config->bits_per_symbol) cfg.bits_per_symbol = config->bits_per_symbol;
+        cfg.max_samples = config->max_samples;
+        if (config->tuple_samples) cfg.tuple_samples = config->tuple_samples;
+        if (config->bitstring_bits) cfg.bitstring_bits = config->bitstring_bits;
+    }
+    width = cfg.bits_per_symbol;
+    if (width > 8u || cfg.tuple_samples > 0xFFFFFF00u || cfg.bitstring_bits > 0xFFFFFF00u) return -1;
+    if (cfg.max_samples && len > cfg.max_samples) len = cfg.max_samples;
+    if (len < 2u) return -1;
+
+    memset(report, 0, sizeof(*report));
+    report->bits_per_symbol = width;
+    report->samples = len;
+    report->tuple_samples = (len < cfg.tuple_samples) ? len : cfg.tuple_samples;
+    for (unsigned i = 0; i < RDT_ENTROPY_ESTIMATORS; i++) {
+        report->original[i] = -1.0;
+        report->bitstring[i] = -1.0;
+    }
+
+    if (width < 8u) {
+        uint8_t keep = (uint8_t)((1u << width) - 1u);
+        masked = (uint8_t *)malloc(len);
+        if (!masked) return -1;
+        for (size_t i = 0; i < len; i++) masked[i] = data[i] & keep;
+        samples = masked;
+    }
+    if (width > 1u) {
+        n_bits = (len > cfg.bitstring_bits / width) ? cfg.bitstring_bits : len * width;
+        bits = (uint8_t *)malloc(n_bits ? n_bits : 1u);
+        if (!bits) {
+            free(masked);
+            return -1;
+        }
+        for (size_t i = 0; i < n_bits; i++) {
+            bits[i] = (uint8_t)((samples[i / width] >> (width - 1u - i % width)) & 1u);
+        }
+    }
+    report->bitstring_bits = n_bits;
+
+    n_tasks = add_tasks(tasks, 0, samples, len, report->tuple_samples, 1u << width, report->original);
+    if (n_bits >= 2u) {
+        n_tasks = add_tasks(tasks, n_tasks, bits, n_bits,
+                            (n_bits < cfg.tuple_samples) ? n_bits : cfg.tuple_samples, 2u,
+                            report->bitstring);
+    }
+    rdt_pool_run(n_tasks, assess_run, tasks);
+    for (size_t i = 0; i < n_tasks; i++) {
+        if (tasks[i].status != 0) rc = -1;
+    }
+
+    report->h_original = smallest_estimate(report->original);
+    report->h_bitstring = smallest_estimate(report->bitstring);
+    report->min_entropy = report->h_original;
+    if (width > 1u && report->h_bitstring >= 0.0 &&
+        (report->min_entropy < 0.0 || (double)width * report->h_bitstring < report->min_entropy)) {
+        report->min_entropy = (double)width * report->h_bitstring;
+    }
+
+    free(masked);
+    free(bits);
+    return rc;
+}
+
+int rdt_entropy_assess_file(const char *path, const rdt_entropy_config *config,
+                            rdt_entropy_report *report) {
+    struct stat st;
+    void *map;
+    int fd;
+    int rc;
+
+    if (!path || !report) return -1;
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+        close(fd);
+        return -1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+    (void)madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    rc = rdt_entropy_assess((const uint8_t *)map, (size_t)st.st_size, config, report);
+    munmap(map, (size_t)st.st_size);
+    return rc;
+}
+
+/* ========================================================================== */
+/* CLI Tool                                                                   */
+/* ========================================================================== */
+
+#ifdef RDT_ENTROPY_MAIN
+
+static void print_usage(const char *prog) {
+    fprintf(stderr, "RDT Entropy Assessment (NIST SP 800-90B non-IID estimators)\n");
+    fprintf(stderr, "Author: Steven Reid (ORCID: 0009-0003-9132-3410)\n\n");
+    fprintf(stderr, "Usage: %s [options] <file|->\n\n", prog);
+    fprintf(stderr, "Every input byte is one sample. The report is printed as JSON.\n\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -h, --help           Show this help\n");
+    fprintf(stderr, "  --bits N             Bits per sample, 1-8 (default 8; low bits of each byte)\n");
+    fprintf(stderr, "  --samples N          Assess only the first N samples\n");
+    fprintf(stderr, "  --tuple-samples N    Samples for t-tuple and LRS (default %u)\n",
+            RDT_ENTROPY_TUPLE_SAMPLES);
+    fprintf(stderr, "  --bitstring-bits N   Bits for the bitstring estimators (default %u)\n",
+            RDT_ENTROPY_BITSTRING_BITS);
+    fprintf(stderr, "  --require H          Exit with status 3 if min-entropy < H bits per sample\n");
+    fprintf(stderr, "  -j N                 Worker threads (default: online CPUs)\n");
+}
+
+static int parse_size(const char *text, size_t *out) {
+    char *end;
+    unsigned long long v = strtoull(text, &end, 10);
+    if (*end != '\0' || v == 0 || text[0] == '-') return -1;
+    *out = (size_t)v;
+    return 0;
+}
+
+static int read_stdin(uint8_t **data_out, size_t *len_out) {
+    size_t cap = 1u << 20;
+    size_t len = 0;
+    uint8_t *data = (uint8_t *)malloc(cap);
+
+    while (data) {
+        ssize_t got;
+        if (len == cap) {
+            uint8_t *grown = (uint8_t *)realloc(data, cap * 2u);
+            if (!grown) break;
+            data = grown;
+            cap *= 2u;
+        }
+        got = read(STDIN_FILENO, data + len, cap - len);
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0) break;
+        if (got == 0) {
+            *data_out = data;
+            *len_out = len;
+            return 0;
+        }
+        len += (size_t)got;
+    }
+    free(data);
+    return -1;
+}
+
+static void print_estimates(const char *name, const double *est, int last) {
+    printf("  \"%s\": {\n", name);
+    for (unsigned i = 0; i < RDT_ENTROPY_ESTIMATORS; i++) {
+        const char *comma = (i + 1u < RDT_ENTROPY_ESTIMATORS) ? "," : "";
+        if (est[i] < 0.0) {
+            printf("    \"%s\": null%s\n", estimator_names[i], comma);
+        } else {
+            printf("    \"%s\": %.6f%s\n", estimator_names[i], est[i], comma);
+        }
+    }
+    printf("  }%s\n", last ? "" : ",");
+}
+
+static void print_value(const char *name, double value, int last) {
+    if (value < 0.0) {
+        printf("  \"%s\": null%s\n", name, last ? "" : ",");
+    } else {
+        printf("  \"%s\": %.6f%s\n", name, value, last ? "" : ",");
+    }
+}
+
+static void print_json_string(const char *s) {
+    putchar('"');
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            printf("\\%c", c);
+        } else if (c < 0x20u) {
+            printf("\\u%04x", c);
+        } else {
+            putchar(c);
+        }
+    }
+    putchar('"');
+}
+
+int main(int argc, char **argv) {
+    rdt_entropy_config cfg;
+    rdt_entropy_report report;
+    const char *input = NULL;
+    double require = -1.0;
+    size_t input_bytes = 0;
+    int result;
+
+    rdt_entropy_config_init(&cfg);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "--bits") == 0 && i + 1 < argc) {
+            size_t n;
+            if (parse_size(argv[++i], &n) != 0 || n > 8u) {
+                fprintf(stderr, "Error: --bits expects 1 to 8\n");
+                return 1;
+            }
+            cfg.bits_per_symbol = (unsigned)n;
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            if (parse_size(argv[++i], &cfg.max_samples) != 0) {
+                fprintf(stderr, "Error: --samples expects a positive count\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--tuple-samples") == 0 && i + 1 < argc) {
+            if (parse_size(argv[++i], &cfg.tuple_samples) != 0 || cfg.tuple_samples > 0xFFFFFF00u) {
+                fprintf(stderr, "Error: --tuple-samples expects 1 to %u\n", 0xFFFFFF00u);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bitstring-bits") == 0 && i + 1 < argc) {
+            if (parse_size(argv[++i], &cfg.bitstring_bits) != 0 || cfg.bitstring_bits > 0xFFFFFF00u) {
+                fprintf(stderr, "Error: --bitstring-bits expects 1 to %u\n", 0xFFFFFF00u);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--require") == 0 && i + 1 < argc) {
+            char *end;
+            require = strtod(argv[++i], &end);
+            if (*end != '\0' || !(require >= 0.0) || require > 8.0) {
+                fprintf(stderr, "Error: --require expects 0 to 8 bits\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            size_t threads;
+            if (parse_size(argv[++i], &threads) != 0 || threads > 64u) {
+                fprintf(stderr, "Error: -j expects a thread count from 1 to 64\n");
+                return 1;
+            }
+            rdt_pool_set_threads((unsigned)threads);
+        } else if (!input && (argv[i][0] != '-' || strcmp(argv[i], "-") == 0)) {
+            input = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!input) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (strcmp(input, "-") == 0) {
+        uint8_t *data = NULL;
+        if (read_stdin(&data, &input_bytes) != 0) {
+            fprintf(stderr, "Error: Failed to read stdin\n");
+            return 1;
+        }
+        result = rdt_entropy_assess(data, input_bytes, &cfg, &report);
+        free(data);
+    } else {
+        struct stat st;
+        if (stat(input, &st) == 0) input_bytes = (size_t)st.st_size;
+        result = rdt_entropy_assess_file(input, &cfg, &report);
+    }
+    if (result != 0) {
+        fprintf(stderr, "Error: Failed to assess %s (need at least 2 samples)\n", input);
+        return 1;
+    }
+
+    printf("{\n  \"input\": ");
+    print_json_string(input);
+    printf(",\n");
+    printf("  \"input_bytes\": %zu,\n", input_bytes);
+    printf("  \"samples\": %zu,\n", report.samples);
+    printf("  \"bits_per_symbol\": %u,\n", report.bits_per_symbol);
+    printf("  \"tuple_samples\": %zu,\n", report.tuple_samples);
+    printf("  \"bitstring_bits\": %zu,\n", report.bitstring_bits);
+    print_estimates("original", report.original, 0);
+    print_estimates("bitstring", report.bitstring, 0);
+    print_value("h_original", report.h_original, 0);
+    print_value("h_bitstring", report.h_bitstring, 0);
+    print_value("min_entropy", report.min_entropy, 1);
+    printf("}\n");
+
+    if (require >= 0.0 && report.min_entropy < require) {
+        fprintf(stderr, "min-entropy %.6f is below the required %.6f bits per sample\n",
+                report.min_entropy, require);
+        return 3;
+    }
+    return 0;
+}
+
+#endif /* RDT_ENTROPY_MAIN */
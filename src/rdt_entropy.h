@@ -0,0 +1,100 @@
+/*
+ * RDT Entropy Assessment
+ * ======================
+ * NIST SP 800-90B non-IID min-entropy estimators (section 6.3) for raw
+ * sensor captures, so inputs can be checked before seed extraction.
+ *
+ * Author: Steven Reid
+ * ORCID: 0009-0003-9132-3410
+ * License: MIT
+ */
+
+#ifndef RDT_ENTROPY_H
+#define RDT_ENTROPY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Estimator indices into rdt_entropy_report.original / .bitstring */
+#define RDT_ENTROPY_MCV 0u          /* 6.3.1  most common value */
+#define RDT_ENTROPY_COLLISION 1u    /* 6.3.2  binary only */
+#define RDT_ENTROPY_MARKOV 2u       /* 6.3.3  binary only */
+#define RDT_ENTROPY_COMPRESSION 3u  /* 6.3.4  binary only */
+#define RDT_ENTROPY_T_TUPLE 4u      /* 6.3.5 */
+#define RDT_ENTROPY_LRS 5u          /* 6.3.6  longest repeated substring */
+#define RDT_ENTROPY_MULTI_MCW 6u    /* 6.3.7 */
+#define RDT_ENTROPY_LAG 7u          /* 6.3.8 */
+#define RDT_ENTROPY_MULTI_MMC 8u    /* 6.3.9 */
+#define RDT_ENTROPY_LZ78Y 9u        /* 6.3.10 */
+#define RDT_ENTROPY_ESTIMATORS 10u
+
+/* Default sample limits for the estimators that are not single-pass */
+#define RDT_ENTROPY_TUPLE_SAMPLES 4194304u
+#define RDT_ENTROPY_BITSTRING_BITS 1000000u
+
+/*
+ * Every input byte is one sample; with bits_per_symbol < 8 only its low
+ * bits are used. Zero fields take the defaults.
+ *
+ *   max_samples     assess only the first max_samples samples
+ *   tuple_samples   samples seen by t-tuple and LRS, which build a suffix
+ *                   array (about 32 bytes per sample)
+ *   bitstring_bits  length of the bitstring (each sample's bits, most
+ *                   significant first) seen by the bitstring estimators
+ */
+typedef struct {
+    unsigned bits_per_symbol;
+    size_t max_samples;
+    size_t tuple_samples;
+    size_t bitstring_bits;
+} rdt_entropy_config;
+
+/*
+ * Estimates are min-entropy in bits per sample (original) and bits per bit
+ * (bitstring); a negative value means the estimator does not apply, e.g.
+ * the binary-only estimators on non-binary samples, or too little data.
+ *
+ * For binary samples min_entropy = h_original. Otherwise min_entropy =
+ * min(h_original, bits_per_symbol * h_bitstring), as in SP 800-90B 3.1.3.
+ */
+typedef struct {
+    unsigned bits_per_symbol;
+    size_t samples;
+    size_t tuple_samples;
+    size_t bitstring_bits;
+    double original[RDT_ENTROPY_ESTIMATORS];
+    double bitstring[RDT_ENTROPY_ESTIMATORS];
+    double h_original;
+    double h_bitstring;
+    double min_entropy;
+} rdt_entropy_report;
+
+void rdt_entropy_config_init(rdt_entropy_config *config);
+
+/*
+ * Run all estimators on data. Each estimator is one sequential pass and
+ * they run side by side on rdt_pool. Reports do not depend on the thread
+ * count. config may be NULL for the defaults.
+ *
+ * Returns 0 on success, -1 on error (bad arguments, empty input,
+ * allocation failure).
+ */
+int rdt_entropy_assess(const uint8_t *data, size_t len, const rdt_entropy_config *config,
+                       rdt_entropy_report *report);
+
+/* Same for a file, memory-mapped read-only. */
+int rdt_entropy_assess_file(const char *path, const rdt_entropy_config *config,
+                            rdt_entropy_report *report);
+
+/* Short snake_case name of an estimator index, e.g. "multi_mmc". */
+const char *rdt_entropy_estimator_name(unsigned estimator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RDT_ENTROPY_H */
@@ -0,0 +1,304 @@
+/*
+ * RDT Health Tests - C Implementation
+ * ===================================
+ * SP 800-90B 4.4.1 Repetition Count Test and 4.4.2 Adaptive Proportion
+ * Test over a stream of fixed-width samples.
+ *
+ * Author: Steven Reid
+ * ORCID: 0009-0003-9132-3410
+ * License: MIT
+ *
+ * Both tests only compare samples for equality, so 32 input bytes are
+ * tested at a time: the RCT compares the input with itself shifted by one
+ * sample and walks the runs in the equality mask, the APT compares against
+ * the window's reference sample and counts matches with popcount. Samples
+ * that straddle a window or call boundary go through the scalar step.
+ */
+
+#include "rdt_health.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* ========================================================================== */
+/* Cutoffs                                                                    */
+/* ========================================================================== */
+
+/*
+ * CRITBINOM(w, p, 1 - alpha): the smallest k with P(X <= k) >= 1 - alpha
+ * for X ~ Binomial(w, p). The upper tail is summed from the top so a tiny
+ * alpha does not cancel against a CDF near 1.
+ */
+static uint32_t critbinom(uint32_t w, double p, double alpha) {
+    double log_p = log(p);
+    double log_q = log1p(-p);
+    double tail = 0.0;
+
+    if (p >= 1.0) return w;
+    for (uint32_t k = w;; k--) {
+        double log_pmf = lgamma((double)w + 1.0) - lgamma((double)k + 1.0) -
+                         lgamma((double)(w - k) + 1.0) + (double)k * log_p + (double)(w - k) * log_q;
+        tail += exp(log_pmf);
+        if (tail > alpha || k == 0) return k;
+    }
+}
+
+int rdt_health_config_init(rdt_health_config *config, double min_entropy, unsigned sample_bytes,
+                           uint32_t apt_window) {
+    double alpha = ldexp(1.0, -(int)RDT_HEALTH_ALPHA_LOG2);
+    double rct;
+
+    if (!config) return -1;
+    if (sample_bytes != 1u && sample_bytes != 2u && sample_bytes != 4u && sample_bytes != 8u) return -1;
+    if (!(min_entropy > 0.0) || min_entropy > 8.0 * (double)sample_bytes) return -1;
+    if (apt_window == 0) apt_window = RDT_HEALTH_APT_WINDOW;
+    if (apt_window < 2u || apt_window > RDT_HEALTH_MAX_APT_WINDOW) return -1;
+
+    rct = 1.0 + ceil((double)RDT_HEALTH_ALPHA_LOG2 / min_entropy);
+    config->min_entropy = min_entropy;
+    config->sample_bytes = sample_bytes;
+    config->rct_cutoff = (rct >= (double)UINT32_MAX) ? UINT32_MAX : (uint32_t)rct;
+    config->apt_window = apt_window;
+    config->apt_cutoff = 1u + critbinom(apt_window, exp2(-min_entropy), alpha);
+    return 0;
+}
+
+/* ========================================================================== */
+/* Monitor                                                                    */
+/* ========================================================================== */
+
+int rdt_health_init(rdt_health *health, const rdt_health_config *config) {
+    unsigned w;
+
+    if (!health || !config) return -1;
+    w = config->sample_bytes;
+    if (w != 1u && w != 2u && w != 4u && w != 8u) return -1;
+    if (config->rct_cutoff < 2u || config->apt_cutoff < 2u) return -1;
+    if (config->apt_window < 2u || config->apt_window > RDT_HEALTH_MAX_APT_WINDOW) return -1;
+
+    memset(health, 0, sizeof(*health));
+    health->config = *config;
+    return 0;
+}
+
+void rdt_health_reset(rdt_health *health) {
+    rdt_health_config config;
+
+    if (!health) return;
+    config = health->config;
+    memset(health, 0, sizeof(*health));
+    health->config = config;
+}
+
+static uint64_t load_sample(const uint8_t *p, unsigned w) {
+    uint64_t v = 0;
+    for (unsigned j = 0; j < w; j++) {
+        v |= (uint64_t)p[j] << (8u * j);
+    }
+    return v;
+}
+
+/* The current run grew by n identical samples */
+static void rct_extend(rdt_health *h, uint64_t n) {
+    uint64_t before = h->rct_run;
+
+    h->rct_run += n;
+    if (before < h->config.rct_cutoff && h->rct_run >= h->config.rct_cutoff) {
+        h->rct_failures++;
+        h->failed = 1;
+    }
+}
+
+static void rct_step(rdt_health *h, uint64_t x) {
+    if (h->rct_run && x == h->last) {
+        rct_extend(h, 1u);
+    } else {
+        h->last = x;
+        h->rct_run = 0;
+        rct_extend(h, 1u);
+    }
+}
+
+/* m more samples of the current window, c of them equal to the reference */
+static void apt_advance(rdt_health *h, uint32_t m, uint32_t c) {
+    uint32_t before = h->apt_count;
+
+    h->apt_count += c;
+    if (before < h->config.apt_cutoff && h->apt_count >= h->config.apt_cutoff) {
+        h->apt_failures++;
+        h->failed = 1;
+    }
+    h->apt_seen += m;
+    if (h->apt_seen == h->config.apt_window) {
+        h->apt_windows++;
+        h->apt_seen = 0;
+    }
+}
+
+static void apt_step(rdt_health *h, uint64_t x) {
+    if (h->apt_seen == 0) {
+        h->apt_ref = x;
+        h->apt_count = 0;
+    }
+    apt_advance(h, 1u, (x == h->apt_ref) ? 1u : 0u);
+}
+
+#if defined(__AVX2__)
+/*
+ * Byte mask of equal samples: each sample sets all or none of its w bits,
+ * so runs and counts in the mask are w times those in samples.
+ */
+static inline uint32_t eq_mask(__m256i a, __m256i b, unsigned w) {
+    __m256i e;
+    switch (w) {
+        case 1:  e = _mm256_cmpeq_epi8(a, b); break;
+        case 2:  e = _mm256_cmpeq_epi16(a, b); break;
+        case 4:  e = _mm256_cmpeq_epi32(a, b); break;
+        default: e = _mm256_cmpeq_epi64(a, b); break;
+    }
+    return (uint32_t)_mm256_movemask_epi8(e);
+}
+
+static inline __m256i broadcast_sample(uint64_t x, unsigned w) {
+    switch (w) {
+        case 1:  return _mm256_set1_epi8((char)(uint8_t)x);
+        case 2:  return _mm256_set1_epi16((short)(uint16_t)x);
+        case 4:  return _mm256_set1_epi32((int)(uint32_t)x);
+        default: return _mm256_set1_epi64x((long long)x);
+    }
+}
+
+/* Number of distinct runs of at least need consecutive ones in m */
+static unsigned long_runs(uint32_t m, unsigned need) {
+    for (unsigned have = 1; have < need && m;) {
+        unsigned s = (need - have < have) ? need - have : have;
+        m &= m >> s;
+        have += s;
+    }
+    return (unsigned)__builtin_popcount(m & ~(m << 1));
+}
+
+/*
+ * RCT over samples [1, n) of p; sample 0 has been through rct_step. Each
+ * chunk compares 32 bytes with the same bytes one sample earlier.
+ */
+static size_t rct_block(rdt_health *h, const uint8_t *p, size_t n, unsigned w) {
+    size_t end = n * w;
+    size_t b = w;
+    uint64_t need_bits = ((uint64_t)h->config.rct_cutoff - 1u) * w;
+
+    for (; b + 32u <= end; b += 32u) {
+        uint32_t eq = eq_mask(_mm256_loadu_si256((const __m256i *)(p + b)),
+                              _mm256_loadu_si256((const __m256i *)(p + b - w)), w);
+        unsigned lead, top;
+        uint32_t mid;
+
+        if (eq == 0xFFFFFFFFu) {
+            rct_extend(h, 32u / w);
+            continue;
+        }
+        lead = (unsigned)__builtin_ctz(~eq);
+        top = (unsigned)__builtin_clz(~eq);
+        rct_extend(h, lead / w);
+
+        mid = eq & ~((lead ? 0xFFFFFFFFu >> (32u - lead) : 0u) | (top ? 0xFFFFFFFFu << (32u - top) : 0u));
+        if (mid && need_bits <= 32u) {
+            unsigned runs = long_runs(mid, (unsigned)need_bits);
+            if (runs) {
+                h->rct_failures += runs;
+                h->failed = 1;
+            }
+        }
+
+        h->rct_run = 0;
+        rct_extend(h, 1u + top / w);
+        h->last = load_sample(p + b + 32u - w, w);
+    }
+    return b / w;
+}
+
+/* Count samples equal to ref among m samples at p */
+static uint32_t apt_count_block(const uint8_t *p, uint32_t m, uint64_t ref, unsigned w) {
+    __m256i want = broadcast_sample(ref, w);
+    size_t bytes = (size_t)m * w;
+    size_t b = 0;
+    uint32_t c = 0;
+
+    for (; b + 32u <= bytes; b += 32u) {
+        c += (uint32_t)__builtin_popcount(eq_mask(_mm256_loadu_si256((const __m256i *)(p + b)), want, w));
+    }
+    c /= w;
+    for (; b < bytes; b += w) {
+        c += (load_sample(p + b, w) == ref) ? 1u : 0u;
+    }
+    return c;
+}
+#endif
+
+/* n whole samples at p */
+static void test_samples(rdt_health *h, const uint8_t *p, size_t n, unsigned w) {
+    size_t i = 0;
+
+    if (!n) return;
+    h->samples += n;
+
+#if defined(__AVX2__)
+    rct_step(h, load_sample(p, w));
+    i = rct_block(h, p, n, w);
+    for (; i < n; i++) {
+        rct_step(h, load_sample(p + i * w, w));
+    }
+
+    for (i = 0; i < n;) {
+        uint32_t m;
+
+        if (h->apt_seen == 0) {
+            apt_step(h, load_sample(p + i * w, w));
+            i++;
+            continue;
+        }
+        m = h->config.apt_window - h->apt_seen;
+        if ((size_t)m > n - i) m = (uint32_t)(n - i);
+        apt_advance(h, m, apt_count_block(p + i * w, m, h->apt_ref, w));
+        i += m;
+    }
+#else
+    for (; i < n; i++) {
+        uint64_t x = load_sample(p + i * w, w);
+        rct_step(h, x);
+        apt_step(h, x);
+    }
+#endif
+}
+
+int rdt_health_feed(rdt_health *health, const uint8_t *data, size_t len) {
+    unsigned w;
+    size_t whole;
+
+    if (!health || (!data && len)) return -1;
+    w = health->config.sample_bytes;
+
+    if (health->partial_len) {
+        size_t take = w - health->partial_len;
+        if (take > len) take = len;
+        memcpy(health->partial + health->partial_len, data, take);
+        health->partial_len += (unsigned)take;
+        data += take;
+        len -= take;
+        if (health->partial_len == w) {
+            test_samples(health, health->partial, 1u, w);
+            health->partial_len = 0;
+        }
+    }
+
+    whole = len / w;
+    test_samples(health, data, whole, w);
+    if (len % w) {
+        memcpy(health->partial, data + whole * w, len % w);
+        health->partial_len = (unsigned)(len % w);
+    }
+    return health->failed ? RDT_HEALTH_FAILED : 0;
+}
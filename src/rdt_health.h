@@ -0,0 +1,112 @@
+/*
+ * RDT Health Tests
+ * ================
+ * Continuous NIST SP 800-90B (section 4.4) health tests for raw noise
+ * samples: the Repetition Count Test and the Adaptive Proportion Test.
+ * A monitor is fed the sample stream as it is ingested, in pieces of any
+ * size, and latches a failure that callers use to refuse seed or reseed
+ * output.
+ *
+ * Author: Steven Reid
+ * ORCID: 0009-0003-9132-3410
+ * License: MIT
+ */
+
+#ifndef RDT_HEALTH_H
+#define RDT_HEALTH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returned by rdt_health_feed once a test has failed */
+#define RDT_HEALTH_FAILED (-2)
+
+/* False-positive probability of each test: alpha = 2^-RDT_HEALTH_ALPHA_LOG2 */
+#define RDT_HEALTH_ALPHA_LOG2 20u
+#define RDT_HEALTH_APT_WINDOW 512u          /* non-binary sources */
+#define RDT_HEALTH_APT_WINDOW_BINARY 1024u  /* one-bit sources */
+#define RDT_HEALTH_MAX_APT_WINDOW 65536u
+
+/*
+ * Cutoffs for one noise source. Samples are sample_bytes wide (1, 2, 4 or
+ * 8, little-endian) and compared for equality only.
+ *
+ *   rct_cutoff   C in 4.4.1: C identical samples in a row fail
+ *   apt_window   W in 4.4.2: samples per window
+ *   apt_cutoff   C in 4.4.2: the window's first sample occurring C times
+ *                within the window fails
+ *
+ * rdt_health_config_init derives the cutoffs from the claimed min-entropy
+ * per sample; any of them may be overridden afterwards.
+ */
+typedef struct {
+    double min_entropy;
+    unsigned sample_bytes;
+    uint32_t rct_cutoff;
+    uint32_t apt_window;
+    uint32_t apt_cutoff;
+} rdt_health_config;
+
+/*
+ * Fill config for a source with min-entropy H bits per sample (0 < H <=
+ * 8 * sample_bytes): rct_cutoff = 1 + ceil(20 / H) and apt_cutoff =
+ * 1 + CRITBINOM(W, 2^-H, 1 - 2^-20). apt_window is W, or 0 for
+ * RDT_HEALTH_APT_WINDOW; SP 800-90B uses RDT_HEALTH_APT_WINDOW_BINARY for
+ * one-bit sources.
+ *
+ * Returns 0 on success, -1 on bad arguments.
+ */
+int rdt_health_config_init(rdt_health_config *config, double min_entropy, unsigned sample_bytes,
+                           uint32_t apt_window);
+
+/*
+ * Monitor state and counters. Counters keep running after a failure;
+ * failed stays set until rdt_health_reset.
+ *
+ *   samples        samples tested
+ *   rct_failures   runs that reached rct_cutoff
+ *   apt_windows    completed APT windows
+ *   apt_failures   windows whose count reached apt_cutoff
+ */
+typedef struct {
+    rdt_health_config config;
+    uint64_t samples;
+    uint64_t rct_failures;
+    uint64_t apt_windows;
+    uint64_t apt_failures;
+    int failed;
+
+    /* internal */
+    uint64_t last;
+    uint64_t rct_run;
+    uint64_t apt_ref;
+    uint32_t apt_seen;
+    uint32_t apt_count;
+    uint8_t partial[8];
+    unsigned partial_len;
+} rdt_health;
+
+/* Returns 0 on success, -1 on bad arguments or an invalid config. */
+int rdt_health_init(rdt_health *health, const rdt_health_config *config);
+
+/* Clear the failure, the counters and all test state; keeps the config. */
+void rdt_health_reset(rdt_health *health);
+
+/*
+ * Test the next len bytes of the sample stream. A sample split across
+ * calls is tested once it is complete.
+ *
+ * Returns 0 while every test has passed, RDT_HEALTH_FAILED once one has
+ * failed (including in an earlier call), -1 on bad arguments.
+ */
+int rdt_health_feed(rdt_health *health, const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RDT_HEALTH_H */
@@ -0,0 +1,177 @@
+#include "rdt_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define RDT_POOL_MAX_THREADS 64u
+
+/*
+ * run_lock is held for the whole of a parallel job; state_lock guards the
+ * rest. n_wanted is written under both, so rdt_pool_threads() only needs
+ * state_lock and can be called from inside a task.
+ */
+static pthread_mutex_t run_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t state_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_cv = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done_cv = PTHREAD_COND_INITIALIZER;
+
+static pthread_t helpers[RDT_POOL_MAX_THREADS];
+static unsigned n_helpers = 0;
+static unsigned n_wanted = 0;      /* 0 = online CPUs */
+static unsigned long generation = 0;
+static unsigned busy = 0;
+static int stopping = 0;
+static atomic_int running = 0;     /* a job holds run_lock */
+
+static rdt_pool_task_fn job_fn;
+static void *job_arg;
+static size_t job_count;
+static atomic_size_t job_next;
+
+static void drain(void) {
+    size_t i;
+    while ((i = atomic_fetch_add(&job_next, 1u)) < job_count) {
+        job_fn(job_arg, i);
+    }
+}
+
+static void *helper_main(void *start_generation) {
+    unsigned long seen = (unsigned long)(uintptr_t)start_generation;
+
+    pthread_mutex_lock(&state_lock);
+    for (;;) {
+        while (!stopping && generation == seen) {
+            pthread_cond_wait(&work_cv, &state_lock);
+        }
+        if (stopping) {
+            break;
+        }
+        seen = generation;
+        pthread_mutex_unlock(&state_lock);
+
+        drain();
+
+        pthread_mutex_lock(&state_lock);
+        if (--busy == 0) {
+            pthread_cond_signal(&done_cv);
+        }
+    }
+    pthread_mutex_unlock(&state_lock);
+    return NULL;
+}
+
+static unsigned wanted_threads(void) {
+    long online;
+
+    if (n_wanted) {
+        return n_wanted;
+    }
+    online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online < 1) {
+        return 1u;
+    }
+    return (online > (long)RDT_POOL_MAX_THREADS) ? RDT_POOL_MAX_THREADS : (unsigned)online;
+}
+
+/* Caller holds run_lock. */
+static void start_helpers(void) {
+    unsigned target = wanted_threads() - 1u;
+
+    while (n_helpers < target) {
+        if (pthread_create(&helpers[n_helpers], NULL, helper_main,
+                           (void *)(uintptr_t)generation) != 0) {
+            break;
+        }
+        n_helpers++;
+    }
+}
+
+/* Caller holds run_lock. */
+static void stop_helpers(void) {
+    unsigned i;
+
+    pthread_mutex_lock(&state_lock);
+    stopping = 1;
+    pthread_cond_broadcast(&work_cv);
+    pthread_mutex_unlock(&state_lock);
+
+    for (i = 0; i < n_helpers; i++) {
+        pthread_join(helpers[i], NULL);
+    }
+    n_helpers = 0;
+    stopping = 0;
+}
+
+void rdt_pool_run(size_t count, rdt_pool_task_fn fn, void *arg) {
+    size_t i;
+
+    if (!fn || !count) {
+        return;
+    }
+    if (count == 1u || pthread_mutex_trylock(&run_lock) != 0) {
+        for (i = 0; i < count; i++) {
+            fn(arg, i);
+        }
+        return;
+    }
+
+    start_helpers();
+    if (!n_helpers) {
+        pthread_mutex_unlock(&run_lock);
+        for (i = 0; i < count; i++) {
+            fn(arg, i);
+        }
+        return;
+    }
+
+    atomic_store(&running, 1);
+    pthread_mutex_lock(&state_lock);
+    job_fn = fn;
+    job_arg = arg;
+    job_count = count;
+    atomic_store(&job_next, 0u);
+    busy = n_helpers;
+    generation++;
+    pthread_cond_broadcast(&work_cv);
+    pthread_mutex_unlock(&state_lock);
+
+    drain();
+
+    pthread_mutex_lock(&state_lock);
+    while (busy) {
+        pthread_cond_wait(&done_cv, &state_lock);
+    }
+    pthread_mutex_unlock(&state_lock);
+
+    atomic_store(&running, 0);
+    pthread_mutex_unlock(&run_lock);
+}
+
+void rdt_pool_set_threads(unsigned threads) {
+    pthread_mutex_lock(&run_lock);
+    if (threads > RDT_POOL_MAX_THREADS) {
+        threads = RDT_POOL_MAX_THREADS;
+    }
+    if (threads != n_wanted) {
+        stop_helpers();
+        pthread_mutex_lock(&state_lock);
+        n_wanted = threads;
+        pthread_mutex_unlock(&state_lock);
+    }
+    pthread_mutex_unlock(&run_lock);
+}
+
+unsigned rdt_pool_threads(void) {
+    unsigned n;
+
+    pthread_mutex_lock(&state_lock);
+    n = wanted_threads();
+    pthread_mutex_unlock(&state_lock);
+    return n;
+}
+
+int rdt_pool_idle(void) {
+    return !atomic_load(&running) && rdt_pool_threads() > 1u;
+}
@@ -0,0 +1,42 @@
+#ifndef RDT_POOL_H
+#define RDT_POOL_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+Process-wide fork-join worker pool.
+
+rdt_pool_run() calls fn(arg, i) for every i in [0, count) and returns once all
+calls have finished. The calling thread takes part in the work; helper threads
+are started lazily on first use and then kept. Tasks are handed out in no
+particular order, so they must write to disjoint memory.
+
+Only one job runs on the pool at a time. A call made while the pool is busy
+(from another thread, or from inside a task) simply runs its tasks serially on
+the caller, so rdt_pool_run() never blocks on another job and never deadlocks.
+*/
+typedef void (*rdt_pool_task_fn)(void *arg, size_t index);
+
+void rdt_pool_run(size_t count, rdt_pool_task_fn fn, void *arg);
+
+/* Total thread count including the caller; 0 restores the online CPU count. */
+void rdt_pool_set_threads(unsigned threads);
+unsigned rdt_pool_threads(void);
+
+/*
+Nonzero if a job started now would actually run in parallel: the pool has
+more than one thread and no job is in progress. Inside a task it is always 0.
+The answer may be stale by the time it is used, so it only serves to pick
+between a parallel and a serial algorithm that give the same result.
+*/
+int rdt_pool_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RDT_POOL_H */
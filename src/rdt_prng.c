@@ -1,5 +1,6 @@
 #include "rdt.h"
 #include "rdt_core.h"
+#include "rdt_stats.h"
 #include <stdint.h>
 
 static uint64_t S[4];
@@ -24,6 +25,7 @@ uint64_t rdt_prng_next(void)
     S[1] ^= rdt_mix(S[2], K);
     S[2] ^= rdt_mix(S[3], K);
     S[3] ^= rdt_mix(S[0], K);
+    RDT_STATS_ADD(RDT_STAT_PRNG_BYTES, 8);
 
     return S[0];
 }
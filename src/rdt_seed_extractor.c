@@ -15,285 +15,336 @@
  *   5. SHA-256 finalization with domain separation
  *
  * Compile:
- *   gcc -O3 -o rdt_seed_extractor rdt_seed_extractor.c -lm
+ *   gcc -O3 -pthread -DRDT_SEED_EXTRACTOR_MAIN -o rdt_seed_extractor \
+ *       rdt_seed_extractor.c rdt_pool.c rdt_health.c rdt_sha256.c -lm
  */
 
+#define _DEFAULT_SOURCE
 #include "rdt_seed_extractor.h"
+#include "rdt_pool.h"
+#include "rdt_sha256.h"
+#include "rdt_stats.h"
+#include <fcntl.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
+#include <errno.h>
+#include <float.h>
+#include <pthread.h>
 #include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /* ========================================================================== */
-/* SHA-256 Implementation (minimal, self-contained)                           */
+/* Mixer Functions (Steven Reid's design)                                     */
 /* ========================================================================== */
 
-typedef struct {
-    uint32_t state[8];
-    uint64_t count;
-    uint8_t buffer[64];
-} sha256_ctx;
-
-static const uint32_t sha256_k[64] = {
-    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
-    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
-    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
-    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
-    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
-    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
-    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
-    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-};
-
-#define ROR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
-#define CH(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
-#define MAJ(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
-#define EP0(x) (ROR32(x, 2) ^ ROR32(x, 13) ^ ROR32(x, 22))
-#define EP1(x) (ROR32(x, 6) ^ ROR32(x, 11) ^ ROR32(x, 25))
-#define SIG0(x) (ROR32(x, 7) ^ ROR32(x, 18) ^ ((x) >> 3))
-#define SIG1(x) (ROR32(x, 17) ^ ROR32(x, 19) ^ ((x) >> 10))
-
-static void sha256_transform(sha256_ctx *ctx, const uint8_t data[64]) {
-    uint32_t a, b, c, d, e, f, g, h, t1, t2, m[64];
-    int i;
-
-    for (i = 0; i < 16; i++) {
-        m[i] = ((uint32_t)data[i * 4] << 24) |
-               ((uint32_t)data[i * 4 + 1] << 16) |
-               ((uint32_t)data[i * 4 + 2] << 8) |
-               ((uint32_t)data[i * 4 + 3]);
-    }
-    for (; i < 64; i++) {
-        m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
-    }
-
-    a = ctx->state[0]; b = ctx->state[1];
-    c = ctx->state[2]; d = ctx->state[3];
-    e = ctx->state[4]; f = ctx->state[5];
-    g = ctx->state[6]; h = ctx->state[7];
-
-    for (i = 0; i < 64; i++) {
-        t1 = h + EP1(e) + CH(e, f, g) + sha256_k[i] + m[i];
-        t2 = EP0(a) + MAJ(a, b, c);
-        h = g; g = f; f = e; e = d + t1;
-        d = c; c = b; b = a; a = t1 + t2;
-    }
-
-    ctx->state[0] += a; ctx->state[1] += b;
-    ctx->state[2] += c; ctx->state[3] += d;
-    ctx->state[4] += e; ctx->state[5] += f;
-    ctx->state[6] += g; ctx->state[7] += h;
-}
-
-static void sha256_init(sha256_ctx *ctx) {
-    ctx->state[0] = 0x6a09e667;
-    ctx->state[1] = 0xbb67ae85;
-    ctx->state[2] = 0x3c6ef372;
-    ctx->state[3] = 0xa54ff53a;
-    ctx->state[4] = 0x510e527f;
-    ctx->state[5] = 0x9b05688c;
-    ctx->state[6] = 0x1f83d9ab;
-    ctx->state[7] = 0x5be0cd19;
-    ctx->count = 0;
-}
-
-static void sha256_update(sha256_ctx *ctx, const uint8_t *data, size_t len) {
-    size_t i = 0;
-    size_t idx = (size_t)(ctx->count & 63);
-    ctx->count += len;
-
-    if (idx) {
-        size_t left = 64 - idx;
-        if (len < left) {
-            memcpy(ctx->buffer + idx, data, len);
-            return;
-        }
-        memcpy(ctx->buffer + idx, data, left);
-        sha256_transform(ctx, ctx->buffer);
-        i = left;
-    }
-
-    for (; i + 64 <= len; i += 64) {
-        sha256_transform(ctx, data + i);
-    }
-
-    if (i < len) {
-        memcpy(ctx->buffer, data + i, len - i);
-    }
+/*
+ * The mixers are written as split-range kernels: each output range reads its
+ * inputs at fixed offsets, so there is no per-byte index arithmetic and the
+ * bulk runs 32 (AVX2) or 8 (bswap) bytes at a time.
+ */
+#if defined(__AVX2__)
+static inline __m256i reverse_bytes32(__m256i v) {
+    const __m256i rev = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                         15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, rev), 0x4E);
 }
-
-static void sha256_final(sha256_ctx *ctx, uint8_t hash[32]) {
-    size_t idx = (size_t)(ctx->count & 63);
-    ctx->buffer[idx++] = 0x80;
-
-    if (idx > 56) {
-        memset(ctx->buffer + idx, 0, 64 - idx);
-        sha256_transform(ctx, ctx->buffer);
-        idx = 0;
+#endif
+
+/* dst[k] = a[k] ^ b[k] ^ r[-k] ^ invert for k in [0, n); r is read backwards */
+static void xor3_reversed(uint8_t *dst, const uint8_t *a, const uint8_t *b,
+                          const uint8_t *r, size_t n, uint8_t invert) {
+    size_t k = 0;
+
+#if defined(__AVX2__)
+    const __m256i inv = _mm256_set1_epi8((char)invert);
+    for (; k + 32u <= n; k += 32u) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(const void *)(a + k));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(const void *)(b + k));
+        __m256i vr = _mm256_loadu_si256((const __m256i *)(const void *)(r - k - 31u));
+        __m256i v = _mm256_xor_si256(_mm256_xor_si256(va, vb),
+                                     _mm256_xor_si256(reverse_bytes32(vr), inv));
+        _mm256_storeu_si256((__m256i *)(void *)(dst + k), v);
     }
-    memset(ctx->buffer + idx, 0, 56 - idx);
-
-    uint64_t bits = ctx->count * 8;
-    for (int i = 0; i < 8; i++) {
-        ctx->buffer[63 - i] = (uint8_t)(bits >> (i * 8));
+#endif
+    {
+        const uint64_t inv64 = 0x0101010101010101ULL * invert;
+        for (; k + 8u <= n; k += 8u) {
+            uint64_t va, vb, vr;
+            memcpy(&va, a + k, 8);
+            memcpy(&vb, b + k, 8);
+            memcpy(&vr, r - k - 7u, 8);
+            va ^= vb ^ __builtin_bswap64(vr) ^ inv64;
+            memcpy(dst + k, &va, 8);
+        }
     }
-    sha256_transform(ctx, ctx->buffer);
-
-    for (int i = 0; i < 8; i++) {
-        hash[i * 4] = (uint8_t)(ctx->state[i] >> 24);
-        hash[i * 4 + 1] = (uint8_t)(ctx->state[i] >> 16);
-        hash[i * 4 + 2] = (uint8_t)(ctx->state[i] >> 8);
-        hash[i * 4 + 3] = (uint8_t)(ctx->state[i]);
+    for (; k < n; k++) {
+        dst[k] = (uint8_t)(a[k] ^ b[k] ^ *(r - k) ^ invert);
     }
 }
 
-static void sha256(const uint8_t *data, size_t len, uint8_t hash[32]) {
-    sha256_ctx ctx;
-    sha256_init(&ctx);
-    sha256_update(&ctx, data, len);
-    sha256_final(&ctx, hash);
-}
-
-/* ========================================================================== */
-/* Mixer Functions (Steven Reid's design)                                     */
-/* ========================================================================== */
-
 /*
  * mixer_a: Roll + Invert + XOR mixing
- * result[i] = roll(data,3)[i] XOR ~data[i] XOR data[len-1-i]
+ * dst[i] = roll(src,3)[i] XOR ~src[i] XOR src[len-1-i], for i in [lo, hi)
  */
-static void mixer_a_with_temp(uint8_t *data, size_t len, uint8_t *temp) {
-    if (len == 0) return;
-
-    for (size_t i = 0; i < len; i++) {
-        size_t roll_idx = (i + len - 3) % len;  /* roll by 3 */
-        uint8_t rolled = data[roll_idx];
-        uint8_t flipped = ~data[i];
-        uint8_t reversed = data[len - 1 - i];
-        temp[i] = rolled ^ flipped ^ reversed;
+static void mixer_a_part(uint8_t *dst, const uint8_t *src, size_t len, size_t lo, size_t hi) {
+    size_t i = lo;
+
+    if (len < 3) {
+        for (; i < hi; i++) {
+            size_t roll_idx = i + 3u * len - 3u;  /* roll by 3, len < 3 */
+            while (roll_idx >= len) roll_idx -= len;
+            dst[i] = (uint8_t)(src[roll_idx] ^ (uint8_t)~src[i] ^ src[len - 1 - i]);
+        }
+        return;
+    }
+    for (; i < hi && i < 3; i++) {
+        dst[i] = (uint8_t)(src[len - 3 + i] ^ (uint8_t)~src[i] ^ src[len - 1 - i]);
+    }
+    if (i < hi) {
+        xor3_reversed(dst + i, src + i, src + i - 3, src + len - 1 - i, hi - i, 0xFF);
     }
-
-    memcpy(data, temp, len);
 }
 
 /*
- * mixer_b: Half-swap + Reverse XOR mixing
+ * mixer_b: Half-swap + Reverse XOR mixing, for i in [lo, hi)
+ * Odd lengths act as if a zero byte were appended; dst gets the first len bytes.
  */
-static void mixer_b_with_temp(uint8_t *data, size_t len, uint8_t *temp, uint8_t *scratch) {
-    if (len < 2) return;
-
-    /* Ensure even length */
-    size_t work_len = len;
-    uint8_t *work = data;
+static void mixer_b_part(uint8_t *dst, const uint8_t *src, size_t len, size_t lo, size_t hi) {
+    size_t i = lo;
 
-    if (len % 2 != 0) {
-        work_len = len + 1;
-        memcpy(scratch, data, len);
-        scratch[len] = 0;
-        work = scratch;
+    if (len < 2) {
+        if (lo < hi) dst[0] = src[0];
+        return;
     }
 
-    size_t half = work_len / 2;
-
-    for (size_t i = 0; i < work_len; i++) {
-        /* overlay: swap halves */
-        uint8_t overlay;
+    if (len % 2 == 0) {
+        /* dst[i] = src[len-1-i] ^ src[i +/- half] ^ src[i] */
+        size_t half = len / 2;
         if (i < half) {
-            overlay = work[half + i];
-        } else {
-            overlay = work[i - half];
+            size_t end = (hi < half) ? hi : half;
+            xor3_reversed(dst + i, src + i, src + i + half, src + len - 1 - i, end - i, 0);
+            i = end;
+        }
+        if (i < hi) {
+            xor3_reversed(dst + i, src + i, src + i - half, src + len - 1 - i, hi - i, 0);
         }
+        return;
+    }
 
-        /* reverse XOR overlay XOR original */
-        uint8_t reversed = work[work_len - 1 - i];
-        temp[i] = (reversed ^ overlay) ^ work[i];
+    /* Odd: work = src || 0, so index len reads as zero (i = 0 and i = half - 1) */
+    size_t half = (len + 1) / 2;
+    while (i < hi && i < half) {
+        if (i == 0) {
+            dst[0] = (uint8_t)(src[half] ^ src[0]);
+            i++;
+        } else if (i == half - 1) {
+            dst[i] = (uint8_t)(src[len - i] ^ src[i]);
+            i++;
+        } else {
+            size_t end = (hi < half - 1) ? hi : half - 1;
+            xor3_reversed(dst + i, src + i, src + i + half, src + len - i, end - i, 0);
+            i = end;
+        }
     }
+    if (i < hi) {
+        xor3_reversed(dst + i, src + i, src + i - half, src + len - i, hi - i, 0);
+    }
+}
+
+static void mixer_a(uint8_t *dst, const uint8_t *src, size_t len) {
+    mixer_a_part(dst, src, len, 0, len);
+}
 
-    memcpy(data, temp, len);
+static void mixer_b(uint8_t *dst, const uint8_t *src, size_t len) {
+    mixer_b_part(dst, src, len, 0, len);
 }
 
 /*
  * entropy_precursor_layer: Block-wise flip + shift
+ *
+ * Within a block, out[j] = ~in[j] ^ s[j] where s[j] = out[j-5] for j >= 5 and
+ * the block's original tail in[block_size-5+j] (zero past the chunk) for
+ * j < 5. That is a stride-5 prefix XOR, done in place 16 bytes at a time.
  */
-static int entropy_precursor_layer(uint8_t *data, size_t len, size_t block_size) {
-    if (len == 0 || block_size == 0) return 0;
-
-    uint8_t *block_temp = (uint8_t *)malloc(block_size);
-    if (!block_temp) return -1;
+static void entropy_precursor_layer(uint8_t *data, size_t len, size_t block_size) {
+    if (len == 0 || block_size == 0) return;
 
     for (size_t i = 0; i < len; i += block_size) {
         size_t chunk = (i + block_size <= len) ? block_size : (len - i);
+        uint8_t *blk = data + i;
+        uint8_t head[5] = {0};
+        size_t j = 0;
+
+        if (block_size < 10) {
+            /* tail and head overlap; keep the plain in-place recurrence */
+            uint8_t orig[10];
+            memcpy(orig, blk, chunk);
+            for (j = 0; j < chunk; j++) {
+                size_t shift_idx = (j + block_size - 5) % block_size;
+                uint8_t shifted = (shift_idx < chunk) ? blk[shift_idx] : 0;
+                blk[j] = (uint8_t)((uint8_t)~orig[j] ^ shifted);
+            }
+            continue;
+        }
 
-        /* Copy block, pad with zeros if needed */
-        memset(block_temp, 0, block_size);
-        memcpy(block_temp, data + i, chunk);
+        for (size_t h = 0; h < 5; h++) {
+            if (block_size - 5 + h < chunk) head[h] = blk[block_size - 5 + h];
+        }
 
-        /* Apply: flipped XOR shifted(5) */
-        for (size_t j = 0; j < chunk; j++) {
-            size_t shift_idx = (j + block_size - 5) % block_size;
-            uint8_t flipped = ~block_temp[j];
-            uint8_t shifted = (shift_idx < chunk) ? data[i + shift_idx] : 0;
-            data[i + j] = flipped ^ shifted;
+#if defined(__SSE2__)
+        {
+            __m128i carry;
+            uint8_t head16[16] = {0};
+
+            memcpy(head16, head, 5);
+            carry = _mm_loadu_si128((const __m128i *)(const void *)head16);
+            for (; j + 16u <= chunk; j += 16u) {
+                __m128i x = _mm_loadu_si128((const __m128i *)(const void *)(blk + j));
+                x = _mm_xor_si128(_mm_xor_si128(x, _mm_set1_epi8((char)0xFF)), carry);
+                x = _mm_xor_si128(x, _mm_slli_si128(x, 5));
+                x = _mm_xor_si128(x, _mm_slli_si128(x, 10));
+                _mm_storeu_si128((__m128i *)(void *)(blk + j), x);
+                carry = _mm_srli_si128(x, 11);
+            }
+        }
+#endif
+        for (; j < chunk; j++) {
+            uint8_t shifted = (j >= 5) ? blk[j - 5] : head[j];
+            blk[j] = (uint8_t)((uint8_t)~blk[j] ^ shifted);
         }
     }
-
-    free(block_temp);
-    return 0;
 }
 
 /*
  * recursive_entropy_mixer: Divide-and-conquer mixing
+ * Each mixer writes into the other buffer, so a leaf or combine step is
+ * data -> temp -> data with no copies.
  */
-static void recursive_entropy_mixer_impl(uint8_t *data, size_t len, int depth,
-                                         uint8_t *temp, uint8_t *scratch) {
+static void recursive_entropy_mixer_impl(uint8_t *data, size_t len, int depth, uint8_t *temp) {
     if (depth == 0 || len < 64) {
-        mixer_a_with_temp(data, len, temp);
-        mixer_b_with_temp(data, len, temp, scratch);
+        mixer_a(temp, data, len);
+        mixer_b(data, temp, len);
         return;
     }
 
     size_t mid = len / 2;
 
     /* Recurse on halves */
-    recursive_entropy_mixer_impl(data, mid, depth - 1, temp, scratch);
-    recursive_entropy_mixer_impl(data + mid, len - mid, depth - 1, temp, scratch);
+    recursive_entropy_mixer_impl(data, mid, depth - 1, temp);
+    recursive_entropy_mixer_impl(data + mid, len - mid, depth - 1, temp);
 
     /* Combine */
-    mixer_b_with_temp(data, len, temp, scratch);
-    mixer_a_with_temp(data, len, temp);
+    mixer_b(temp, data, len);
+    mixer_a(data, temp, len);
 }
 
-static int recursive_entropy_mixer(uint8_t *data, size_t len, int max_depth) {
-    uint8_t *temp;
-    uint8_t *scratch;
+/*
+ * Large pools run the same tree level by level on rdt_pool. The nodes of a
+ * level are disjoint, and every mixer output byte depends only on the
+ * node's input, so a level's mixer_a (or mixer_b) pass is split into slices
+ * of at most MIXER_SLICE_BYTES across all of its nodes, writing to the same
+ * offsets of temp. Leaves are mixed a then b and inner nodes b then a, as in
+ * the serial recursion, so the output is identical. This only pays while
+ * the pool is idle: from inside a batch or tree task every level would run
+ * serially on the caller, about a third slower than the plain recursion.
+ */
+#define MIXER_PARALLEL_MIN_BYTES (1024u * 1024u)
+#define MIXER_SLICE_BYTES (128u * 1024u)
+#define MIXER_MAX_PARALLEL_DEPTH 8
+
+typedef struct {
+    uint8_t *dst;
+    const uint8_t *src;
+    int use_b;
+    size_t n_nodes;
+    const size_t *bounds;           /* node k is [bounds[k], bounds[k + 1]) */
+    size_t first_task[(1u << MIXER_MAX_PARALLEL_DEPTH) + 1u];
+} mixer_level_job;
+
+static void mixer_level_task(void *arg, size_t index) {
+    const mixer_level_job *job = (const mixer_level_job *)arg;
+    size_t k = 0;
+
+    while (index >= job->first_task[k + 1]) k++;
+
+    size_t off = job->bounds[k];
+    size_t len = job->bounds[k + 1] - off;
+    size_t lo = (index - job->first_task[k]) * MIXER_SLICE_BYTES;
+    size_t hi = (len - lo > MIXER_SLICE_BYTES) ? lo + MIXER_SLICE_BYTES : len;
+
+    if (job->use_b) {
+        mixer_b_part(job->dst + off, job->src + off, len, lo, hi);
+    } else {
+        mixer_a_part(job->dst + off, job->src + off, len, lo, hi);
+    }
+}
+
+static void mixer_level_pass(uint8_t *dst, const uint8_t *src, const size_t *bounds,
+                             size_t n_nodes, int use_b) {
+    mixer_level_job job;
+
+    job.dst = dst;
+    job.src = src;
+    job.use_b = use_b;
+    job.n_nodes = n_nodes;
+    job.bounds = bounds;
+    job.first_task[0] = 0;
+    for (size_t k = 0; k < n_nodes; k++) {
+        size_t len = bounds[k + 1] - bounds[k];
+        job.first_task[k + 1] = job.first_task[k] + (len + MIXER_SLICE_BYTES - 1) / MIXER_SLICE_BYTES;
+    }
+    rdt_pool_run(job.first_task[n_nodes], mixer_level_task, &job);
+}
 
-    if (!data && len) return -1;
-    if (len == 0) return 0;
-    if (len == SIZE_MAX) return -1;
+/* Caller checks that every node above the last level is at least 64 bytes */
+static void recursive_entropy_mixer_parallel(uint8_t *data, size_t len, int depth, uint8_t *temp) {
+    size_t bounds[MIXER_MAX_PARALLEL_DEPTH + 1][(1u << MIXER_MAX_PARALLEL_DEPTH) + 1u];
+
+    /* bounds[l] splits the pool into the 2^l nodes of level l (mid = len / 2) */
+    bounds[0][0] = 0;
+    bounds[0][1] = len;
+    for (int l = 1; l <= depth; l++) {
+        size_t n = (size_t)1 << (l - 1);
+        for (size_t k = 0; k < n; k++) {
+            size_t a = bounds[l - 1][k];
+            size_t b = bounds[l - 1][k + 1];
+            bounds[l][2 * k] = a;
+            bounds[l][2 * k + 1] = a + (b - a) / 2;
+        }
+        bounds[l][2 * n] = len;
+    }
 
-    temp = (uint8_t *)malloc(len + 1);
-    scratch = (uint8_t *)malloc(len + 1);
-    if (!temp || !scratch) {
-        free(temp);
-        free(scratch);
-        return -1;
+    mixer_level_pass(temp, data, bounds[depth], (size_t)1 << depth, 0);
+    mixer_level_pass(data, temp, bounds[depth], (size_t)1 << depth, 1);
+    for (int l = depth - 1; l >= 0; l--) {
+        mixer_level_pass(temp, data, bounds[l], (size_t)1 << l, 1);
+        mixer_level_pass(data, temp, bounds[l], (size_t)1 << l, 0);
     }
+}
 
-    recursive_entropy_mixer_impl(data, len, max_depth, temp, scratch);
+/* temp must hold len bytes */
+static void recursive_entropy_mixer(uint8_t *data, size_t len, int max_depth, uint8_t *temp) {
+    if (len == 0) return;
 
-    free(temp);
-    free(scratch);
-    return 0;
+    /* The smallest node on level l is len >> l bytes */
+    if (len >= MIXER_PARALLEL_MIN_BYTES && max_depth > 0 &&
+        max_depth <= MIXER_MAX_PARALLEL_DEPTH &&
+        (len >> (max_depth - 1)) >= 64u && rdt_pool_idle()) {
+        RDT_STATS_ADD(RDT_STAT_SEED_MIX_PARALLEL, 1);
+        recursive_entropy_mixer_parallel(data, len, max_depth, temp);
+    } else {
+        recursive_entropy_mixer_impl(data, len, max_depth, temp);
+    }
 }
 
 /* ========================================================================== */
@@ -305,8 +356,23 @@ typedef struct {
     size_t len;
     size_t capacity;
     int failed;
+    int borrowed;   /* data belongs to an arena: never grown or freed */
+    int sizing;     /* count appended bytes without storing them */
 } byte_buffer;
 
+static void secure_zero(void *ptr, size_t len) {
+#if defined(__GNUC__)
+    /* memset runs at full width; the barrier keeps it from being elided */
+    memset(ptr, 0, len);
+    __asm__ __volatile__("" : : "r"(ptr) : "memory");
+#else
+    volatile uint8_t *p = (volatile uint8_t *)ptr;
+    for (size_t i = 0; i < len; i++) {
+        p[i] = 0;
+    }
+#endif
+}
+
 static void buffer_init(byte_buffer *buf, size_t initial_capacity) {
     if (initial_capacity < 4096) {
         initial_capacity = 4096;
@@ -315,20 +381,49 @@ static void buffer_init(byte_buffer *buf, size_t initial_capacity) {
     buf->data = (uint8_t *)malloc(buf->capacity);
     buf->len = 0;
     buf->failed = (buf->data == NULL);
+    buf->borrowed = 0;
+    buf->sizing = 0;
+}
+
+/* Append into caller-owned storage; running out of room fails instead of growing */
+static void buffer_borrow(byte_buffer *buf, uint8_t *storage, size_t capacity) {
+    buf->data = storage;
+    buf->len = 0;
+    buf->capacity = capacity;
+    buf->failed = 0;
+    buf->borrowed = 1;
+    buf->sizing = 0;
+}
+
+static void buffer_init_sizing(byte_buffer *buf) {
+    buf->data = NULL;
+    buf->len = 0;
+    buf->capacity = SIZE_MAX;
+    buf->failed = 0;
+    buf->borrowed = 1;
+    buf->sizing = 1;
 }
 
 static void buffer_append(byte_buffer *buf, const void *data, size_t len) {
     if (!buf || buf->failed) return;
-    if (!data && len) {
+    if (buf->len > SIZE_MAX - len) {
         buf->failed = 1;
         return;
     }
-    if (buf->len > SIZE_MAX - len) {
+    if (buf->sizing) {
+        buf->len += len;
+        return;
+    }
+    if (!data && len) {
         buf->failed = 1;
         return;
     }
 
     while (buf->len + len > buf->capacity) {
+        if (buf->borrowed) {
+            buf->failed = 1;
+            return;
+        }
         /* Check for overflow before doubling */
         if (buf->capacity > SIZE_MAX / 2) {
             buf->failed = 1;
@@ -375,7 +470,7 @@ static void buffer_append_double_le(byte_buffer *buf, double val) {
 }
 
 static void buffer_free(byte_buffer *buf) {
-    free(buf->data);
+    if (!buf->borrowed) free(buf->data);
     buf->data = NULL;
     buf->len = 0;
     buf->capacity = 0;
@@ -383,316 +478,2370 @@ static void buffer_free(byte_buffer *buf) {
 }
 
 /*
- * Extract numeric values with positions from data
+ * The extractor input is a list of byte ranges that read as one stream, so
+ * multi-file runs and mapped files need no concatenated copy. Positions in
+ * the pool are offsets into that stream. Framing spans (file names and
+ * separators) are part of the stream but not sensor samples, so health
+ * tests skip them.
  */
-static void extract_numeric_with_positions(const uint8_t *data, size_t len, byte_buffer *out) {
-    size_t i = 0;
-    uint32_t line_num = 0;
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+    int framing;
+} seed_span;
 
-    while (i < len) {
-        unsigned char ch = data[i];
-        /* Track line numbers */
-        if (ch == '\n') {
-            line_num++;
-            i++;
-            continue;
-        }
+/* ========================================================================== */
+/* Numeric Tokens                                                             */
+/* ========================================================================== */
 
-        /* Look for start of number */
-        if (isdigit((int)ch) ||
-            ((ch == '-' || ch == '+' || ch == '.') &&
-             i + 1 < len && (isdigit((int)(unsigned char)data[i + 1]) || data[i + 1] == '.'))) {
+/*
+ * A number token never spans more than 63 bytes (sign, 60 digits, '.', 'e',
+ * exponent sign), and the start test looks one byte ahead, so 64 bytes of
+ * lookahead decide every token.
+ */
+#define NUMERIC_LOOKAHEAD 64u
 
-            uint32_t pos = (uint32_t)i;
+/* Digit runs stop once a token is this long; such tokens are not converted */
+#define NUMERIC_TOKEN_LIMIT 60u
 
-            /* Parse number */
-            char num_buf[64];
-            size_t num_len = 0;
-            size_t j = i;
+/* Byte classes are plain ASCII and do not depend on the C locale */
+static inline int ascii_digit(uint8_t ch) {
+    return (unsigned)(ch - '0') < 10u;
+}
 
-            /* Sign */
-            if (j < len && (data[j] == '-' || data[j] == '+')) {
-                num_buf[num_len++] = (char)data[j++];
-            }
+static inline int token_start(uint8_t ch) {
+    return ascii_digit(ch) || ch == '-' || ch == '+' || ch == '.';
+}
 
-            /* Integer part */
-            while (j < len && isdigit((int)(unsigned char)data[j]) && num_len < 60) {
-                num_buf[num_len++] = (char)data[j++];
-            }
+/*
+ * 32-byte classifiers, one bit per byte: ASCII digits, and possible token
+ * starts (digit, '+', '-', '.') together with newlines.
+ */
+#if defined(__AVX2__)
+#define NUMSCAN_VECTOR 1
 
-            /* Decimal part */
-            if (j < len && data[j] == '.') {
-                num_buf[num_len++] = (char)data[j++];
-                while (j < len && isdigit((int)(unsigned char)data[j]) && num_len < 60) {
-                    num_buf[num_len++] = (char)data[j++];
-                }
-            }
+static inline __m256i digits_v(__m256i v) {
+    __m256i t = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - '0')));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(-128 + 10)), t);
+}
 
-            /* Exponent */
-            if (j < len && (data[j] == 'e' || data[j] == 'E')) {
-                num_buf[num_len++] = (char)data[j++];
-                if (j < len && (data[j] == '-' || data[j] == '+')) {
-                    num_buf[num_len++] = (char)data[j++];
-                }
-                while (j < len && isdigit((int)(unsigned char)data[j]) && num_len < 60) {
-                    num_buf[num_len++] = (char)data[j++];
-                }
-            }
+static inline uint32_t vec_digits32(const uint8_t *p) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)p);
+    return (uint32_t)_mm256_movemask_epi8(digits_v(v));
+}
 
-            num_buf[num_len] = '\0';
+static inline uint32_t vec_starts32(const uint8_t *p, uint32_t *newlines) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)p);
+    __m256i s = _mm256_or_si256(
+        _mm256_or_si256(digits_v(v), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('-')),
+                        _mm256_cmpeq_epi8(v, _mm256_set1_epi8('+'))));
+    *newlines = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+    return (uint32_t)_mm256_movemask_epi8(s);
+}
 
-            /* Convert to double */
-            if (num_len > 0 && num_len < 60) {
-                char *endptr;
-                double val = strtod(num_buf, &endptr);
+#elif defined(__SSE2__)
+#define NUMSCAN_VECTOR 1
 
-                /* Check for valid finite number */
-                if (endptr != num_buf && isfinite(val)) {
-                    /* Pack: position (4B) + line (4B) + float64 (8B) */
-                    buffer_append_u32_le(out, pos);
-                    buffer_append_u32_le(out, line_num);
-                    buffer_append_double_le(out, val);
-                }
-            }
+static inline __m128i digits_v(__m128i v) {
+    __m128i t = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - '0')));
+    return _mm_cmplt_epi8(t, _mm_set1_epi8((char)(-128 + 10)));
+}
 
-            i = j;
-        } else {
-            i++;
-        }
-    }
+static inline uint32_t vec_digits16(const uint8_t *p) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(const void *)p);
+    return (uint32_t)_mm_movemask_epi8(digits_v(v));
 }
 
-/*
- * Extract structural fingerprint
- */
-static void extract_structure_fingerprint(const uint8_t *data, size_t len, byte_buffer *out) {
-    /* File length */
-    buffer_append_u64_le(out, (uint64_t)len);
+static inline uint32_t vec_starts16(const uint8_t *p, uint32_t *newlines) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(const void *)p);
+    __m128i s = _mm_or_si128(
+        _mm_or_si128(digits_v(v), _mm_cmpeq_epi8(v, _mm_set1_epi8('.'))),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('-')),
+                     _mm_cmpeq_epi8(v, _mm_set1_epi8('+'))));
+    *newlines = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+    return (uint32_t)_mm_movemask_epi8(s);
+}
 
-    /* Count delimiters */
-    uint32_t newlines = 0, commas = 0, tabs = 0, spaces = 0, semicolons = 0;
-    for (size_t i = 0; i < len; i++) {
-        switch (data[i]) {
-            case '\n': newlines++; break;
-            case ',': commas++; break;
-            case '\t': tabs++; break;
-            case ' ': spaces++; break;
-            case ';': semicolons++; break;
-        }
-    }
+static inline uint32_t vec_digits32(const uint8_t *p) {
+    return vec_digits16(p) | (vec_digits16(p + 16) << 16);
+}
 
-    buffer_append_u32_le(out, newlines);
-    buffer_append_u32_le(out, commas);
-    buffer_append_u32_le(out, tabs);
-    buffer_append_u32_le(out, spaces);
-    buffer_append_u32_le(out, semicolons);
+static inline uint32_t vec_starts32(const uint8_t *p, uint32_t *newlines) {
+    uint32_t nl_lo, nl_hi;
+    uint32_t s = vec_starts16(p, &nl_lo) | (vec_starts16(p + 16, &nl_hi) << 16);
+    *newlines = nl_lo | (nl_hi << 16);
+    return s;
+}
 
-    /* Sample raw bytes */
-    size_t interval = (len > 128) ? (len / 128) : 1;
-    for (size_t i = 0; i < len; i += interval) {
-        buffer_append_u32_le(out, (uint32_t)i);
-        size_t chunk = (i + 4 <= len) ? 4 : (len - i);
-        buffer_append(out, data + i, chunk);
-        if (chunk < 4) {
-            uint8_t pad[4] = {0};
-            buffer_append(out, pad, 4 - chunk);
+#else
+#define NUMSCAN_VECTOR 0
+#endif
+
+/*
+ * Index of the next possible token start at or after i (len if none),
+ * counting the newlines skipped on the way.
+ */
+static size_t skip_to_candidate(const uint8_t *data, size_t i, size_t len, uint32_t *line_num) {
+#if NUMSCAN_VECTOR
+    while (len - i >= 32u) {
+        uint32_t newlines;
+        uint32_t starts = vec_starts32(data + i, &newlines);
+
+        if (starts) {
+            unsigned t = (unsigned)__builtin_ctz(starts);
+            *line_num += (uint32_t)__builtin_popcount(newlines & ((1u << t) - 1u));
+            return i + t;
         }
+        *line_num += (uint32_t)__builtin_popcount(newlines);
+        i += 32u;
+    }
+#endif
+    for (; i < len; i++) {
+        if (token_start(data[i])) return i;
+        if (data[i] == '\n') (*line_num)++;
     }
+    return len;
 }
 
-/* ========================================================================== */
-/* Main Extraction Functions                                                  */
-/* ========================================================================== */
+/*
+ * Advance j over digits while the token is shorter than NUMERIC_TOKEN_LIMIT.
+ * With masked set, digits holds one bit per byte for p[0..64).
+ */
+static inline size_t skip_digits(const uint8_t *p, size_t j, size_t avail,
+                                 uint64_t digits, int masked) {
+    if (j >= NUMERIC_TOKEN_LIMIT) return j;
+    if (masked) {
+        uint64_t rest = ~digits >> j;
+        j += rest ? (size_t)__builtin_ctzll(rest) : 64u - j;
+        return (j < NUMERIC_TOKEN_LIMIT) ? j : NUMERIC_TOKEN_LIMIT;
+    }
+    while (j < avail && j < NUMERIC_TOKEN_LIMIT && ascii_digit(p[j])) j++;
+    return j;
+}
 
-int rdt_seed_extract(const uint8_t *data, size_t data_len, uint8_t seed_out[32]) {
-    size_t pool_capacity;
-    size_t numeric_capacity;
+/*
+ * Length of the token at p: optional sign, digits, optional '.' and digits,
+ * optional 'e'/'E' with optional sign and digits. An 'e' is taken even when
+ * no exponent digits follow it.
+ */
+static size_t token_length(const uint8_t *p, size_t avail) {
+    uint64_t digits = 0;
+    int masked = 0;
+    size_t j = 0;
+
+#if NUMSCAN_VECTOR
+    if (avail >= 64u) {
+        digits = (uint64_t)vec_digits32(p) | ((uint64_t)vec_digits32(p + 32) << 32);
+        masked = 1;
+    }
+#endif
+    if (p[0] == '-' || p[0] == '+') j = 1;
+    j = skip_digits(p, j, avail, digits, masked);
+    if (j < avail && p[j] == '.') {
+        j = skip_digits(p, j + 1, avail, digits, masked);
+    }
+    if (j < avail && (p[j] == 'e' || p[j] == 'E')) {
+        j++;
+        if (j < avail && (p[j] == '-' || p[j] == '+')) j++;
+        j = skip_digits(p, j, avail, digits, masked);
+    }
+    return j;
+}
 
-    if (!data || !seed_out || data_len == 0) return -1;
+/*
+ * 5^q = (hi:lo) * 2^exp2 for POW5_MIN <= q <= POW5_MAX, with bit 127 of
+ * hi:lo set. Entries are exact for 0 <= q <= POW5_EXACT_MAX and rounded
+ * down otherwise.
+ */
+#define POW5_MIN (-64)
+#define POW5_MAX 64
+#define POW5_EXACT_MAX 55
 
-    pool_capacity = (data_len > SIZE_MAX - 1024u) ? data_len : data_len + 1024u;
-    numeric_capacity = (data_len > SIZE_MAX - 256u) ? data_len : data_len + 256u;
+typedef struct {
+    uint64_t hi;
+    uint64_t lo;
+    int exp2;
+} pow5_entry;
+
+static const pow5_entry pow5_table[POW5_MAX - POW5_MIN + 1] = {
+    {0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL, -276},
+    {0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL, -274},
+    {0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL, -271},
+    {0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL, -269},
+    {0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, -267},
+    {0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL, -264},
+    {0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL, -262},
+    {0xc8de047564d20a8bULL, 0xf245825a5a445275ULL, -260},
+    {0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL, -258},
+    {0x9ced737bb6c4183dULL, 0x55464dd69685606bULL, -255},
+    {0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, -253},
+    {0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL, -251},
+    {0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, -248},
+    {0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL, -246},
+    {0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, -244},
+    {0x95a8637627989aadULL, 0xdde7001379a44aa8ULL, -241},
+    {0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, -239},
+    {0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL, -237},
+    {0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, -234},
+    {0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL, -232},
+    {0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL, -230},
+    {0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL, -227},
+    {0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, -225},
+    {0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL, -223},
+    {0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, -220},
+    {0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL, -218},
+    {0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, -216},
+    {0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL, -213},
+    {0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, -211},
+    {0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL, -209},
+    {0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL, -206},
+    {0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL, -204},
+    {0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, -202},
+    {0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL, -199},
+    {0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, -197},
+    {0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL, -195},
+    {0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, -193},
+    {0x9e74d1b791e07e48ULL, 0x775ea264cf55347dULL, -190},
+    {0xc612062576589ddaULL, 0x95364afe032a819dULL, -188},
+    {0xf79687aed3eec551ULL, 0x3a83ddbd83f52204ULL, -186},
+    {0x9abe14cd44753b52ULL, 0xc4926a9672793542ULL, -183},
+    {0xc16d9a0095928a27ULL, 0x75b7053c0f178293ULL, -181},
+    {0xf1c90080baf72cb1ULL, 0x5324c68b12dd6338ULL, -179},
+    {0x971da05074da7beeULL, 0xd3f6fc16ebca5e03ULL, -176},
+    {0xbce5086492111aeaULL, 0x88f4bb1ca6bcf584ULL, -174},
+    {0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e5ULL, -172},
+    {0x9392ee8e921d5d07ULL, 0x3aff322e62439fcfULL, -169},
+    {0xb877aa3236a4b449ULL, 0x09befeb9fad487c2ULL, -167},
+    {0xe69594bec44de15bULL, 0x4c2ebe687989a9b3ULL, -165},
+    {0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a10ULL, -162},
+    {0xb424dc35095cd80fULL, 0x538484c19ef38c94ULL, -160},
+    {0xe12e13424bb40e13ULL, 0x2865a5f206b06fb9ULL, -158},
+    {0x8cbccc096f5088cbULL, 0xf93f87b7442e45d3ULL, -155},
+    {0xafebff0bcb24aafeULL, 0xf78f69a51539d748ULL, -153},
+    {0xdbe6fecebdedd5beULL, 0xb573440e5a884d1bULL, -151},
+    {0x89705f4136b4a597ULL, 0x31680a88f8953030ULL, -148},
+    {0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3dULL, -146},
+    {0xd6bf94d5e57a42bcULL, 0x3d32907604691b4cULL, -144},
+    {0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b10fULL, -141},
+    {0xa7c5ac471b478423ULL, 0x0fcf80dc33721d53ULL, -139},
+    {0xd1b71758e219652bULL, 0xd3c36113404ea4a8ULL, -137},
+    {0x83126e978d4fdf3bULL, 0x645a1cac083126e9ULL, -134},
+    {0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a3ULL, -132},
+    {0xccccccccccccccccULL, 0xccccccccccccccccULL, -130},
+    {0x8000000000000000ULL, 0x0000000000000000ULL, -127},
+    {0xa000000000000000ULL, 0x0000000000000000ULL, -125},
+    {0xc800000000000000ULL, 0x0000000000000000ULL, -123},
+    {0xfa00000000000000ULL, 0x0000000000000000ULL, -121},
+    {0x9c40000000000000ULL, 0x0000000000000000ULL, -118},
+    {0xc350000000000000ULL, 0x0000000000000000ULL, -116},
+    {0xf424000000000000ULL, 0x0000000000000000ULL, -114},
+    {0x9896800000000000ULL, 0x0000000000000000ULL, -111},
+    {0xbebc200000000000ULL, 0x0000000000000000ULL, -109},
+    {0xee6b280000000000ULL, 0x0000000000000000ULL, -107},
+    {0x9502f90000000000ULL, 0x0000000000000000ULL, -104},
+    {0xba43b74000000000ULL, 0x0000000000000000ULL, -102},
+    {0xe8d4a51000000000ULL, 0x0000000000000000ULL, -100},
+    {0x9184e72a00000000ULL, 0x0000000000000000ULL, -97},
+    {0xb5e620f480000000ULL, 0x0000000000000000ULL, -95},
+    {0xe35fa931a0000000ULL, 0x0000000000000000ULL, -93},
+    {0x8e1bc9bf04000000ULL, 0x0000000000000000ULL, -90},
+    {0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL, -88},
+    {0xde0b6b3a76400000ULL, 0x0000000000000000ULL, -86},
+    {0x8ac7230489e80000ULL, 0x0000000000000000ULL, -83},
+    {0xad78ebc5ac620000ULL, 0x0000000000000000ULL, -81},
+    {0xd8d726b7177a8000ULL, 0x0000000000000000ULL, -79},
+    {0x878678326eac9000ULL, 0x0000000000000000ULL, -76},
+    {0xa968163f0a57b400ULL, 0x0000000000000000ULL, -74},
+    {0xd3c21bcecceda100ULL, 0x0000000000000000ULL, -72},
+    {0x84595161401484a0ULL, 0x0000000000000000ULL, -69},
+    {0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL, -67},
+    {0xcecb8f27f4200f3aULL, 0x0000000000000000ULL, -65},
+    {0x813f3978f8940984ULL, 0x4000000000000000ULL, -62},
+    {0xa18f07d736b90be5ULL, 0x5000000000000000ULL, -60},
+    {0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, -58},
+    {0xfc6f7c4045812296ULL, 0x4d00000000000000ULL, -56},
+    {0x9dc5ada82b70b59dULL, 0xf020000000000000ULL, -53},
+    {0xc5371912364ce305ULL, 0x6c28000000000000ULL, -51},
+    {0xf684df56c3e01bc6ULL, 0xc732000000000000ULL, -49},
+    {0x9a130b963a6c115cULL, 0x3c7f400000000000ULL, -46},
+    {0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, -44},
+    {0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL, -42},
+    {0x96769950b50d88f4ULL, 0x1314448000000000ULL, -39},
+    {0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL, -37},
+    {0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL, -35},
+    {0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL, -32},
+    {0xb7abc627050305adULL, 0xf14a3d9e40000000ULL, -30},
+    {0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL, -28},
+    {0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL, -25},
+    {0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL, -23},
+    {0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL, -21},
+    {0x8c213d9da502de45ULL, 0x4526f422cc340000ULL, -18},
+    {0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL, -16},
+    {0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL, -14},
+    {0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL, -11},
+    {0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL, -9},
+    {0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL, -7},
+    {0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL, -4},
+    {0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL, -2},
+    {0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL, 0},
+    {0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL, 3},
+    {0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL, 5},
+    {0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL, 7},
+    {0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL, 9},
+    {0x9f4f2726179a2245ULL, 0x01d762422c946590ULL, 12},
+    {0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL, 14},
+    {0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL, 16},
+    {0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL, 19},
+    {0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL, 21},
+};
 
-    byte_buffer pool;
-    buffer_init(&pool, pool_capacity);
+static const double exact_pow10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
 
-    if (!pool.data) return -1;
+static inline void mul_64x64(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128)a * b;
+    *hi = (uint64_t)(p >> 64);
+    *lo = (uint64_t)p;
+#else
+    uint64_t a0 = a & 0xFFFFFFFFu, a1 = a >> 32;
+    uint64_t b0 = b & 0xFFFFFFFFu, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+    *lo = (mid << 32) | (p00 & 0xFFFFFFFFu);
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+}
 
-    /* Build entropy pool */
+/*
+ * Round the 192-bit product p (top bit at 190 or 191) scaled by 2^scale to
+ * the nearest double, ties to even. Returns the IEEE bit pattern of the
+ * positive result, or 0 when it would be subnormal or infinite.
+ */
+static uint64_t round_product(const uint64_t p[3], int scale) {
+    unsigned top = (unsigned)(p[2] >> 63);
+    unsigned shift = 10u + top;
+    uint64_t mant = p[2] >> shift;
+    uint64_t below = p[2] & ((1ULL << shift) - 1u);
+    uint64_t half = 1ULL << (shift - 1u);
+    int biased = 52 + 128 + (int)shift + scale + 1023;
+
+    if (below > half || (below == half && ((p[1] | p[0]) || (mant & 1u)))) {
+        mant++;
+        if (mant == (1ULL << 53)) {
+            mant >>= 1;
+            biased++;
+        }
+    }
+    if (biased < 1 || biased > 2046) return 0;
+    return ((uint64_t)biased << 52) | (mant & ((1ULL << 52) - 1u));
+}
 
-    /* Numeric extraction with positions */
-    buffer_append(&pool, "NUMERIC:", 8);
-    byte_buffer numeric;
-    buffer_init(&numeric, numeric_capacity);
-    extract_numeric_with_positions(data, data_len, &numeric);
-    if (numeric.failed) {
-        buffer_free(&numeric);
-        buffer_free(&pool);
-        return -1;
+/*
+ * Correctly rounded w * 10^q for w > 0, or -1 when that cannot be decided
+ * cheaply. Small cases are exact in double arithmetic (Clinger). Otherwise w
+ * is multiplied by a 128-bit 5^q; the true product lies in [P, P + w), and
+ * the result is used only if both ends round to the same double (the
+ * Eisel-Lemire idea, minus the table size).
+ */
+static int decimal_to_double(uint64_t w, int q, double *out) {
+    const pow5_entry *t;
+    uint64_t lo[3];
+    uint64_t hi[3];
+    uint64_t a1, a0, b1, b0;
+    uint64_t bits_lo, bits_hi;
+    int lz;
+
+    /* Needs double operations rounded to double (16: only _Float16 is widened) */
+#if FLT_EVAL_METHOD == 0 || FLT_EVAL_METHOD == 1 || FLT_EVAL_METHOD == 16
+    if (w <= (1ULL << 53) && q >= -22 && q <= 22) {
+        double d = (double)w;
+        *out = (q < 0) ? d / exact_pow10[-q] : d * exact_pow10[q];
+        return 0;
     }
-    buffer_append_u32_le(&pool, (uint32_t)numeric.len);
-    if (numeric.len > 0) {
-        buffer_append(&pool, numeric.data, numeric.len);
+#endif
+    if (q < POW5_MIN || q > POW5_MAX) return -1;
+
+    t = &pow5_table[q - POW5_MIN];
+    lz = __builtin_clzll(w);
+    w <<= lz;
+    mul_64x64(w, t->lo, &a1, &a0);
+    mul_64x64(w, t->hi, &b1, &b0);
+    lo[0] = a0;
+    lo[1] = a1 + b0;
+    lo[2] = b1 + (lo[1] < a1);
+
+    memcpy(hi, lo, sizeof(hi));
+    if (q < 0 || q > POW5_EXACT_MAX) {
+        hi[0] += w;
+        if (hi[0] < w && ++hi[1] == 0 && ++hi[2] == 0) return -1;
     }
-    buffer_free(&numeric);
 
-    /* Structure fingerprint */
-    buffer_append(&pool, "STRUCTURE:", 10);
-    extract_structure_fingerprint(data, data_len, &pool);
+    bits_lo = round_product(lo, q + t->exp2 - lz);
+    bits_hi = round_product(hi, q + t->exp2 - lz);
+    if (!bits_lo || bits_lo != bits_hi) return -1;
+    memcpy(out, &bits_lo, sizeof(*out));
+    return 0;
+}
 
-    /* Raw data hash */
-    buffer_append(&pool, "RAWHASH:", 8);
-    uint8_t raw_hash[32];
-    sha256(data, data_len, raw_hash);
-    buffer_append(&pool, raw_hash, 32);
-    if (pool.failed) {
-        buffer_free(&pool);
-        return -1;
+/*
+ * Convert a token from token_length() to the value strtod() gives for it in
+ * the C locale. Returns -1 when the token holds no digits or the value is not
+ * finite. Values the fast path cannot settle (over 19 significant digits,
+ * far exponents, subnormals, exact ties after rounding 5^q) go to strtod().
+ */
+static int parse_number(const uint8_t *p, size_t n, double *out) {
+    size_t k = 0;
+    int neg = 0;
+    uint64_t w = 0;
+    int sig = 0;
+    int frac = 0;
+    int any = 0;
+    long exp10 = 0;
+
+    if (p[k] == '-' || p[k] == '+') {
+        neg = (p[k] == '-');
+        k++;
+    }
+    for (int in_frac = 0; k < n; k++) {
+        if (ascii_digit(p[k])) {
+            unsigned d = (unsigned)(p[k] - '0');
+            any = 1;
+            frac += in_frac;
+            if (w || d) {
+                if (sig < 19) w = w * 10u + d;
+                sig++;
+            } else if (sig) {
+                sig++;
+            }
+        } else if (p[k] == '.' && !in_frac) {
+            in_frac = 1;
+        } else {
+            break;
+        }
+    }
+    if (!any) return -1;
+
+    if (k < n && (p[k] == 'e' || p[k] == 'E')) {
+        size_t e = k + 1;
+        int eneg = 0;
+        if (e < n && (p[e] == '-' || p[e] == '+')) {
+            eneg = (p[e] == '-');
+            e++;
+        }
+        if (e < n && ascii_digit(p[e])) {
+            for (; e < n && ascii_digit(p[e]); e++) {
+                if (exp10 < 100000) exp10 = exp10 * 10 + (p[e] - '0');
+            }
+            if (eneg) exp10 = -exp10;
+        }
     }
 
-    /* Apply mixing */
-    if (entropy_precursor_layer(pool.data, pool.len, 256) != 0 ||
-        recursive_entropy_mixer(pool.data, pool.len, 4) != 0) {
-        buffer_free(&pool);
-        return -1;
+    if (w == 0) {
+        *out = neg ? -0.0 : 0.0;
+        return 0;
+    }
+    if (sig <= 19 && decimal_to_double(w, (int)(exp10 - frac), out) == 0) {
+        if (neg) *out = -*out;
+        return 0;
     }
 
-    /* Final SHA-256 with domain separation */
-    sha256_ctx ctx;
-    sha256_init(&ctx);
-    sha256_update(&ctx, (const uint8_t *)"RDT256-SEEDGEN-v1\x00", 18);
-    sha256_update(&ctx, (const uint8_t *)"StevenReid:RDT256\x00", 18);
-    sha256_update(&ctx, pool.data, pool.len);
-    sha256_final(&ctx, seed_out);
-
-    buffer_free(&pool);
-    return 0;
+    {
+        char num_buf[NUMERIC_LOOKAHEAD];
+        char *endptr;
+        double val;
+
+        memcpy(num_buf, p, n);
+        num_buf[n] = '\0';
+        val = strtod(num_buf, &endptr);
+        if (endptr == num_buf || !isfinite(val)) return -1;
+        *out = val;
+        return 0;
+    }
 }
 
-int rdt_seed_extract_u64(const uint8_t *data, size_t data_len, uint64_t seed_out[4]) {
-    uint8_t seed[32];
-    int result = rdt_seed_extract(data, data_len, seed);
-    if (result != 0) return result;
+/*
+ * Scan data[0..len) for numbers, appending (pos, line, value) records with
+ * pos = base + index. Unless final, scanning stops at a possible token start
+ * that has fewer than NUMERIC_LOOKAHEAD bytes after it. Returns the number of
+ * bytes consumed.
+ */
+static size_t scan_numbers(const uint8_t *data, size_t len, uint64_t base, int final,
+                           uint32_t *line_num, byte_buffer *out) {
+    uint32_t line = *line_num;
+    size_t i = 0;
 
-    /* Little-endian conversion */
-    for (int i = 0; i < 4; i++) {
-        seed_out[i] = 0;
-        for (int j = 0; j < 8; j++) {
-            seed_out[i] |= ((uint64_t)seed[i * 8 + j]) << (j * 8);
+    while (i < len) {
+        uint8_t ch;
+
+        i = skip_to_candidate(data, i, len, &line);
+        if (i == len) break;
+        if (!final && len - i < NUMERIC_LOOKAHEAD) break;
+
+        /* Digits always start a number; a sign or '.' needs a digit or '.' next */
+        ch = data[i];
+        if (ascii_digit(ch) ||
+            (i + 1 < len && (ascii_digit(data[i + 1]) || data[i + 1] == '.'))) {
+            size_t n = token_length(data + i, len - i);
+            double val;
+
+            if (n < NUMERIC_TOKEN_LIMIT && out->sizing) {
+                /* Upper bound: a token without a digit never converts */
+                for (size_t k = 0; k < n; k++) {
+                    if (ascii_digit(data[i + k])) {
+                        out->len += 16u;
+                        break;
+                    }
+                }
+            } else if (n < NUMERIC_TOKEN_LIMIT && parse_number(data + i, n, &val) == 0) {
+                /* Pack: position (4B) + line (4B) + float64 (8B) */
+                buffer_append_u32_le(out, (uint32_t)(base + i));
+                buffer_append_u32_le(out, line);
+                buffer_append_double_le(out, val);
+            }
+            i += n;
+        } else {
+            i++;
         }
     }
-
-    return 0;
+    *line_num = line;
+    return i;
 }
 
-int rdt_seed_extract_file(const char *filepath, uint8_t seed_out[32]) {
-    FILE *f = fopen(filepath, "rb");
-    if (!f) return -1;
+/*
+ * Resumable numeric scanner. Input arrives in pieces; the undecided tail of
+ * one piece (< NUMERIC_LOOKAHEAD bytes) is carried over and completed from
+ * the start of the next, so records match a scan over the joined input.
+ */
+typedef struct {
+    uint64_t offset;        /* stream position of the next unconsumed byte */
+    uint32_t line_num;
+    size_t carry_len;
+    uint8_t carry[2 * NUMERIC_LOOKAHEAD];
+} numeric_scanner;
+
+static void numeric_scanner_init(numeric_scanner *s) {
+    s->offset = 0;
+    s->line_num = 0;
+    s->carry_len = 0;
+}
 
-    /* Get file size */
-    if (fseek(f, 0, SEEK_END) != 0) {
-        fclose(f);
-        return -1;
-    }
-    long size = ftell(f);
-    if (size < 0 || fseek(f, 0, SEEK_SET) != 0) {
-        fclose(f);
-        return -1;
+static void numeric_scanner_feed(numeric_scanner *s, const uint8_t *data, size_t len,
+                                 int final, byte_buffer *out) {
+    size_t off = 0;
+    size_t used;
+
+    while (s->carry_len) {
+        size_t old = s->carry_len;
+        size_t take = sizeof(s->carry) - old;
+
+        if (take > len - off) take = len - off;
+        if (take) memcpy(s->carry + old, data + off, take);
+        s->carry_len += take;
+        off += take;
+
+        used = scan_numbers(s->carry, s->carry_len, s->offset,
+                            final && off == len, &s->line_num, out);
+        s->offset += used;
+        if (used >= old) {
+            /* the carried bytes are done; resume in place inside data */
+            off -= s->carry_len - used;
+            s->carry_len = 0;
+            break;
+        }
+        memmove(s->carry, s->carry + used, s->carry_len - used);
+        s->carry_len -= used;
+        if (off == len) return;
     }
 
-    if (size <= 0 || size > 100 * 1024 * 1024) {  /* Max 100 MB */
-        fclose(f);
-        return -1;
+    if (off == len) return;
+    used = scan_numbers(data + off, len - off, s->offset, final, &s->line_num, out);
+    s->offset += used;
+    off += used;
+    if (off < len) {
+        memcpy(s->carry, data + off, len - off);
+        s->carry_len = len - off;
     }
+}
 
-    uint8_t *data = (uint8_t *)malloc((size_t)size);
-    if (!data) {
-        fclose(f);
+/*
+ * Copy up to want bytes starting at stream offset pos. The cursor (span
+ * index and that span's stream offset) only moves forward, so monotonic
+ * reads walk the span list once.
+ */
+static size_t spans_read(const seed_span *spans, size_t n_spans,
+                         size_t *cur, size_t *cur_base,
+                         size_t pos, uint8_t *dst, size_t want) {
+    size_t got = 0;
+
+    while (*cur < n_spans && pos >= *cur_base + spans[*cur].len) {
+        *cur_base += spans[*cur].len;
+        (*cur)++;
+    }
+    for (size_t k = *cur, base = *cur_base; k < n_spans && got < want; k++) {
+        size_t from = (pos + got) - base;
+        size_t n = spans[k].len - from;
+        if (n > want - got) n = want - got;
+        memcpy(dst + got, spans[k].data + from, n);
+        got += n;
+        base += spans[k].len;
+    }
+    return got;
+}
+
+/* Delimiter counters in fingerprint order: newline, comma, tab, space, semicolon */
+#define DELIM_COUNT 5
+
+static void count_delimiters(const uint8_t *data, size_t len, uint32_t counts[DELIM_COUNT]) {
+    for (size_t i = 0; i < len; i++) {
+        switch (data[i]) {
+            case '\n': counts[0]++; break;
+            case ',': counts[1]++; break;
+            case '\t': counts[2]++; break;
+            case ' ': counts[3]++; break;
+            case ';': counts[4]++; break;
+        }
+    }
+}
+
+/*
+ * Features of one span computed ahead of time (by the feature cache). A span
+ * may only carry them if the bytes on both sides of it cannot be part of a
+ * number, so that it tokenizes the same on its own as inside the stream.
+ * records holds the span's numeric records with positions and line numbers
+ * relative to the span start, each encoded as
+ *   varint(position delta) varint(line delta) double (8 bytes LE)
+ * with both deltas taken modulo 2^32 from the previous record (the first
+ * from 0). The encoding is validated before it gets here.
+ */
+typedef struct {
+    int present;
+    const uint8_t *records;
+    size_t records_len;
+    size_t n_records;
+    uint32_t delims[DELIM_COUNT];
+} span_features;
+
+static size_t read_varint32(const uint8_t *p, size_t len, uint32_t *out) {
+    uint32_t val = 0;
+
+    for (size_t i = 0; i < len && i < 5u; i++) {
+        val |= (uint32_t)(p[i] & 0x7Fu) << (7u * i);
+        if (!(p[i] & 0x80u)) {
+            *out = val;
+            return i + 1u;
+        }
+    }
+    return 0;
+}
+
+/* Append a span's cached records with positions and lines rebased onto the stream */
+static void replay_records(const span_features *f, uint64_t base, uint32_t line_base,
+                           byte_buffer *out) {
+    const uint8_t *p = f->records;
+    const uint8_t *end = f->records + f->records_len;
+    uint32_t pos = 0, line = 0;
+
+    for (size_t r = 0; r < f->n_records; r++) {
+        uint32_t d = 0;
+        p += read_varint32(p, (size_t)(end - p), &d);
+        pos += d;
+        p += read_varint32(p, (size_t)(end - p), &d);
+        line += d;
+        buffer_append_u32_le(out, (uint32_t)base + pos);
+        buffer_append_u32_le(out, line_base + line);
+        buffer_append(out, p, 8);
+        p += 8;
+    }
+}
+
+/*
+ * Single pass over the input for the numeric records, delimiter counts and
+ * raw-data hash. Each slice is small enough to stay in L1/L2 while all three
+ * consumers read it, so large inputs are pulled from memory only once.
+ * Records are appended to numeric exactly as a separate scan would produce.
+ */
+#define FUSED_SLICE_BYTES 16384u
+
+static void extract_fused_features(const seed_span *spans, size_t n_spans,
+                                   const span_features *features, rdt_health *health,
+                                   byte_buffer *numeric, uint32_t delims[DELIM_COUNT],
+                                   uint8_t raw_hash[32]) {
+    static const uint8_t none[1];
+    numeric_scanner scanner;
+    rdt_sha256_ctx raw_ctx;
+    int finalized = 0;
+
+    numeric_scanner_init(&scanner);
+    rdt_sha256_init(&raw_ctx);
+    for (size_t k = 0; k < n_spans; k++) {
+        const uint8_t *data = spans[k].data;
+        size_t len = spans[k].len;
+        rdt_health *monitor = spans[k].framing ? NULL : health;
+
+        if (features && features[k].present) {
+            /* Finish what came before, then only the raw hash reads the bytes */
+            numeric_scanner_feed(&scanner, none, 0, 1, numeric);
+            replay_records(&features[k], scanner.offset, scanner.line_num, numeric);
+            scanner.offset += len;
+            scanner.line_num += features[k].delims[0];
+            for (int d = 0; d < DELIM_COUNT; d++) {
+                delims[d] += features[k].delims[d];
+            }
+            if (len) rdt_sha256_update(&raw_ctx, data, len);
+            if (monitor && len) rdt_health_feed(monitor, data, len);
+            continue;
+        }
+
+        while (len) {
+            size_t n = (len < FUSED_SLICE_BYTES) ? len : FUSED_SLICE_BYTES;
+            int final = (n == len && k + 1 == n_spans);
+
+            rdt_sha256_update(&raw_ctx, data, n);
+            count_delimiters(data, n, delims);
+            if (monitor) rdt_health_feed(monitor, data, n);
+            numeric_scanner_feed(&scanner, data, n, final, numeric);
+            finalized |= final;
+            data += n;
+            len -= n;
+        }
+    }
+    if (!finalized) {
+        /* trailing empty or cached span: flush whatever the scanner still carries */
+        numeric_scanner_feed(&scanner, none, 0, 1, numeric);
+    }
+    rdt_sha256_final(&raw_ctx, raw_hash);
+}
+
+/*
+ * Structural fingerprint: length, delimiter counts from the fused pass, and
+ * 4-byte samples at len/128 intervals
+ */
+static void extract_structure_fingerprint(const seed_span *spans, size_t n_spans,
+                                          size_t len, const uint32_t delims[DELIM_COUNT],
+                                          byte_buffer *out) {
+    /* File length */
+    buffer_append_u64_le(out, (uint64_t)len);
+
+    for (int d = 0; d < DELIM_COUNT; d++) {
+        buffer_append_u32_le(out, delims[d]);
+    }
+
+    /* Sample raw bytes */
+    size_t interval = (len > 128) ? (len / 128) : 1;
+    size_t cur = 0, cur_base = 0;
+    for (size_t i = 0; i < len; i += interval) {
+        uint8_t sample[4] = {0};
+        buffer_append_u32_le(out, (uint32_t)i);
+        (void)spans_read(spans, n_spans, &cur, &cur_base, i, sample, 4);
+        buffer_append(out, sample, 4);
+    }
+}
+
+/* ========================================================================== */
+/* Typed Binary Input                                                         */
+/* ========================================================================== */
+
+/*
+ * Binary captures are cut into records of stride bytes, each holding
+ * stride / width consecutive little-endian values from its first byte.
+ * Every value whose bytes lie inside the input becomes a numeric record
+ * (byte offset, record index, value as double), the same layout the text
+ * scanner produces with (byte offset, line). Bytes outside whole values only
+ * reach the structure fingerprint and raw hash.
+ */
+typedef struct {
+    uint32_t format;
+    size_t width;
+    size_t stride;
+    size_t per_record;
+} typed_layout;
+
+static int typed_layout_init(typed_layout *t, uint32_t format, size_t stride) {
+    switch (format) {
+        case RDT_SEED_FORMAT_I16LE: t->width = 2; break;
+        case RDT_SEED_FORMAT_I32LE: t->width = 4; break;
+        case RDT_SEED_FORMAT_F32LE: t->width = 4; break;
+        case RDT_SEED_FORMAT_F64LE: t->width = 8; break;
+        default: return -1;
+    }
+    if (stride == 0) stride = t->width;
+    if (stride < t->width || stride > RDT_SEED_MAX_STRIDE) return -1;
+    t->format = format;
+    t->stride = stride;
+    t->per_record = stride / t->width;
+    return 0;
+}
+
+static size_t typed_value_count(const typed_layout *t, size_t len) {
+    size_t tail = (len % t->stride) / t->width;
+    return (len / t->stride) * t->per_record + ((tail < t->per_record) ? tail : t->per_record);
+}
+
+static double typed_value(const typed_layout *t, const uint8_t *p) {
+    uint64_t bits = 0;
+
+    for (size_t i = t->width; i-- > 0;) {
+        bits = (bits << 8) | p[i];
+    }
+    switch (t->format) {
+        case RDT_SEED_FORMAT_I16LE:
+            return (double)(int16_t)(uint16_t)bits;
+        case RDT_SEED_FORMAT_I32LE:
+            return (double)(int32_t)(uint32_t)bits;
+        case RDT_SEED_FORMAT_F32LE: {
+            uint32_t b32 = (uint32_t)bits;
+            float f;
+            memcpy(&f, &b32, sizeof(f));
+            return (double)f;
+        }
+        default: {
+            double d;
+            memcpy(&d, &bits, sizeof(d));
+            return d;
+        }
+    }
+}
+
+#if defined(__AVX2__)
+/*
+ * Dense input (stride == width): widen four values at a time and interleave
+ * them with their (offset, index) words into four 16-byte records.
+ * Returns the number of values written.
+ */
+static size_t typed_records_avx2(const typed_layout *t, const uint8_t *p, size_t count,
+                                 uint32_t pos, uint32_t index, uint8_t *out) {
+    const __m256i step = _mm256_set1_epi64x((long long)(((uint64_t)4u << 32) |
+                                                         (uint32_t)(4u * t->width)));
+    __m256i pl = _mm256_setr_epi32((int)pos, (int)index,
+                                   (int)(pos + (uint32_t)t->width), (int)(index + 1u),
+                                   (int)(pos + 2u * (uint32_t)t->width), (int)(index + 2u),
+                                   (int)(pos + 3u * (uint32_t)t->width), (int)(index + 3u));
+    size_t n = 0;
+
+    for (; n + 4u <= count; n += 4u) {
+        const uint8_t *src = p + n * t->width;
+        __m256d d;
+        __m256i lo, hi;
+
+        switch (t->format) {
+            case RDT_SEED_FORMAT_I16LE:
+                d = _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)src)));
+                break;
+            case RDT_SEED_FORMAT_I32LE:
+                d = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)src));
+                break;
+            case RDT_SEED_FORMAT_F32LE:
+                d = _mm256_cvtps_pd(_mm_loadu_ps((const float *)(const void *)src));
+                break;
+            default:
+                d = _mm256_loadu_pd((const double *)(const void *)src);
+                break;
+        }
+        lo = _mm256_unpacklo_epi64(pl, _mm256_castpd_si256(d));
+        hi = _mm256_unpackhi_epi64(pl, _mm256_castpd_si256(d));
+        _mm256_storeu_si256((__m256i *)(void *)(out + n * 16u),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *)(void *)(out + n * 16u + 32u),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+        pl = _mm256_add_epi32(pl, step);
+    }
+    return n;
+}
+#endif
+
+/* Emit the records of every value that starts in [from, to) */
+static void typed_records(const typed_layout *t, const uint8_t *data, size_t len,
+                          size_t from, size_t to, byte_buffer *out) {
+    size_t rec = from / t->stride;
+    size_t field = (from % t->stride + t->width - 1u) / t->width;
+
+    if (field >= t->per_record) {
+        rec++;
+        field = 0;
+    }
+    for (;;) {
+        size_t off = rec * t->stride + field * t->width;
+        if (off >= to || t->width > len - off) break;
+
+#if defined(__AVX2__)
+        if (t->stride == t->width && !out->sizing && !out->failed) {
+            size_t limit = (to < len - t->width + 1u) ? to : len - t->width + 1u;
+            size_t count = (limit - off + t->width - 1u) / t->width;
+            size_t room = (out->capacity - out->len) / 16u;
+            if (count > room) count = room;
+            if (count >= 4u) {
+                size_t done = typed_records_avx2(t, data + off, count, (uint32_t)off,
+                                                 (uint32_t)rec, out->data + out->len);
+                out->len += done * 16u;
+                rec += done;
+                continue;
+            }
+        }
+#endif
+        buffer_append_u32_le(out, (uint32_t)off);
+        buffer_append_u32_le(out, (uint32_t)rec);
+        buffer_append_double_le(out, typed_value(t, data + off));
+        if (out->failed) return;
+        if (++field == t->per_record) {
+            rec++;
+            field = 0;
+        }
+    }
+}
+
+/* Typed counterpart of extract_fused_features for a single contiguous input */
+static void extract_typed_features(const typed_layout *t, const uint8_t *data, size_t len,
+                                   rdt_health *health, byte_buffer *numeric,
+                                   uint32_t delims[DELIM_COUNT], uint8_t raw_hash[32]) {
+    rdt_sha256_ctx raw_ctx;
+
+    rdt_sha256_init(&raw_ctx);
+    for (size_t at = 0; at < len; at += FUSED_SLICE_BYTES) {
+        size_t n = (len - at < FUSED_SLICE_BYTES) ? len - at : FUSED_SLICE_BYTES;
+
+        rdt_sha256_update(&raw_ctx, data + at, n);
+        count_delimiters(data + at, n, delims);
+        if (health) rdt_health_feed(health, data + at, n);
+        typed_records(t, data, len, at, at + n, numeric);
+    }
+    rdt_sha256_final(&raw_ctx, raw_hash);
+}
+
+/* ========================================================================== */
+/* Main Extraction Functions                                                  */
+/* ========================================================================== */
+
+/*
+ * Arena layout for one extraction: the pool region followed by an equally
+ * sized mixer temp region. The pool is sized before parsing starts, so it is
+ * never reallocated: POOL_FIXED_BYTES covers the section tags, structure
+ * fingerprint (at most 256 samples) and raw hash, and the numeric section
+ * gets an upper bound on its record bytes.
+ *
+ * Every record holds a digit, and the digits of two records are always
+ * separated by a non-digit, so there are at most (len + 1) / 2 records. Up
+ * to ARENA_BOUND_BYTES of input that bound is used directly; above it,
+ * unless the arena is already large enough, a counting scan (no conversion)
+ * gives a tighter bound.
+ */
+#define POOL_FIXED_BYTES 4096u
+#define ARENA_BOUND_BYTES (256u * 1024u)
+
+static size_t numeric_bytes_bound(size_t data_len) {
+    return (data_len / 2u + 1u) * 16u;
+}
+
+static size_t numeric_bytes_counted(const seed_span *spans, size_t n_spans) {
+    numeric_scanner scanner;
+    byte_buffer count;
+    static const uint8_t none[1];
+
+    numeric_scanner_init(&scanner);
+    buffer_init_sizing(&count);
+    for (size_t k = 0; k < n_spans; k++) {
+        numeric_scanner_feed(&scanner, spans[k].data ? spans[k].data : none,
+                             spans[k].len, 0, &count);
+    }
+    numeric_scanner_feed(&scanner, none, 0, 1, &count);
+    return count.len;
+}
+
+static int arena_reserve(rdt_seed_arena *arena, size_t bytes) {
+    uint8_t *block;
+
+    if (arena->capacity >= bytes) return 0;
+
+    /* The arena holds nothing between calls, so there is nothing to copy */
+    block = (uint8_t *)calloc(1, bytes);
+    if (!block) return -1;
+    free(arena->base);
+    arena->base = block;
+    arena->capacity = bytes;
+    return 0;
+}
+
+/* Hashed ahead of the mixed pool for v1 seeds */
+#define SEEDGEN_V1_DOMAIN "RDT256-SEEDGEN-v1\x00" "StevenReid:RDT256\x00"
+#define SEEDGEN_V1_DOMAIN_BYTES 36u
+
+/*
+ * features: optional precomputed features per span (feature cache).
+ * typed: binary value layout; requires a single span and adds a FORMAT
+ * section to the pool, so typed seeds never collide with text seeds.
+ * The arena's health monitor, if any, is fed during the fused pass; a
+ * failure is checked before the pool is mixed, so no seed is computed.
+ * digest_out = SHA-256(domain || mixed pool).
+ */
+static int extract_pool(rdt_seed_arena *arena, const seed_span *spans, size_t n_spans,
+                        const span_features *features, const typed_layout *typed,
+                        const uint8_t *domain, size_t domain_len, uint8_t digest_out[32]) {
+    size_t data_len = 0;
+    size_t scan_len = 0;
+    size_t cached_bytes = 0;
+    size_t numeric_cap;
+    size_t pool_capacity;
+    size_t numeric_at;
+    uint32_t delims[DELIM_COUNT] = {0};
+    uint8_t raw_hash[32];
+    uint8_t *temp;
+    int result = -1;
+
+    for (size_t k = 0; k < n_spans; k++) {
+        if (!spans[k].data && spans[k].len) return -1;
+        if (spans[k].len > SIZE_MAX - data_len) return -1;
+        data_len += spans[k].len;
+        if (features && features[k].present) {
+            cached_bytes += features[k].n_records * 16u;
+        } else {
+            scan_len += spans[k].len;
+        }
+    }
+    if (data_len == 0) return -1;
+    if (data_len > (SIZE_MAX / 2u - POOL_FIXED_BYTES) / 8u) return -1;
+    if (arena->health && arena->health->failed) return RDT_SEED_ERR_HEALTH;
+
+    if (typed) {
+        if (n_spans != 1) return -1;
+        numeric_cap = typed_value_count(typed, data_len) * 16u;
+    } else if (features) {
+        /*
+         * Cached records are known exactly. Each run of scanned spans between
+         * cached ones obeys the bound on its own, which adds up to at most
+         * (scan_len + n_spans) / 2 records.
+         */
+        numeric_cap = cached_bytes + numeric_bytes_bound(scan_len + n_spans);
+    } else {
+        numeric_cap = numeric_bytes_bound(data_len);
+        if (data_len > ARENA_BOUND_BYTES &&
+            arena->capacity < 2u * (POOL_FIXED_BYTES + numeric_cap)) {
+            numeric_cap = numeric_bytes_counted(spans, n_spans);
+        }
+    }
+    pool_capacity = POOL_FIXED_BYTES + numeric_cap;
+    if (arena_reserve(arena, 2u * pool_capacity) != 0) return -1;
+    temp = arena->base + pool_capacity;
+
+    byte_buffer pool;
+    buffer_borrow(&pool, arena->base, pool_capacity);
+    RDT_STATS_TIMER(stage_ns);
+
+    /* Build entropy pool */
+
+    /* Numeric records go straight into the pool; their length is patched in below */
+    buffer_append(&pool, "NUMERIC:", 8);
+    buffer_append_u32_le(&pool, 0);
+    numeric_at = pool.len;
+    if (typed) {
+        extract_typed_features(typed, spans[0].data, spans[0].len, arena->health, &pool, delims,
+                               raw_hash);
+    } else {
+        extract_fused_features(spans, n_spans, features, arena->health, &pool, delims, raw_hash);
+    }
+    RDT_STATS_LAP(RDT_STAT_SEED_FEATURES_NS, stage_ns);
+    if (pool.failed) goto done;
+    if (arena->health && arena->health->failed) {
+        result = RDT_SEED_ERR_HEALTH;
+        goto done;
+    }
+    {
+        uint32_t numeric_len = (uint32_t)(pool.len - numeric_at);
+        for (int i = 0; i < 4; i++) {
+            pool.data[numeric_at - 4u + (size_t)i] = (uint8_t)(numeric_len >> (i * 8));
+        }
+    }
+
+    /* Structure fingerprint */
+    buffer_append(&pool, "STRUCTURE:", 10);
+    extract_structure_fingerprint(spans, n_spans, data_len, delims, &pool);
+    RDT_STATS_LAP(RDT_STAT_SEED_STRUCTURE_NS, stage_ns);
+
+    /* Raw data hash */
+    buffer_append(&pool, "RAWHASH:", 8);
+    buffer_append(&pool, raw_hash, 32);
+    if (typed) {
+        buffer_append(&pool, "FORMAT:", 7);
+        buffer_append_u32_le(&pool, typed->format);
+        buffer_append_u32_le(&pool, (uint32_t)typed->stride);
+    }
+    if (pool.failed) goto done;
+
+    /* Apply mixing */
+    entropy_precursor_layer(pool.data, pool.len, 256);
+    recursive_entropy_mixer(pool.data, pool.len, 4, temp);
+    RDT_STATS_LAP(RDT_STAT_SEED_MIX_NS, stage_ns);
+
+    /* Final SHA-256 with domain separation */
+    rdt_sha256_ctx ctx;
+    rdt_sha256_init(&ctx);
+    rdt_sha256_update(&ctx, domain, domain_len);
+    rdt_sha256_update(&ctx, pool.data, pool.len);
+    rdt_sha256_final(&ctx, digest_out);
+    RDT_STATS_LAP(RDT_STAT_SEED_HASH_NS, stage_ns);
+    RDT_STATS_ADD(RDT_STAT_SEED_EXTRACTIONS, 1);
+    RDT_STATS_ADD(RDT_STAT_SEED_INPUT_BYTES, data_len);
+    result = 0;
+
+done:
+    /* Leave the arena all-zero for the next call */
+    secure_zero(pool.data, pool.len);
+    secure_zero(temp, pool.len);
+    secure_zero(raw_hash, sizeof(raw_hash));
+    return result;
+}
+
+static int extract_spans(rdt_seed_arena *arena, const seed_span *spans, size_t n_spans,
+                         const span_features *features, const typed_layout *typed,
+                         uint8_t seed_out[32]) {
+    return extract_pool(arena, spans, n_spans, features, typed,
+                        (const uint8_t *)SEEDGEN_V1_DOMAIN, SEEDGEN_V1_DOMAIN_BYTES, seed_out);
+}
+
+void rdt_seed_arena_init(rdt_seed_arena *arena) {
+    if (!arena) return;
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->health = NULL;
+}
+
+void rdt_seed_arena_set_health(rdt_seed_arena *arena, rdt_health *health) {
+    if (arena) arena->health = health;
+}
+
+void rdt_seed_arena_release(rdt_seed_arena *arena) {
+    if (!arena) return;
+    /* Every extraction wipes what it used, so the block is already zero */
+    free(arena->base);
+    arena->base = NULL;
+    arena->capacity = 0;
+}
+
+int rdt_seed_extract_arena(rdt_seed_arena *arena, const uint8_t *data, size_t data_len,
+                           uint8_t seed_out[32]) {
+    seed_span span;
+
+    if (!arena || !data || !seed_out || data_len == 0) return -1;
+
+    span.data = data;
+    span.len = data_len;
+    span.framing = 0;
+    return extract_spans(arena, &span, 1, NULL, NULL, seed_out);
+}
+
+int rdt_seed_extract(const uint8_t *data, size_t data_len, uint8_t seed_out[32]) {
+    rdt_seed_arena arena;
+    int result;
+
+    rdt_seed_arena_init(&arena);
+    result = rdt_seed_extract_arena(&arena, data, data_len, seed_out);
+    rdt_seed_arena_release(&arena);
+    return result;
+}
+
+int rdt_seed_extract_u64(const uint8_t *data, size_t data_len, uint64_t seed_out[4]) {
+    uint8_t seed[32];
+    int result = rdt_seed_extract(data, data_len, seed);
+    if (result != 0) return result;
+
+    /* Little-endian conversion */
+    for (int i = 0; i < 4; i++) {
+        seed_out[i] = 0;
+        for (int j = 0; j < 8; j++) {
+            seed_out[i] |= ((uint64_t)seed[i * 8 + j]) << (j * 8);
+        }
+    }
+
+    return 0;
+}
+
+static int extract_typed(rdt_seed_arena *arena, const uint8_t *data, size_t data_len,
+                         uint32_t format, size_t stride, uint8_t seed_out[32]) {
+    typed_layout layout;
+    seed_span span;
+
+    if (!arena || !data || !seed_out || data_len == 0) return -1;
+    if (format == RDT_SEED_FORMAT_TEXT) {
+        return rdt_seed_extract_arena(arena, data, data_len, seed_out);
+    }
+    if (typed_layout_init(&layout, format, stride) != 0) return -1;
+
+    span.data = data;
+    span.len = data_len;
+    span.framing = 0;
+    return extract_spans(arena, &span, 1, NULL, &layout, seed_out);
+}
+
+int rdt_seed_extract_typed(const uint8_t *data, size_t data_len, uint32_t format,
+                           size_t stride, uint8_t seed_out[32]) {
+    rdt_seed_arena arena;
+    int result;
+
+    rdt_seed_arena_init(&arena);
+    result = extract_typed(&arena, data, data_len, format, stride, seed_out);
+    rdt_seed_arena_release(&arena);
+    return result;
+}
+
+/*
+ * Read-only file mapping. Regular files only; an empty file maps to
+ * (NULL, 0). The file's stat data is kept for the feature cache. Pages are
+ * read in order, so ask for aggressive read-ahead.
+ */
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+    struct stat st;
+} mapped_file;
+
+static int map_file(const char *path, mapped_file *mf) {
+    struct stat st;
+    void *p;
+    int fd;
+
+    mf->data = NULL;
+    mf->len = 0;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+        (uintmax_t)st.st_size > (uintmax_t)SIZE_MAX) {
+        close(fd);
         return -1;
     }
+    mf->st = st;
+    if (st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return -1;
+    (void)madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    mf->data = (const uint8_t *)p;
+    mf->len = (size_t)st.st_size;
+    return 0;
+}
+
+static void unmap_file(mapped_file *mf) {
+    if (mf->len) munmap((void *)(uintptr_t)mf->data, mf->len);
+    mf->data = NULL;
+    mf->len = 0;
+}
+
+int rdt_seed_extract_file_arena(rdt_seed_arena *arena, const char *filepath,
+                                uint8_t seed_out[32]) {
+    mapped_file mf;
+    int result;
+
+    if (!arena || !filepath || !seed_out) return -1;
+    if (map_file(filepath, &mf) != 0) return -1;
+    if (mf.len == 0) return -1;
+
+    result = rdt_seed_extract_arena(arena, mf.data, mf.len, seed_out);
+    unmap_file(&mf);
+    return result;
+}
+
+int rdt_seed_extract_file(const char *filepath, uint8_t seed_out[32]) {
+    rdt_seed_arena arena;
+    int result;
+
+    rdt_seed_arena_init(&arena);
+    result = rdt_seed_extract_file_arena(&arena, filepath, seed_out);
+    rdt_seed_arena_release(&arena);
+    return result;
+}
+
+int rdt_seed_extract_file_typed_arena(rdt_seed_arena *arena, const char *filepath,
+                                      uint32_t format, size_t stride, uint8_t seed_out[32]) {
+    mapped_file mf;
+    int result;
+
+    if (!arena || !filepath || !seed_out) return -1;
+    if (map_file(filepath, &mf) != 0) return -1;
+    if (mf.len == 0) return -1;
+
+    result = extract_typed(arena, mf.data, mf.len, format, stride, seed_out);
+    unmap_file(&mf);
+    return result;
+}
+
+int rdt_seed_extract_file_typed(const char *filepath, uint32_t format, size_t stride,
+                                uint8_t seed_out[32]) {
+    rdt_seed_arena arena;
+    int result;
+
+    rdt_seed_arena_init(&arena);
+    result = rdt_seed_extract_file_typed_arena(&arena, filepath, format, stride, seed_out);
+    rdt_seed_arena_release(&arena);
+    return result;
+}
+
+/*
+ * Each file contributes "FILE:" path "\0" contents "\x1E" to the input
+ * stream. The pieces are passed as spans pointing at the path strings and the
+ * mapped files, so no file contents are copied.
+ */
+#define FILE_SPANS 5u
+
+int rdt_seed_extract_files_arena(rdt_seed_arena *arena, const char **filepaths,
+                                 size_t num_files, uint8_t seed_out[32]) {
+    mapped_file *maps;
+    seed_span *spans;
+    size_t mapped = 0;
+    int result = -1;
+
+    if (!arena || !filepaths || num_files == 0 || !seed_out) return -1;
+    if (num_files > SIZE_MAX / (FILE_SPANS * sizeof(seed_span))) return -1;
+
+    maps = (mapped_file *)calloc(num_files, sizeof(*maps));
+    spans = (seed_span *)malloc(num_files * FILE_SPANS * sizeof(*spans));
+    if (!maps || !spans) goto done;
+
+    for (size_t i = 0; i < num_files; i++) {
+        const char *path = filepaths[i];
+        seed_span *sp = spans + i * FILE_SPANS;
+
+        if (!path || map_file(path, &maps[i]) != 0) goto done;
+        mapped++;
+
+        sp[0].data = (const uint8_t *)"FILE:";
+        sp[0].len = 5;
+        sp[1].data = (const uint8_t *)path;
+        sp[1].len = strlen(path);
+        sp[2].data = (const uint8_t *)"\x00";
+        sp[2].len = 1;
+        sp[3].data = maps[i].data;
+        sp[3].len = maps[i].len;
+        sp[4].data = (const uint8_t *)"\x1E";  /* Record separator */
+        sp[4].len = 1;
+        for (size_t j = 0; j < FILE_SPANS; j++) {
+            sp[j].framing = (j != 3u);
+        }
+    }
+
+    result = extract_spans(arena, spans, num_files * FILE_SPANS, NULL, NULL, seed_out);
+
+done:
+    for (size_t i = 0; i < mapped; i++) {
+        unmap_file(&maps[i]);
+    }
+    free(maps);
+    free(spans);
+    return result;
+}
+
+int rdt_seed_extract_files(const char **filepaths, size_t num_files, uint8_t seed_out[32]) {
+    rdt_seed_arena arena;
+    int result;
+
+    rdt_seed_arena_init(&arena);
+    result = rdt_seed_extract_files_arena(&arena, filepaths, num_files, seed_out);
+    rdt_seed_arena_release(&arena);
+    return result;
+}
+
+/* ========================================================================== */
+/* Tree Mode (RDT256-SEEDGEN-v2)                                              */
+/* ========================================================================== */
+
+/*
+ * Each input is cut into RDT_SEED_V2_LEAF_BYTES leaves. A leaf runs through
+ * the v1 pool pipeline on its own, and its digest is hashed under the leaf
+ * tag and its index. Leaf digests are combined into a Merkle tree shaped as
+ * in RFC 6962 (the left subtree of n leaves holds the largest power of two
+ * below n), and the tree root, the input length and leaf count go into the
+ * final hash.
+ *
+ * Leaves are extracted in windows of TREE_LEAVES_PER_THREAD per thread on
+ * rdt_pool, one arena per worker, and folded in order onto a stack of
+ * complete subtrees, so memory stays fixed however long the input is.
+ */
+#define TREE_LEAVES_PER_THREAD 4u
+#define TREE_MAX_HEIGHT 64u
+
+#define SEEDGEN_V2_DOMAIN "RDT256-SEEDGEN-v2\x00"
+#define SEEDGEN_V2_DOMAIN_BYTES 18u
+#define SEEDGEN_V2_OWNER "StevenReid:RDT256\x00"
+#define SEEDGEN_V2_OWNER_BYTES 18u
+
+/* Node tags, hashed right after SEEDGEN_V2_DOMAIN */
+#define TREE_TAG_LEAF 0x00u
+#define TREE_TAG_NODE 0x01u
+#define TREE_TAG_EMPTY 0x02u
+#define TREE_TAG_ROOT 0x03u
+#define TREE_TAG_FILES 0x04u
+
+static void store_u64_le(uint8_t *p, uint64_t val) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(val >> (i * 8));
+    }
+}
+
+static void sha256_update_u64_le(rdt_sha256_ctx *ctx, uint64_t val) {
+    uint8_t bytes[8];
+    store_u64_le(bytes, val);
+    rdt_sha256_update(ctx, bytes, 8);
+}
+
+static void tree_tagged_init(rdt_sha256_ctx *ctx, uint8_t tag) {
+    rdt_sha256_init(ctx);
+    rdt_sha256_update(ctx, (const uint8_t *)SEEDGEN_V2_DOMAIN, SEEDGEN_V2_DOMAIN_BYTES);
+    rdt_sha256_update(ctx, &tag, 1);
+}
+
+/* out may alias left or right */
+static void tree_node(const uint8_t left[32], const uint8_t right[32], uint8_t out[32]) {
+    rdt_sha256_ctx ctx;
+
+    tree_tagged_init(&ctx, TREE_TAG_NODE);
+    rdt_sha256_update(&ctx, left, 32);
+    rdt_sha256_update(&ctx, right, 32);
+    rdt_sha256_final(&ctx, out);
+}
+
+/* Complete subtrees of decreasing size, one per set bit of the leaf count */
+typedef struct {
+    uint8_t stack[TREE_MAX_HEIGHT][32];
+    size_t depth;
+    uint64_t leaves;
+} tree_fold;
+
+static void tree_fold_init(tree_fold *t) {
+    t->depth = 0;
+    t->leaves = 0;
+}
+
+static void tree_fold_push(tree_fold *t, const uint8_t leaf[32]) {
+    memcpy(t->stack[t->depth++], leaf, 32);
+    t->leaves++;
+    for (uint64_t n = t->leaves; !(n & 1u); n >>= 1) {
+        t->depth--;
+        tree_node(t->stack[t->depth - 1], t->stack[t->depth], t->stack[t->depth - 1]);
+    }
+}
+
+/* Merging the stack right to left gives the RFC 6962 shape */
+static void tree_fold_root(tree_fold *t, uint8_t root[32]) {
+    if (t->depth == 0) {
+        rdt_sha256_ctx ctx;
+        tree_tagged_init(&ctx, TREE_TAG_EMPTY);
+        rdt_sha256_final(&ctx, root);
+        return;
+    }
+    while (t->depth > 1) {
+        t->depth--;
+        tree_node(t->stack[t->depth - 1], t->stack[t->depth], t->stack[t->depth - 1]);
+    }
+    memcpy(root, t->stack[0], 32);
+    secure_zero(t->stack, sizeof(t->stack));
+    t->depth = 0;
+}
+
+/* A leaf of zero bytes stands for an empty input */
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+    uint64_t index;         /* leaf number within its input */
+    size_t input;
+    uint64_t input_len;
+    int last;               /* last leaf of its input */
+    int status;
+    uint8_t digest[32];
+} tree_leaf;
+
+typedef struct {
+    tree_leaf *leaves;
+    rdt_seed_arena *arenas;
+    size_t *free_arenas;
+    size_t n_free;
+    pthread_mutex_t lock;
+} tree_job;
+
+static void tree_leaf_task(void *arg, size_t index) {
+    tree_job *job = (tree_job *)arg;
+    tree_leaf *leaf = &job->leaves[index];
+    uint8_t domain[SEEDGEN_V2_DOMAIN_BYTES + 9u];
+    seed_span span;
+    size_t slot;
+
+    leaf->status = 0;
+    if (!leaf->len) return;
+
+    memcpy(domain, SEEDGEN_V2_DOMAIN, SEEDGEN_V2_DOMAIN_BYTES);
+    domain[SEEDGEN_V2_DOMAIN_BYTES] = TREE_TAG_LEAF;
+    store_u64_le(domain + SEEDGEN_V2_DOMAIN_BYTES + 1u, leaf->index);
+    span.data = leaf->data;
+    span.len = leaf->len;
+    span.framing = 0;
+
+    pthread_mutex_lock(&job->lock);
+    slot = job->free_arenas[--job->n_free];
+    pthread_mutex_unlock(&job->lock);
+
+    leaf->status = extract_pool(&job->arenas[slot], &span, 1, NULL, NULL, domain, sizeof(domain),
+                                leaf->digest);
+
+    pthread_mutex_lock(&job->lock);
+    job->free_arenas[job->n_free++] = slot;
+    pthread_mutex_unlock(&job->lock);
+}
+
+/*
+ * Append (path length, path,) input length, leaf count and tree root of each
+ * input to final, in order. The inputs are either the one buffer data, or
+ * the files in paths, each mapped once its first leaf is reached and
+ * unmapped after its last.
+ */
+static int extract_tree(const uint8_t *data, size_t data_len, const char **paths,
+                        size_t n_inputs, rdt_sha256_ctx *final) {
+    size_t threads = rdt_pool_threads();
+    size_t window = threads * TREE_LEAVES_PER_THREAD;
+    mapped_file *maps;
+    size_t n_maps = 0;
+    const uint8_t *cur = NULL;
+    size_t cur_len = 0, cur_off = 0;
+    uint64_t cur_leaf = 0;
+    int in_input = 0;
+    size_t next = 0;
+    tree_fold fold;
+    tree_job job;
+    int result = 0;
+
+    job.leaves = (tree_leaf *)calloc(window, sizeof(*job.leaves));
+    job.arenas = (rdt_seed_arena *)malloc(threads * sizeof(*job.arenas));
+    job.free_arenas = (size_t *)malloc(threads * sizeof(*job.free_arenas));
+    maps = (mapped_file *)calloc(window + 1u, sizeof(*maps));
+    if (!job.leaves || !job.arenas || !job.free_arenas || !maps) {
+        free(job.leaves);
+        free(job.arenas);
+        free(job.free_arenas);
+        free(maps);
+        return -1;
+    }
+    for (size_t t = 0; t < threads; t++) {
+        rdt_seed_arena_init(&job.arenas[t]);
+        job.free_arenas[t] = t;
+    }
+    job.n_free = threads;
+    pthread_mutex_init(&job.lock, NULL);
+    tree_fold_init(&fold);
+
+    while (result == 0 && (in_input || next < n_inputs)) {
+        size_t count = 0;
+
+        while (count < window && (in_input || next < n_inputs)) {
+            tree_leaf *leaf = &job.leaves[count];
+            size_t n;
+
+            if (!in_input) {
+                if (paths) {
+                    if (!paths[next] || map_file(paths[next], &maps[n_maps]) != 0) {
+                        result = -1;
+                        break;
+                    }
+                    cur = maps[n_maps].data;
+                    cur_len = maps[n_maps].len;
+                    n_maps++;
+                } else {
+                    cur = data;
+                    cur_len = data_len;
+                }
+                cur_off = 0;
+                cur_leaf = 0;
+                in_input = 1;
+                next++;
+            }
+
+            n = (cur_len - cur_off < RDT_SEED_V2_LEAF_BYTES) ? cur_len - cur_off : RDT_SEED_V2_LEAF_BYTES;
+            leaf->data = cur + cur_off;
+            leaf->len = n;
+            leaf->index = cur_leaf++;
+            leaf->input = next - 1u;
+            leaf->input_len = cur_len;
+            cur_off += n;
+            leaf->last = (cur_off == cur_len);
+            in_input = !leaf->last;
+            count++;
+        }
+        if (result != 0) break;
+
+        rdt_pool_run(count, tree_leaf_task, &job);
+
+        for (size_t i = 0; i < count && result == 0; i++) {
+            tree_leaf *leaf = &job.leaves[i];
+            uint64_t leaves;
+            uint8_t root[32];
+
+            if (leaf->status != 0) {
+                result = -1;
+                break;
+            }
+            if (leaf->len) tree_fold_push(&fold, leaf->digest);
+            if (!leaf->last) continue;
+
+            leaves = fold.leaves;
+            tree_fold_root(&fold, root);
+            tree_fold_init(&fold);
+            if (paths) {
+                size_t path_len = strlen(paths[leaf->input]);
+                sha256_update_u64_le(final, (uint64_t)path_len);
+                rdt_sha256_update(final, (const uint8_t *)paths[leaf->input], path_len);
+            }
+            sha256_update_u64_le(final, leaf->input_len);
+            sha256_update_u64_le(final, leaves);
+            rdt_sha256_update(final, root, 32);
+            secure_zero(root, sizeof(root));
+        }
+        secure_zero(job.leaves, window * sizeof(*job.leaves));
+
+        /* Keep only the file whose leaves continue into the next window */
+        for (size_t m = 0; m + (in_input ? 1u : 0u) < n_maps; m++) {
+            unmap_file(&maps[m]);
+        }
+        if (in_input && n_maps) {
+            maps[0] = maps[n_maps - 1u];
+            n_maps = 1;
+        } else {
+            n_maps = 0;
+        }
+    }
+
+    for (size_t m = 0; m < n_maps; m++) {
+        unmap_file(&maps[m]);
+    }
+    secure_zero(&fold, sizeof(fold));
+    for (size_t t = 0; t < threads; t++) {
+        rdt_seed_arena_release(&job.arenas[t]);
+    }
+    pthread_mutex_destroy(&job.lock);
+    free(job.leaves);
+    free(job.arenas);
+    free(job.free_arenas);
+    free(maps);
+    return result;
+}
+
+static void tree_final_init(rdt_sha256_ctx *final, uint8_t tag) {
+    rdt_sha256_init(final);
+    rdt_sha256_update(final, (const uint8_t *)SEEDGEN_V2_DOMAIN, SEEDGEN_V2_DOMAIN_BYTES);
+    rdt_sha256_update(final, (const uint8_t *)SEEDGEN_V2_OWNER, SEEDGEN_V2_OWNER_BYTES);
+    rdt_sha256_update(final, &tag, 1);
+}
+
+int rdt_seed_extract_v2(const uint8_t *data, size_t data_len, uint8_t seed_out[32]) {
+    rdt_sha256_ctx final;
+
+    if (!data || !seed_out || data_len == 0) return -1;
+
+    tree_final_init(&final, TREE_TAG_ROOT);
+    if (extract_tree(data, data_len, NULL, 1u, &final) != 0) return -1;
+    rdt_sha256_final(&final, seed_out);
+    return 0;
+}
+
+int rdt_seed_extract_file_v2(const char *filepath, uint8_t seed_out[32]) {
+    mapped_file mf;
+    int result;
+
+    if (!filepath || !seed_out) return -1;
+    if (map_file(filepath, &mf) != 0) return -1;
+    if (mf.len == 0) return -1;
+
+    result = rdt_seed_extract_v2(mf.data, mf.len, seed_out);
+    unmap_file(&mf);
+    return result;
+}
+
+int rdt_seed_extract_files_v2(const char **filepaths, size_t num_files, uint8_t seed_out[32]) {
+    rdt_sha256_ctx final;
+
+    if (!filepaths || num_files == 0 || !seed_out) return -1;
+
+    tree_final_init(&final, TREE_TAG_FILES);
+    sha256_update_u64_le(&final, (uint64_t)num_files);
+    if (extract_tree(NULL, 0, filepaths, num_files, &final) != 0) return -1;
+    rdt_sha256_final(&final, seed_out);
+    return 0;
+}
+
+/* ========================================================================== */
+/* Feature Cache                                                              */
+/* ========================================================================== */
+
+/*
+ * One entry file per input, named after a hash of its (device, inode) and the
+ * magic, so a format change starts new entries rather than overwriting the
+ * old ones. Each entry holds the file's numeric records (span_features
+ * encoding) and delimiter counts.
+ * Layout, little-endian:
+ *   "RDTSFC2\n"
+ *   device, inode, size, mtime seconds, mtime nanoseconds   5 x u64
+ *   checksum of the full file contents                      u64
+ *   delimiter counts                                        5 x u32
+ *   record count, encoded record bytes                      2 x u64
+ *   encoded records
+ *   checksum of the records, seeded with that of the header u64
+ * An entry is used only if the key, including the content checksum, matches
+ * the file as mapped now and the entry checksum and record encoding are
+ * valid. Anything else is a miss: the file is scanned and the entry rewritten
+ * (write, then rename). Stat data alone would miss edits that keep the size
+ * and land within the mtime granularity, so every hit reads the whole file.
+ */
+#define CACHE_MAGIC "RDTSFC2\n"
+#define CACHE_KEY_BYTES (8u + 6u * 8u)
+#define CACHE_HEADER_BYTES (CACHE_KEY_BYTES + 4u * DELIM_COUNT + 16u)
+#define CACHE_CHECK_BYTES 8u
+
+/*
+ * Entry and content checksum: four independent multiply-rotate lanes over
+ * 64-bit words, folded and finalized. It has to catch torn or corrupted
+ * entries and edited inputs, not deliberate collisions (whoever can write
+ * the input chooses its seed anyway), and runs at memory speed where SHA-256
+ * would cost as much as the rescan it replaces.
+ */
+static uint64_t cache_checksum(const uint8_t *p, size_t len, uint64_t seed) {
+    const uint64_t k1 = 0x9E3779B185EBCA87ULL, k2 = 0xC2B2AE3D27D4EB4FULL;
+    uint64_t lane[4] = {seed + k1, seed ^ k2, seed - k1, ~seed};
+    uint64_t h;
+    size_t i = 0;
+
+    for (; i + 32u <= len; i += 32u) {
+        for (int l = 0; l < 4; l++) {
+            uint64_t w;
+            memcpy(&w, p + i + 8u * (size_t)l, 8);
+            lane[l] += w * k2;
+            lane[l] = ((lane[l] << 31) | (lane[l] >> 33)) * k1;
+        }
+    }
+    h = (uint64_t)len;
+    for (int l = 0; l < 4; l++) {
+        h = (h ^ lane[l]) * k1;
+    }
+    for (; i < len; i++) {
+        h = (h ^ p[i]) * k2;
+        h ^= h >> 29;
+    }
+    h ^= h >> 33;
+    h *= k2;
+    h ^= h >> 29;
+    return h;
+}
+
+static void cache_key(const mapped_file *mf, uint8_t key[CACHE_KEY_BYTES]) {
+    static const uint8_t none[1];
+    byte_buffer b;
+
+    buffer_borrow(&b, key, CACHE_KEY_BYTES);
+    buffer_append(&b, CACHE_MAGIC, 8);
+    buffer_append_u64_le(&b, (uint64_t)mf->st.st_dev);
+    buffer_append_u64_le(&b, (uint64_t)mf->st.st_ino);
+    buffer_append_u64_le(&b, (uint64_t)mf->len);
+    buffer_append_u64_le(&b, (uint64_t)mf->st.st_mtim.tv_sec);
+    buffer_append_u64_le(&b, (uint64_t)mf->st.st_mtim.tv_nsec);
+    buffer_append_u64_le(&b, cache_checksum(mf->data ? mf->data : none, mf->len, (uint64_t)mf->len));
+}
+
+static char *cache_entry_path(const char *dir, const mapped_file *mf) {
+    static const char hex[] = "0123456789abcdef";
+    uint8_t id[16 + 8];
+    uint8_t digest[32];
+    size_t dir_len = strlen(dir);
+    char *path;
+    rdt_sha256_ctx ctx;
+
+    for (int i = 0; i < 8; i++) {
+        id[i] = (uint8_t)((uint64_t)mf->st.st_dev >> (i * 8));
+        id[8 + i] = (uint8_t)((uint64_t)mf->st.st_ino >> (i * 8));
+    }
+    memcpy(id + 16, CACHE_MAGIC, 8);
+    rdt_sha256_init(&ctx);
+    rdt_sha256_update(&ctx, id, sizeof(id));
+    rdt_sha256_final(&ctx, digest);
+
+    path = (char *)malloc(dir_len + 1u + 32u + 4u + 1u);
+    if (!path) return NULL;
+    memcpy(path, dir, dir_len);
+    path[dir_len] = '/';
+    for (int i = 0; i < 16; i++) {
+        path[dir_len + 1u + 2u * (size_t)i] = hex[digest[i] >> 4];
+        path[dir_len + 2u + 2u * (size_t)i] = hex[digest[i] & 15u];
+    }
+    memcpy(path + dir_len + 33u, ".rsf", 5);
+    return path;
+}
+
+static uint64_t load_u64_le(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+/* Check that records holds exactly n well-formed encoded records */
+static int cache_records_valid(const uint8_t *p, size_t len, uint64_t n) {
+    size_t at = 0;
+
+    for (uint64_t r = 0; r < n; r++) {
+        uint32_t d;
+        size_t used = read_varint32(p + at, len - at, &d);
+        if (!used) return 0;
+        at += used;
+        used = read_varint32(p + at, len - at, &d);
+        if (!used) return 0;
+        at += used;
+        if (len - at < 8u) return 0;
+        at += 8u;
+    }
+    return at == len;
+}
+
+/* On success f points into entry, which the caller unmaps after extraction */
+static int cache_load(const char *path, const uint8_t key[CACHE_KEY_BYTES],
+                      mapped_file *entry, span_features *f) {
+    const uint8_t *p;
+    uint64_t n, records_len;
+
+    if (map_file(path, entry) != 0) return -1;
+    p = entry->data;
+    if (entry->len < CACHE_HEADER_BYTES + CACHE_CHECK_BYTES ||
+        memcmp(p, key, CACHE_KEY_BYTES) != 0) {
+        unmap_file(entry);
+        return -1;
+    }
+    n = load_u64_le(p + CACHE_KEY_BYTES + 4u * DELIM_COUNT);
+    records_len = load_u64_le(p + CACHE_KEY_BYTES + 4u * DELIM_COUNT + 8u);
+    if (records_len != entry->len - CACHE_HEADER_BYTES - CACHE_CHECK_BYTES ||
+        n > records_len / 10u) {
+        unmap_file(entry);
+        return -1;
+    }
+
+    if (cache_checksum(p + CACHE_HEADER_BYTES, (size_t)records_len,
+                       cache_checksum(p, CACHE_HEADER_BYTES, 0)) !=
+            load_u64_le(p + entry->len - CACHE_CHECK_BYTES) ||
+        !cache_records_valid(p + CACHE_HEADER_BYTES, (size_t)records_len, n)) {
+        unmap_file(entry);
+        return -1;
+    }
+
+    for (int d = 0; d < DELIM_COUNT; d++) {
+        const uint8_t *c = p + CACHE_KEY_BYTES + 4u * (size_t)d;
+        f->delims[d] = (uint32_t)c[0] | ((uint32_t)c[1] << 8) |
+                       ((uint32_t)c[2] << 16) | ((uint32_t)c[3] << 24);
+    }
+    f->records = p + CACHE_HEADER_BYTES;
+    f->records_len = (size_t)records_len;
+    f->n_records = (size_t)n;
+    f->present = 1;
+    return 0;
+}
+
+static void append_varint32(byte_buffer *b, uint32_t v) {
+    uint8_t tmp[5];
+    size_t n = 0;
+
+    while (v >= 0x80u) {
+        tmp[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    tmp[n++] = (uint8_t)v;
+    buffer_append(b, tmp, n);
+}
+
+/* Scan the file on its own and encode its features; *blob owns f->records */
+static int cache_build(const mapped_file *mf, span_features *f, byte_buffer *blob) {
+    static const uint8_t none[1];
+    numeric_scanner scanner;
+    byte_buffer recs;
+    uint32_t pos = 0, line = 0;
+
+    memset(f->delims, 0, sizeof(f->delims));
+    count_delimiters(mf->data ? mf->data : none, mf->len, f->delims);
+
+    buffer_init(&recs, mf->len / 4u);
+    numeric_scanner_init(&scanner);
+    numeric_scanner_feed(&scanner, mf->data ? mf->data : none, mf->len, 1, &recs);
+
+    buffer_init(blob, recs.len / 2u);
+    for (size_t at = 0; at + 16u <= recs.len; at += 16u) {
+        const uint8_t *r = recs.data + at;
+        uint32_t rp = (uint32_t)load_u64_le(r) & 0xFFFFFFFFu;
+        uint32_t rl = (uint32_t)(load_u64_le(r) >> 32);
+
+        append_varint32(blob, rp - pos);
+        append_varint32(blob, rl - line);
+        buffer_append(blob, r + 8, 8);
+        pos = rp;
+        line = rl;
+    }
+    if (recs.failed || blob->failed) {
+        buffer_free(&recs);
+        buffer_free(blob);
+        return -1;
+    }
+
+    f->records = blob->data;
+    f->records_len = blob->len;
+    f->n_records = recs.len / 16u;
+    f->present = 1;
+    buffer_free(&recs);
+    return 0;
+}
+
+/* Best effort: a cache that cannot be written only costs the next run a rescan */
+static void cache_store(const char *path, const uint8_t key[CACHE_KEY_BYTES],
+                        const span_features *f) {
+    uint8_t header[CACHE_HEADER_BYTES];
+    uint8_t check[CACHE_CHECK_BYTES];
+    uint64_t sum;
+    byte_buffer b;
+    size_t path_len = strlen(path);
+    char *tmp = (char *)malloc(path_len + 48u);
+    FILE *out;
+    int ok;
+
+    if (!tmp) return;
+    /* pid and a stack address tell concurrent writers apart, across and within processes */
+    snprintf(tmp, path_len + 48u, "%s.%ld.%lx.tmp", path, (long)getpid(),
+             (unsigned long)(uintptr_t)header);
+
+    buffer_borrow(&b, header, sizeof(header));
+    buffer_append(&b, key, CACHE_KEY_BYTES);
+    for (int d = 0; d < DELIM_COUNT; d++) {
+        buffer_append_u32_le(&b, f->delims[d]);
+    }
+    buffer_append_u64_le(&b, (uint64_t)f->n_records);
+    buffer_append_u64_le(&b, (uint64_t)f->records_len);
+
+    sum = cache_checksum(f->records, f->records_len, cache_checksum(header, sizeof(header), 0));
+    for (int i = 0; i < 8; i++) {
+        check[i] = (uint8_t)(sum >> (i * 8));
+    }
+
+    out = fopen(tmp, "wb");
+    if (!out) {
+        free(tmp);
+        return;
+    }
+    ok = fwrite(header, 1, sizeof(header), out) == sizeof(header) &&
+         fwrite(f->records, 1, f->records_len, out) == f->records_len &&
+         fwrite(check, 1, sizeof(check), out) == sizeof(check);
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || rename(tmp, path) != 0) {
+        (void)unlink(tmp);
+    }
+    free(tmp);
+}
+
+/*
+ * framed = 1: the rdt_seed_extract_files stream, FILE_SPANS spans per file;
+ * framed = 0: a single file on its own, as rdt_seed_extract_file. Either way
+ * every file's contents sit between bytes that cannot continue a number, so
+ * its cached features replay exactly.
+ */
+static int extract_cached(const char *cache_dir, const char **filepaths, size_t num_files,
+                          int framed, uint8_t seed_out[32]) {
+    size_t per_file = framed ? FILE_SPANS : 1u;
+    mapped_file *maps;
+    mapped_file *entries;
+    byte_buffer *blobs;
+    seed_span *spans;
+    span_features *features;
+    size_t mapped = 0;
+    int result = -1;
+
+    if (!cache_dir || !filepaths || num_files == 0 || !seed_out) return -1;
+    if (num_files > SIZE_MAX / (FILE_SPANS * (sizeof(seed_span) + sizeof(span_features)))) {
+        return -1;
+    }
+
+    maps = (mapped_file *)calloc(num_files, sizeof(*maps));
+    entries = (mapped_file *)calloc(num_files, sizeof(*entries));
+    blobs = (byte_buffer *)calloc(num_files, sizeof(*blobs));
+    spans = (seed_span *)malloc(num_files * per_file * sizeof(*spans));
+    features = (span_features *)calloc(num_files * per_file, sizeof(*features));
+    if (!maps || !entries || !blobs || !spans || !features) goto done;
+
+    for (size_t i = 0; i < num_files; i++) {
+        const char *path = filepaths[i];
+        seed_span *sp = spans + i * per_file;
+        span_features *f = features + i * per_file + (framed ? 3u : 0u);
+        uint8_t key[CACHE_KEY_BYTES];
+        char *entry_path;
+
+        if (!path || map_file(path, &maps[i]) != 0) goto done;
+        mapped++;
+        if (!framed && maps[i].len == 0) goto done;
+
+        cache_key(&maps[i], key);
+        entry_path = cache_entry_path(cache_dir, &maps[i]);
+        if (!entry_path) goto done;
+        if (cache_load(entry_path, key, &entries[i], f) != 0) {
+            if (cache_build(&maps[i], f, &blobs[i]) != 0) {
+                free(entry_path);
+                goto done;
+            }
+            cache_store(entry_path, key, f);
+        }
+        free(entry_path);
+
+        if (framed) {
+            sp[0].data = (const uint8_t *)"FILE:";
+            sp[0].len = 5;
+            sp[1].data = (const uint8_t *)path;
+            sp[1].len = strlen(path);
+            sp[2].data = (const uint8_t *)"\x00";
+            sp[2].len = 1;
+            sp[3].data = maps[i].data;
+            sp[3].len = maps[i].len;
+            sp[4].data = (const uint8_t *)"\x1E";  /* Record separator */
+            sp[4].len = 1;
+            for (size_t j = 0; j < FILE_SPANS; j++) {
+                sp[j].framing = (j != 3u);
+            }
+        } else {
+            sp[0].data = maps[i].data;
+            sp[0].len = maps[i].len;
+            sp[0].framing = 0;
+        }
+    }
+
+    {
+        rdt_seed_arena arena;
+
+        rdt_seed_arena_init(&arena);
+        result = extract_spans(&arena, spans, num_files * per_file, features, NULL, seed_out);
+        rdt_seed_arena_release(&arena);
+    }
+
+done:
+    for (size_t i = 0; i < mapped; i++) {
+        unmap_file(&maps[i]);
+        unmap_file(&entries[i]);
+        if (blobs[i].data) buffer_free(&blobs[i]);
+    }
+    free(maps);
+    free(entries);
+    free(blobs);
+    free(spans);
+    free(features);
+    return result;
+}
+
+int rdt_seed_extract_file_cached(const char *cache_dir, const char *filepath,
+                                 uint8_t seed_out[32]) {
+    if (!filepath) return -1;
+    return extract_cached(cache_dir, &filepath, 1, 0, seed_out);
+}
+
+int rdt_seed_extract_files_cached(const char *cache_dir, const char **filepaths,
+                                  size_t num_files, uint8_t seed_out[32]) {
+    return extract_cached(cache_dir, filepaths, num_files, 1, seed_out);
+}
+
+/* ========================================================================== */
+/* Streaming Extraction                                                       */
+/* ========================================================================== */
+
+#define STREAM_SLICE_BYTES 4096u
+#define STREAM_SAMPLES 256u
+#define STREAM_FIRST_STRIDE 4u
+/* Room after a partial record block for the structure and raw-hash trailer */
+#define STREAM_TRAILER_BYTES 4096u
+#define STREAM_WORK_BYTES (RDT_SEED_STREAM_BLOCK_BYTES + STREAM_TRAILER_BYTES)
+
+typedef struct {
+    uint64_t pos;
+    uint8_t bytes[4];
+} stream_sample;
+
+typedef struct {
+    int failed;
+    int finished;
+    rdt_health *health;
+    rdt_sha256_ctx raw;
+    rdt_sha256_ctx chain;
+    numeric_scanner scanner;
+    byte_buffer records;            /* records from one slice, reused */
+    uint64_t total_len;
+    uint64_t numeric_bytes;
+    uint32_t delims[DELIM_COUNT];
+    uint64_t sample_stride;
+    uint64_t next_sample;
+    size_t n_samples;
+    stream_sample samples[STREAM_SAMPLES];
+    size_t block_len;
+    uint8_t block[STREAM_WORK_BYTES];
+    uint8_t temp[STREAM_WORK_BYTES];
+} stream_state;
+
+static void stream_fill_sample(stream_sample *sm, const uint8_t *data, size_t len, uint64_t off) {
+    uint64_t from = (sm->pos > off) ? sm->pos : off;
+    uint64_t to = (sm->pos + 4u < off + len) ? sm->pos + 4u : off + len;
+
+    for (uint64_t p = from; p < to; p++) {
+        sm->bytes[p - sm->pos] = data[p - off];
+    }
+}
+
+/*
+ * Samples sit at multiples of sample_stride. When all STREAM_SAMPLES slots are
+ * used, every other sample is dropped and the stride doubles, so the kept
+ * positions depend only on the total length.
+ */
+static void stream_sample_bytes(stream_state *st, const uint8_t *data, size_t len, uint64_t off) {
+    if (st->n_samples) {
+        stream_fill_sample(&st->samples[st->n_samples - 1], data, len, off);
+    }
+    while (st->next_sample < off + len) {
+        stream_sample *sm;
+
+        if (st->n_samples == STREAM_SAMPLES) {
+            size_t kept = 0;
+            for (size_t i = 0; i < st->n_samples; i++) {
+                if ((st->samples[i].pos / st->sample_stride) % 2u == 0) {
+                    st->samples[kept++] = st->samples[i];
+                }
+            }
+            st->n_samples = kept;
+            st->sample_stride *= 2u;
+        }
+        sm = &st->samples[st->n_samples++];
+        sm->pos = st->next_sample;
+        memset(sm->bytes, 0, sizeof(sm->bytes));
+        stream_fill_sample(sm, data, len, off);
+        st->next_sample += st->sample_stride;
+    }
+}
 
-    size_t read = fread(data, 1, (size_t)size, f);
-    fclose(f);
+static void stream_mix_block(stream_state *st, size_t len) {
+    entropy_precursor_layer(st->block, len, 256);
+    recursive_entropy_mixer_impl(st->block, len, 4, st->temp);
+    rdt_sha256_update(&st->chain, st->block, len);
+}
 
-    if (read != (size_t)size) {
-        free(data);
-        return -1;
+static void stream_add_records(stream_state *st, const uint8_t *rec, size_t len) {
+    st->numeric_bytes += len;
+    while (len) {
+        size_t take = RDT_SEED_STREAM_BLOCK_BYTES - st->block_len;
+        if (take > len) take = len;
+        memcpy(st->block + st->block_len, rec, take);
+        st->block_len += take;
+        rec += take;
+        len -= take;
+        if (st->block_len == RDT_SEED_STREAM_BLOCK_BYTES) {
+            stream_mix_block(st, st->block_len);
+            st->block_len = 0;
+        }
     }
+}
 
-    int result = rdt_seed_extract(data, read, seed_out);
-    free(data);
-    return result;
+static void stream_put(stream_state *st, const void *data, size_t len) {
+    memcpy(st->block + st->block_len, data, len);
+    st->block_len += len;
 }
 
-int rdt_seed_extract_files(const char **filepaths, size_t num_files, uint8_t seed_out[32]) {
-    byte_buffer combined;
-    if (!filepaths || num_files == 0 || !seed_out) return -1;
-    buffer_init(&combined, 4096u);
+static void stream_put_u32_le(stream_state *st, uint32_t val) {
+    uint8_t bytes[4] = {
+        (uint8_t)(val), (uint8_t)(val >> 8), (uint8_t)(val >> 16), (uint8_t)(val >> 24)
+    };
+    stream_put(st, bytes, 4);
+}
 
-    if (!combined.data) return -1;
+static void stream_put_u64_le(stream_state *st, uint64_t val) {
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (uint8_t)(val >> (i * 8));
+    }
+    stream_put(st, bytes, 8);
+}
 
-    for (size_t i = 0; i < num_files; i++) {
-        const char *path = filepaths[i];
+/* Scanner output for one slice goes through st->records, then into blocks */
+static int stream_scan(stream_state *st, const uint8_t *data, size_t len, int final) {
+    st->records.len = 0;
+    numeric_scanner_feed(&st->scanner, data, len, final, &st->records);
+    if (st->records.failed) return -1;
+    stream_add_records(st, st->records.data, st->records.len);
+    return 0;
+}
 
-        /* Add file marker */
-        buffer_append(&combined, "FILE:", 5);
-        buffer_append(&combined, path, strlen(path));
-        buffer_append(&combined, "\x00", 1);
+int rdt_seed_extractor_init(rdt_seed_extractor_ctx *ctx, uint32_t version) {
+    stream_state *st;
 
-        /* Read file */
-        FILE *f = fopen(path, "rb");
-        if (!f) {
-            buffer_free(&combined);
-            return -1;
-        }
+    if (!ctx) return -1;
+    ctx->version = 0;
+    ctx->state = NULL;
+    if (version != RDT_SEED_STREAM_V1) return -1;
 
-        if (fseek(f, 0, SEEK_END) != 0) {
-            fclose(f);
-            buffer_free(&combined);
-            return -1;
-        }
-        long size = ftell(f);
-        if (size < 0 || fseek(f, 0, SEEK_SET) != 0) {
-            fclose(f);
-            buffer_free(&combined);
-            return -1;
-        }
+    st = (stream_state *)calloc(1, sizeof(*st));
+    if (!st) return -1;
+    buffer_init(&st->records, STREAM_SLICE_BYTES * 9u);
+    if (st->records.failed) {
+        free(st);
+        return -1;
+    }
+    rdt_sha256_init(&st->raw);
+    rdt_sha256_init(&st->chain);
+    numeric_scanner_init(&st->scanner);
+    st->sample_stride = STREAM_FIRST_STRIDE;
 
-        if (size < 0 || size > 100 * 1024 * 1024) {  /* Max 100 MB per file */
-            fclose(f);
-            buffer_free(&combined);
+    ctx->version = version;
+    ctx->state = st;
+    return 0;
+}
+
+int rdt_seed_extractor_update(rdt_seed_extractor_ctx *ctx, const uint8_t *data, size_t len) {
+    stream_state *st;
+
+    if (!ctx || !ctx->state || (!data && len)) return -1;
+    st = (stream_state *)ctx->state;
+    if (st->failed || st->finished) return -1;
+
+    while (len) {
+        size_t n = (len < STREAM_SLICE_BYTES) ? len : STREAM_SLICE_BYTES;
+
+        rdt_sha256_update(&st->raw, data, n);
+        count_delimiters(data, n, st->delims);
+        if (st->health) rdt_health_feed(st->health, data, n);
+        stream_sample_bytes(st, data, n, st->total_len);
+        if (stream_scan(st, data, n, 0) != 0) {
+            st->failed = 1;
             return -1;
         }
+        st->total_len += n;
+        data += n;
+        len -= n;
+    }
+    return (st->health && st->health->failed) ? RDT_SEED_ERR_HEALTH : 0;
+}
 
-        if (size > 0) {
-            uint8_t *data = (uint8_t *)malloc((size_t)size);
-            if (!data) {
-                fclose(f);
-                buffer_free(&combined);
-                return -1;
-            }
-            size_t bytes_read = fread(data, 1, (size_t)size, f);
-            if (bytes_read != (size_t)size) {
-                free(data);
-                fclose(f);
-                buffer_free(&combined);
-                return -1;
-            }
-            buffer_append(&combined, data, bytes_read);
-            free(data);
-        }
+int rdt_seed_extractor_update_fd(rdt_seed_extractor_ctx *ctx, int fd) {
+    uint8_t buf[16384];
+    int rc;
 
-        fclose(f);
-        buffer_append(&combined, "\x1E", 1);  /* Record separator */
-        if (combined.failed) {
-            buffer_free(&combined);
+    if (!ctx || !ctx->state || fd < 0) return -1;
+    for (;;) {
+        ssize_t got = read(fd, buf, sizeof(buf));
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            ((stream_state *)ctx->state)->failed = 1;
             return -1;
         }
+        if (got == 0) return 0;
+        rc = rdt_seed_extractor_update(ctx, buf, (size_t)got);
+        if (rc != 0) return rc;
     }
+}
 
-    int result = rdt_seed_extract(combined.data, combined.len, seed_out);
-    buffer_free(&combined);
-    return result;
+int rdt_seed_extractor_set_health(rdt_seed_extractor_ctx *ctx, rdt_health *health) {
+    if (!ctx || !ctx->state) return -1;
+    ((stream_state *)ctx->state)->health = health;
+    return 0;
+}
+
+void rdt_seed_extractor_abort(rdt_seed_extractor_ctx *ctx) {
+    stream_state *st;
+
+    if (!ctx || !ctx->state) return;
+    st = (stream_state *)ctx->state;
+    buffer_free(&st->records);
+    secure_zero(st, sizeof(*st));
+    free(st);
+    ctx->state = NULL;
+    ctx->version = 0;
+}
+
+/* Flush, append the trailer and hash. Consumes st: it cannot take more input. */
+static int stream_finish(stream_state *st, uint8_t seed_out[32]) {
+    uint8_t raw_hash[32];
+    uint8_t chain_hash[32];
+    uint8_t tail[16];
+    rdt_sha256_ctx fin;
+
+    /* Flush numbers waiting for lookahead at the very end of the input */
+    if (stream_scan(st, NULL, 0, 1) != 0) return -1;
+
+    /* Trailer after the last partial record block */
+    stream_put(st, "STRUCTURE:", 10);
+    stream_put_u64_le(st, st->total_len);
+    for (int d = 0; d < DELIM_COUNT; d++) {
+        stream_put_u32_le(st, st->delims[d]);
+    }
+    stream_put_u32_le(st, (uint32_t)st->n_samples);
+    for (size_t i = 0; i < st->n_samples; i++) {
+        stream_put_u32_le(st, (uint32_t)st->samples[i].pos);
+        stream_put(st, st->samples[i].bytes, 4);
+    }
+    rdt_sha256_final(&st->raw, raw_hash);
+    stream_put(st, "RAWHASH:", 8);
+    stream_put(st, raw_hash, 32);
+    stream_mix_block(st, st->block_len);
+    rdt_sha256_final(&st->chain, chain_hash);
+
+    for (int i = 0; i < 8; i++) {
+        tail[i] = (uint8_t)(st->total_len >> (i * 8));
+        tail[8 + i] = (uint8_t)(st->numeric_bytes >> (i * 8));
+    }
+    rdt_sha256_init(&fin);
+    rdt_sha256_update(&fin, (const uint8_t *)"RDT256-SEEDSTREAM-v1\x00", 21);
+    rdt_sha256_update(&fin, (const uint8_t *)"StevenReid:RDT256\x00", 18);
+    rdt_sha256_update(&fin, tail, sizeof(tail));
+    rdt_sha256_update(&fin, chain_hash, sizeof(chain_hash));
+    rdt_sha256_final(&fin, seed_out);
+
+    secure_zero(raw_hash, sizeof(raw_hash));
+    secure_zero(chain_hash, sizeof(chain_hash));
+    secure_zero(&fin, sizeof(fin));
+    return 0;
+}
+
+int rdt_seed_extractor_final(rdt_seed_extractor_ctx *ctx, uint8_t seed_out[32]) {
+    stream_state *st;
+    int rc = -1;
+
+    if (!ctx || !ctx->state || !seed_out) return -1;
+    st = (stream_state *)ctx->state;
+    if (st->health && st->health->failed) {
+        rc = RDT_SEED_ERR_HEALTH;
+    } else if (!st->failed && !st->finished) {
+        st->finished = 1;
+        rc = stream_finish(st, seed_out);
+    }
+    rdt_seed_extractor_abort(ctx);
+    return rc;
+}
+
+/*
+ * Finishing mutates the scanner, sample and block state, so it runs on a
+ * copy. Only the copy's slice record buffer is fresh: the live one is empty
+ * between updates.
+ */
+int rdt_seed_extractor_peek(const rdt_seed_extractor_ctx *ctx, uint8_t seed_out[32]) {
+    const stream_state *st;
+    stream_state *copy;
+    int rc;
+
+    if (!ctx || !ctx->state || !seed_out) return -1;
+    st = (const stream_state *)ctx->state;
+    if (st->failed || st->finished) return -1;
+    if (st->health && st->health->failed) return RDT_SEED_ERR_HEALTH;
+
+    copy = (stream_state *)malloc(sizeof(*copy));
+    if (!copy) return -1;
+    memcpy(copy, st, sizeof(*copy));
+    buffer_init(&copy->records, STREAM_SLICE_BYTES * 9u);
+    rc = copy->records.failed ? -1 : stream_finish(copy, seed_out);
+    buffer_free(&copy->records);
+    secure_zero(copy, sizeof(*copy));
+    free(copy);
+    return rc;
 }
 
 /* ========================================================================== */
@@ -701,21 +2850,557 @@ int rdt_seed_extract_files(const char **filepaths, size_t num_files, uint8_t see
 
 #ifdef RDT_SEED_EXTRACTOR_MAIN
 
+#include <dirent.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+
 static void print_hex(const uint8_t *data, size_t len) {
     for (size_t i = 0; i < len; i++) {
         printf("%02x", data[i]);
     }
 }
 
+/* Exit status when a health test blocks the seed */
+#define EXIT_HEALTH 3
+
+static unsigned format_sample_bytes(uint32_t format) {
+    switch (format) {
+        case RDT_SEED_FORMAT_I16LE: return 2u;
+        case RDT_SEED_FORMAT_I32LE:
+        case RDT_SEED_FORMAT_F32LE: return 4u;
+        case RDT_SEED_FORMAT_F64LE: return 8u;
+        default: return 1u;
+    }
+}
+
+static void report_health(const char *input, const rdt_health *health) {
+    fprintf(stderr, "Error: Health test failed on %s (%llu samples, %llu RCT and %llu APT failures)\n",
+            input, (unsigned long long)health->samples,
+            (unsigned long long)health->rct_failures, (unsigned long long)health->apt_failures);
+}
+
 static void print_usage(const char *prog) {
     fprintf(stderr, "RDT Seed Extractor\n");
     fprintf(stderr, "Author: Steven Reid (ORCID: 0009-0003-9132-3410)\n\n");
-    fprintf(stderr, "Usage: %s [options] <file1> [file2] ...\n\n", prog);
+    fprintf(stderr, "Usage: %s [options] <file1> [file2] ...\n", prog);
+    fprintf(stderr, "       %s --each [-j N] [--from-list FILE] [path ...]\n", prog);
+    fprintf(stderr, "       %s --follow [--every BYTES] [--interval SECONDS] <file|->\n\n", prog);
+    fprintf(stderr, "A single input of - reads standard input.\n\n");
     fprintf(stderr, "Options:\n");
     fprintf(stderr, "  -h, --help      Show this help\n");
     fprintf(stderr, "  -c              Output in C format\n");
     fprintf(stderr, "  -u              Output as 4 x uint64_t\n");
     fprintf(stderr, "  -b              Output raw bytes (binary)\n");
+    fprintf(stderr, "  --cache DIR     Keep parsed features of unchanged files in DIR\n");
+    fprintf(stderr, "  --v2            Tree-parallel RDT256-SEEDGEN-v2 seeds (text input;\n");
+    fprintf(stderr, "                  differ from the default v1 seeds)\n");
+    fprintf(stderr, "  --format F      Input format: text (default), i16le, i32le, f32le, f64le\n");
+    fprintf(stderr, "  --stride N      Bytes per binary record (default: one value)\n");
+    fprintf(stderr, "  --health H      Run SP 800-90B RCT/APT health tests on the input,\n");
+    fprintf(stderr, "                  claiming H bits of min-entropy per sample (a byte, or\n");
+    fprintf(stderr, "                  one value with --format); no seed is printed and the\n");
+    fprintf(stderr, "                  exit status is 3 if a test fails\n\n");
+    fprintf(stderr, "Batch mode (one seed per file, printed as path<TAB>hex in input order):\n");
+    fprintf(stderr, "  --each          Extract a separate seed for every input file;\n");
+    fprintf(stderr, "                  directories are walked recursively in name order\n");
+    fprintf(stderr, "  --from-list F   Read input paths from F, one per line (- for stdin);\n");
+    fprintf(stderr, "                  implies --each\n");
+    fprintf(stderr, "  -j N            Worker threads (default: online CPUs)\n\n");
+    fprintf(stderr, "Follow mode (streaming v1 seeds while the input grows, one per line):\n");
+    fprintf(stderr, "  --follow        Keep reading a growing file or pipe\n");
+    fprintf(stderr, "  --every N       Emit a seed after every N bytes of input\n");
+    fprintf(stderr, "  --interval T    Emit a seed every T seconds if new data arrived\n");
+    fprintf(stderr, "                  (default when --every is not given: 1)\n");
+}
+
+/* ========================================================================== */
+/* Batch Mode                                                                 */
+/* ========================================================================== */
+
+typedef struct {
+    char **items;
+    size_t len;
+    size_t capacity;
+} path_list;
+
+static int path_list_add(path_list *pl, const char *path) {
+    char *copy;
+
+    if (pl->len == pl->capacity) {
+        size_t cap = pl->capacity ? pl->capacity * 2u : 256u;
+        char **items = (char **)realloc(pl->items, cap * sizeof(*items));
+        if (!items) {
+            fprintf(stderr, "Error: Out of memory\n");
+            return -1;
+        }
+        pl->items = items;
+        pl->capacity = cap;
+    }
+    copy = strdup(path);
+    if (!copy) {
+        fprintf(stderr, "Error: Out of memory\n");
+        return -1;
+    }
+    pl->items[pl->len++] = copy;
+    return 0;
+}
+
+static void path_list_free(path_list *pl) {
+    for (size_t i = 0; i < pl->len; i++) {
+        free(pl->items[i]);
+    }
+    free(pl->items);
+    pl->items = NULL;
+    pl->len = pl->capacity = 0;
+}
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/*
+ * Add every regular file below dir, visiting entries in strcmp order so the
+ * output does not depend on the file system's directory order. Symbolic
+ * links found inside the tree are not followed.
+ */
+static int collect_dir(path_list *pl, const char *dir) {
+    path_list names = {0};
+    struct dirent *ent;
+    DIR *d;
+    int result = 0;
+
+    d = opendir(dir);
+    if (!d) {
+        fprintf(stderr, "Error: Cannot read directory %s: %s\n", dir, strerror(errno));
+        return -1;
+    }
+    while ((ent = readdir(d)) != NULL) {
+        if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0) continue;
+        if (path_list_add(&names, ent->d_name) != 0) {
+            result = -1;
+            break;
+        }
+    }
+    closedir(d);
+
+    if (result == 0 && names.len) {
+        size_t dir_len = strlen(dir);
+        int slash = (dir_len && dir[dir_len - 1] == '/');
+
+        qsort(names.items, names.len, sizeof(*names.items), compare_names);
+        for (size_t i = 0; i < names.len && result == 0; i++) {
+            size_t name_len = strlen(names.items[i]);
+            char *child = (char *)malloc(dir_len + name_len + 2u);
+            struct stat st;
+
+            if (!child) {
+                fprintf(stderr, "Error: Out of memory\n");
+                result = -1;
+                break;
+            }
+            memcpy(child, dir, dir_len);
+            if (!slash) child[dir_len] = '/';
+            memcpy(child + dir_len + (slash ? 0u : 1u), names.items[i], name_len + 1u);
+
+            if (lstat(child, &st) == 0) {
+                if (S_ISDIR(st.st_mode)) {
+                    result = collect_dir(pl, child);
+                } else if (S_ISREG(st.st_mode)) {
+                    result = path_list_add(pl, child);
+                }
+            }
+            free(child);
+        }
+    }
+    path_list_free(&names);
+    return result;
+}
+
+/* Named directories are expanded; anything else is left for extraction to report. */
+static int collect_path(path_list *pl, const char *path) {
+    struct stat st;
+
+    if (stat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+        return collect_dir(pl, path);
+    }
+    return path_list_add(pl, path);
+}
+
+static int collect_list_file(path_list *pl, const char *list_path) {
+    FILE *f = (strcmp(list_path, "-") == 0) ? stdin : fopen(list_path, "r");
+    char *line = NULL;
+    size_t line_cap = 0;
+    ssize_t n;
+    int result = 0;
+
+    if (!f) {
+        fprintf(stderr, "Error: Cannot open list %s: %s\n", list_path, strerror(errno));
+        return -1;
+    }
+    while (result == 0 && (n = getline(&line, &line_cap, f)) >= 0) {
+        while (n > 0 && (line[n - 1] == '\n' || line[n - 1] == '\r')) {
+            line[--n] = '\0';
+        }
+        if (n == 0) continue;
+        result = collect_path(pl, line);
+    }
+    if (result == 0 && ferror(f)) {
+        fprintf(stderr, "Error: Failed to read list %s\n", list_path);
+        result = -1;
+    }
+    free(line);
+    if (f != stdin) fclose(f);
+    return result;
+}
+
+/*
+ * Files are extracted in windows of BATCH_FILES_PER_THREAD per thread; each
+ * window runs on rdt_pool with one arena per thread and its results are
+ * printed in input order before the next window starts, so at most one
+ * window of files is mapped and one arena per thread is held at a time.
+ * The next window's files are handed to the kernel for read-ahead before the
+ * current window is processed, overlapping disk reads with extraction.
+ */
+#define BATCH_FILES_PER_THREAD 4u
+
+typedef struct {
+    char *const *paths;
+    const char *cache_dir;
+    uint32_t format;
+    size_t stride;
+    int tree;                           /* RDT256-SEEDGEN-v2 seeds */
+    const rdt_health_config *health;    /* one fresh monitor per file */
+    uint8_t (*seeds)[32];
+    int *status;
+    rdt_health *monitors;
+    rdt_seed_arena *arenas;
+    size_t *free_arenas;
+    size_t n_free;
+    pthread_mutex_t lock;
+} batch_job;
+
+static void batch_task(void *arg, size_t index) {
+    batch_job *job = (batch_job *)arg;
+    size_t slot;
+
+    pthread_mutex_lock(&job->lock);
+    slot = job->free_arenas[--job->n_free];
+    pthread_mutex_unlock(&job->lock);
+
+    if (job->health) {
+        rdt_health_init(&job->monitors[index], job->health);
+        rdt_seed_arena_set_health(&job->arenas[slot], &job->monitors[index]);
+    }
+
+    if (job->tree) {
+        job->status[index] = rdt_seed_extract_file_v2(job->paths[index], job->seeds[index]);
+    } else if (job->format != RDT_SEED_FORMAT_TEXT) {
+        job->status[index] = rdt_seed_extract_file_typed_arena(&job->arenas[slot],
+                                                               job->paths[index], job->format,
+                                                               job->stride, job->seeds[index]);
+    } else if (job->cache_dir) {
+        job->status[index] = rdt_seed_extract_file_cached(job->cache_dir, job->paths[index],
+                                                          job->seeds[index]);
+    } else {
+        job->status[index] = rdt_seed_extract_file_arena(&job->arenas[slot], job->paths[index],
+                                                         job->seeds[index]);
+    }
+    rdt_seed_arena_set_health(&job->arenas[slot], NULL);
+
+    pthread_mutex_lock(&job->lock);
+    job->free_arenas[job->n_free++] = slot;
+    pthread_mutex_unlock(&job->lock);
+}
+
+static void batch_prefetch(char *const *paths, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int fd = open(paths[i], O_RDONLY);
+        if (fd < 0) continue;
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        close(fd);
+    }
+}
+
+/* Returns 0, 1 on any extraction error, or EXIT_HEALTH if only health tests failed */
+static int run_batch(const path_list *pl, const char *cache_dir, uint32_t format, size_t stride,
+                     int tree, const rdt_health_config *health) {
+    size_t threads = rdt_pool_threads();
+    size_t window = threads * BATCH_FILES_PER_THREAD;
+    batch_job job;
+    int failed = 0;
+    int unhealthy = 0;
+
+    job.seeds = (uint8_t (*)[32])malloc(window * sizeof(*job.seeds));
+    job.status = (int *)malloc(window * sizeof(*job.status));
+    job.monitors = (rdt_health *)malloc(window * sizeof(*job.monitors));
+    job.arenas = (rdt_seed_arena *)malloc(threads * sizeof(*job.arenas));
+    job.free_arenas = (size_t *)malloc(threads * sizeof(*job.free_arenas));
+    if (!job.seeds || !job.status || !job.monitors || !job.arenas || !job.free_arenas) {
+        fprintf(stderr, "Error: Out of memory\n");
+        free(job.seeds);
+        free(job.status);
+        free(job.monitors);
+        free(job.arenas);
+        free(job.free_arenas);
+        return 1;
+    }
+    for (size_t t = 0; t < threads; t++) {
+        rdt_seed_arena_init(&job.arenas[t]);
+        job.free_arenas[t] = t;
+    }
+    job.n_free = threads;
+    job.cache_dir = cache_dir;
+    job.format = format;
+    job.stride = stride;
+    job.tree = tree;
+    job.health = health;
+    pthread_mutex_init(&job.lock, NULL);
+
+    if (pl->len) batch_prefetch(pl->items, (pl->len < window) ? pl->len : window);
+    for (size_t first = 0; first < pl->len; first += window) {
+        size_t count = pl->len - first;
+        if (count > window) count = window;
+
+        if (first + count < pl->len) {
+            size_t ahead = pl->len - first - count;
+            batch_prefetch(pl->items + first + count, (ahead < window) ? ahead : window);
+        }
+
+        job.paths = pl->items + first;
+        rdt_pool_run(count, batch_task, &job);
+
+        for (size_t i = 0; i < count; i++) {
+            if (job.status[i] == RDT_SEED_ERR_HEALTH) {
+                report_health(job.paths[i], &job.monitors[i]);
+                unhealthy = 1;
+                continue;
+            }
+            if (job.status[i] != 0) {
+                fprintf(stderr, "Error: Failed to extract seed from %s\n", job.paths[i]);
+                failed = 1;
+                continue;
+            }
+            printf("%s\t", job.paths[i]);
+            print_hex(job.seeds[i], 32);
+            printf("\n");
+        }
+    }
+
+    pthread_mutex_destroy(&job.lock);
+    for (size_t t = 0; t < threads; t++) {
+        rdt_seed_arena_release(&job.arenas[t]);
+    }
+    secure_zero(job.seeds, window * sizeof(*job.seeds));
+    free(job.seeds);
+    free(job.status);
+    free(job.monitors);
+    free(job.arenas);
+    free(job.free_arenas);
+    return failed ? 1 : unhealthy ? EXIT_HEALTH : 0;
+}
+
+/* ========================================================================== */
+/* Standard Input and Follow Mode                                             */
+/* ========================================================================== */
+
+/* "-" reads all of stdin, then extracts exactly as for a file with the same bytes */
+static int read_all_stdin(uint8_t **data_out, size_t *len_out) {
+    byte_buffer buf;
+    uint8_t chunk[65536];
+
+    buffer_init(&buf, sizeof(chunk));
+    while (!buf.failed) {
+        ssize_t got = read(STDIN_FILENO, chunk, sizeof(chunk));
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error: Failed to read stdin: %s\n", strerror(errno));
+            break;
+        }
+        if (got == 0) {
+            *data_out = buf.data;
+            *len_out = buf.len;
+            secure_zero(chunk, sizeof(chunk));
+            return 0;
+        }
+        buffer_append(&buf, chunk, (size_t)got);
+    }
+    if (buf.failed) fprintf(stderr, "Error: Out of memory\n");
+    secure_zero(chunk, sizeof(chunk));
+    if (buf.data) secure_zero(buf.data, buf.len);
+    buffer_free(&buf);
+    return -1;
+}
+
+/*
+ * --follow keeps one streaming context for the whole run and feeds it new
+ * data as it appears; each emitted seed is a peek at the stream so far, so
+ * nothing is re-read or re-parsed. With --every N the input is split at
+ * multiples of N, making seed k the stream v1 seed of the first k*N bytes.
+ * --interval T emits when T seconds have passed and new data has arrived.
+ * Regular files are polled at end of file like tail -f; pipes end at EOF.
+ * SIGINT/SIGTERM or end of a pipe emit a last seed for data not yet covered.
+ */
+#define FOLLOW_POLL_MS 200
+
+static volatile sig_atomic_t follow_stop = 0;
+
+static void follow_signal(int sig) {
+    (void)sig;
+    follow_stop = 1;
+}
+
+static double follow_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int follow_print(const uint8_t seed[32], int binary) {
+    if (binary) {
+        fwrite(seed, 1, 32, stdout);
+    } else {
+        print_hex(seed, 32);
+        printf("\n");
+    }
+    return (fflush(stdout) == 0 && !ferror(stdout)) ? 0 : -1;
+}
+
+static int follow_emit(rdt_seed_extractor_ctx *ctx, int binary) {
+    uint8_t seed[32];
+    int rc = rdt_seed_extractor_peek(ctx, seed);
+
+    if (rc == 0) rc = follow_print(seed, binary);
+    secure_zero(seed, sizeof(seed));
+    return rc;
+}
+
+static int run_follow(const char *path, uint64_t every, double interval, int binary,
+                      const rdt_health_config *health_config) {
+    rdt_seed_extractor_ctx ctx;
+    rdt_health health;
+    int unhealthy = 0;
+    struct sigaction sa;
+    struct stat st;
+    uint8_t buf[65536];
+    uint64_t consumed = 0;
+    uint64_t pending = 0;       /* bytes not yet covered by an emitted seed */
+    uint64_t since_mark = 0;    /* bytes since the last --every boundary */
+    double last_emit;
+    int from_stdin = (strcmp(path, "-") == 0);
+    int regular;
+    int emitted = 0;
+    int fd;
+    int rc = 0;
+
+    fd = from_stdin ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "Error: Cannot open %s: %s\n", path, strerror(errno));
+        if (fd >= 0 && !from_stdin) close(fd);
+        return 1;
+    }
+    regular = S_ISREG(st.st_mode);
+    if (rdt_seed_extractor_init(&ctx, RDT_SEED_STREAM_V1) != 0) {
+        fprintf(stderr, "Error: Out of memory\n");
+        if (!from_stdin) close(fd);
+        return 1;
+    }
+    if (health_config) {
+        rdt_health_init(&health, health_config);
+        rdt_seed_extractor_set_health(&ctx, &health);
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = follow_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    last_emit = follow_now();
+    while (!follow_stop && rc == 0) {
+        int wait_ms = FOLLOW_POLL_MS;
+        ssize_t got = 0;
+
+        if (interval > 0.0) {
+            double left = last_emit + interval - follow_now();
+            if (pending && left <= 0.0) {
+                rc = follow_emit(&ctx, binary);
+                pending = 0;
+                emitted = 1;
+                last_emit = follow_now();
+                continue;
+            }
+            if (left < 0.0) left = 0.0;
+            if (left * 1000.0 < (double)wait_ms) wait_ms = (int)(left * 1000.0) + 1;
+        }
+
+        if (!regular) {
+            struct pollfd pfd = {fd, POLLIN, 0};
+            int ready = poll(&pfd, 1, wait_ms);
+            if (ready < 0 && errno != EINTR) {
+                fprintf(stderr, "Error: Failed to wait for %s: %s\n", path, strerror(errno));
+                rc = -1;
+            }
+            if (ready <= 0) continue;
+        }
+
+        got = read(fd, buf, sizeof(buf));
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error: Failed to read %s: %s\n", path, strerror(errno));
+            rc = -1;
+            break;
+        }
+        if (got == 0) {
+            if (!regular) break;
+            if (fstat(fd, &st) == 0 && (uint64_t)st.st_size < consumed) {
+                fprintf(stderr, "Error: %s was truncated while following\n", path);
+                rc = -1;
+                break;
+            }
+            (void)poll(NULL, 0, wait_ms);
+            continue;
+        }
+
+        for (size_t off = 0; off < (size_t)got && rc == 0;) {
+            size_t n = (size_t)got - off;
+
+            if (every && n > every - since_mark) n = (size_t)(every - since_mark);
+            rc = rdt_seed_extractor_update(&ctx, buf + off, n);
+            if (rc == RDT_SEED_ERR_HEALTH) {
+                report_health(path, &health);
+                unhealthy = 1;
+                break;
+            }
+            if (rc != 0) {
+                fprintf(stderr, "Error: Failed to extract seed\n");
+                break;
+            }
+            off += n;
+            consumed += n;
+            pending += n;
+            since_mark += n;
+            if (every && since_mark == every) {
+                rc = follow_emit(&ctx, binary);
+                pending = 0;
+                since_mark = 0;
+                emitted = 1;
+                last_emit = follow_now();
+            }
+        }
+    }
+
+    if (rc == 0 && (pending || !emitted)) {
+        uint8_t seed[32];
+        rc = rdt_seed_extractor_final(&ctx, seed);
+        if (rc == 0) rc = follow_print(seed, binary);
+        secure_zero(seed, sizeof(seed));
+    }
+    rdt_seed_extractor_abort(&ctx);
+    secure_zero(buf, sizeof(buf));
+    if (!from_stdin) close(fd);
+    return unhealthy ? EXIT_HEALTH : rc ? 1 : 0;
 }
 
 int main(int argc, char **argv) {
@@ -726,6 +3411,18 @@ int main(int argc, char **argv) {
 
     int format = 0;  /* 0=hex, 1=C, 2=u64, 3=binary */
     int file_start = 1;
+    int each = 0;
+    const char *list_path = NULL;
+    const char *cache_dir = NULL;
+    uint32_t input_format = RDT_SEED_FORMAT_TEXT;
+    size_t stride = 0;
+    int follow = 0;
+    uint64_t every = 0;
+    double interval = 0.0;
+    int tree = 0;
+    double claimed_entropy = 0.0;
+    rdt_health_config health_config;
+    const rdt_health_config *health = NULL;
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
@@ -740,11 +3437,151 @@ int main(int argc, char **argv) {
         } else if (strcmp(argv[i], "-b") == 0) {
             format = 3;
             file_start = i + 1;
+        } else if (strcmp(argv[i], "--each") == 0) {
+            each = 1;
+            file_start = i + 1;
+        } else if (strcmp(argv[i], "--from-list") == 0 && i + 1 < argc) {
+            each = 1;
+            list_path = argv[++i];
+            file_start = i + 1;
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cache_dir = argv[++i];
+            file_start = i + 1;
+            if (mkdir(cache_dir, 0700) != 0 && errno != EEXIST) {
+                fprintf(stderr, "Error: Cannot create cache directory %s: %s\n",
+                        cache_dir, strerror(errno));
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--v2") == 0) {
+            tree = 1;
+            file_start = i + 1;
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            static const char *const names[] = {"text", "i16le", "i32le", "f32le", "f64le"};
+            const char *name = argv[++i];
+            uint32_t f;
+            for (f = 0; f < 5u && strcmp(name, names[f]) != 0; f++) {
+            }
+            if (f == 5u) {
+                fprintf(stderr, "Error: Unknown format %s\n", name);
+                return 1;
+            }
+            input_format = f;
+            file_start = i + 1;
+        } else if (strcmp(argv[i], "--stride") == 0 && i + 1 < argc) {
+            char *end;
+            unsigned long n = strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || n == 0 || n > RDT_SEED_MAX_STRIDE) {
+                fprintf(stderr, "Error: --stride expects 1 to %u bytes\n", RDT_SEED_MAX_STRIDE);
+                return 1;
+            }
+            stride = (size_t)n;
+            file_start = i + 1;
+        } else if (strcmp(argv[i], "--health") == 0 && i + 1 < argc) {
+            char *end;
+            claimed_entropy = strtod(argv[++i], &end);
+            if (*end != '\0' || !(claimed_entropy > 0.0) || claimed_entropy > 64.0) {
+                fprintf(stderr, "Error: --health expects the claimed min-entropy in bits per sample\n");
+                return 1;
+            }
+            file_start = i + 1;
+        } else if (strcmp(argv[i], "--follow") == 0) {
+            follow = 1;
+            file_start = i + 1;
+        } else if (strcmp(argv[i], "--every") == 0 && i + 1 < argc) {
+            char *end;
+            unsigned long long n = strtoull(argv[++i], &end, 10);
+            if (*end != '\0' || n == 0 || argv[i][0] == '-') {
+                fprintf(stderr, "Error: --every expects a positive byte count\n");
+                return 1;
+            }
+            every = (uint64_t)n;
+            file_start = i + 1;
+        } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            char *end;
+            interval = strtod(argv[++i], &end);
+            if (*end != '\0' || !(interval > 0.0) || interval > 86400.0) {
+                fprintf(stderr, "Error: --interval expects seconds between 0 and 86400\n");
+                return 1;
+            }
+            file_start = i + 1;
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            char *end;
+            long threads = strtol(argv[++i], &end, 10);
+            if (*end != '\0' || threads < 1 || threads > 64) {
+                fprintf(stderr, "Error: -j expects a thread count from 1 to 64\n");
+                return 1;
+            }
+            rdt_pool_set_threads((unsigned)threads);
+            file_start = i + 1;
         } else {
             break;
         }
     }
 
+    if (input_format != RDT_SEED_FORMAT_TEXT && cache_dir) {
+        fprintf(stderr, "Error: --cache only applies to text input\n");
+        return 1;
+    }
+    if (tree && (cache_dir || input_format != RDT_SEED_FORMAT_TEXT || claimed_entropy > 0.0 || follow)) {
+        fprintf(stderr, "Error: --v2 takes text input without --cache, --health or --follow\n");
+        return 1;
+    }
+    if (claimed_entropy > 0.0) {
+        unsigned sample_bytes = format_sample_bytes(input_format);
+        if (cache_dir) {
+            /* Cached files are not re-read by the extractor's scanner path */
+            fprintf(stderr, "Error: --health cannot be combined with --cache\n");
+            return 1;
+        }
+        if (rdt_health_config_init(&health_config, claimed_entropy, sample_bytes, 0) != 0) {
+            fprintf(stderr, "Error: --health must be at most %u bits per sample\n", 8u * sample_bytes);
+            return 1;
+        }
+        health = &health_config;
+    }
+
+    if (follow) {
+        if (each || cache_dir || input_format != RDT_SEED_FORMAT_TEXT) {
+            fprintf(stderr, "Error: --follow takes text input without --each or --cache\n");
+            return 1;
+        }
+        if (format == 1 || format == 2) {
+            fprintf(stderr, "Error: Follow mode only supports hex or binary output\n");
+            return 1;
+        }
+        if (argc - file_start != 1) {
+            fprintf(stderr, "Error: --follow takes exactly one file or -\n");
+            return 1;
+        }
+        if (!every && interval == 0.0) interval = 1.0;
+        return run_follow(argv[file_start], every, interval, format == 3, health);
+    }
+    if (every || interval > 0.0) {
+        fprintf(stderr, "Error: --every and --interval need --follow\n");
+        return 1;
+    }
+
+    if (each) {
+        path_list pl = {0};
+        int result = 0;
+
+        if (format != 0) {
+            fprintf(stderr, "Error: Batch mode only supports hex output\n");
+            return 1;
+        }
+        if (list_path) result = collect_list_file(&pl, list_path);
+        for (int i = file_start; i < argc && result == 0; i++) {
+            result = collect_path(&pl, argv[i]);
+        }
+        if (result == 0 && pl.len == 0) {
+            fprintf(stderr, "Error: No input files specified\n");
+            result = -1;
+        }
+        if (result == 0) result = run_batch(&pl, cache_dir, input_format, stride, tree, health);
+        path_list_free(&pl);
+        return (result < 0) ? 1 : result;
+    }
+
     if (file_start >= argc) {
         fprintf(stderr, "Error: No input files specified\n");
         return 1;
@@ -755,13 +3592,60 @@ int main(int argc, char **argv) {
 
     uint8_t seed[32];
     int result;
+    rdt_seed_arena arena;
+    rdt_health monitor;
+
+    rdt_seed_arena_init(&arena);
+    if (health) {
+        rdt_health_init(&monitor, health);
+        rdt_seed_arena_set_health(&arena, &monitor);
+    }
 
-    if (num_files == 1) {
-        result = rdt_seed_extract_file(files[0], seed);
+    int from_stdin = 0;
+    for (int i = 0; i < num_files; i++) {
+        if (strcmp(files[i], "-") == 0) from_stdin = 1;
+    }
+
+    if (from_stdin) {
+        uint8_t *data = NULL;
+        size_t len = 0;
+
+        if (num_files != 1 || cache_dir) {
+            fprintf(stderr, "Error: - must be the only input and cannot be cached\n");
+            return 1;
+        }
+        result = read_all_stdin(&data, &len);
+        if (result == 0) {
+            result = tree ? rdt_seed_extract_v2(data, len, seed)
+                          : extract_typed(&arena, data, len, input_format, stride, seed);
+            secure_zero(data, len);
+            free(data);
+        }
+    } else if (tree && num_files == 1) {
+        result = rdt_seed_extract_file_v2(files[0], seed);
+    } else if (tree) {
+        result = rdt_seed_extract_files_v2(files, (size_t)num_files, seed);
+    } else if (input_format != RDT_SEED_FORMAT_TEXT) {
+        if (num_files != 1) {
+            fprintf(stderr, "Error: Binary formats take one file (use --each for several)\n");
+            return 1;
+        }
+        result = rdt_seed_extract_file_typed_arena(&arena, files[0], input_format, stride, seed);
+    } else if (cache_dir && num_files == 1) {
+        result = rdt_seed_extract_file_cached(cache_dir, files[0], seed);
+    } else if (cache_dir) {
+        result = rdt_seed_extract_files_cached(cache_dir, files, (size_t)num_files, seed);
+    } else if (num_files == 1) {
+        result = rdt_seed_extract_file_arena(&arena, files[0], seed);
     } else {
-        result = rdt_seed_extract_files(files, (size_t)num_files, seed);
+        result = rdt_seed_extract_files_arena(&arena, files, (size_t)num_files, seed);
     }
+    rdt_seed_arena_release(&arena);
 
+    if (result == RDT_SEED_ERR_HEALTH) {
+        report_health((num_files == 1) ? files[0] : "input", &monitor);
+        return EXIT_HEALTH;
+    }
     if (result != 0) {
         fprintf(stderr, "Error: Failed to extract seed\n");
         return 1;
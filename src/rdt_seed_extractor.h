@@ -20,10 +20,18 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "rdt_health.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*
+ * Returned instead of a seed when an attached health monitor (see
+ * rdt_seed_arena_set_health and rdt_seed_extractor_set_health) has failed.
+ */
+#define RDT_SEED_ERR_HEALTH (-2)
+
 /*
  * Extract a 256-bit seed from raw data buffer.
  *
@@ -53,6 +61,9 @@ int rdt_seed_extract_u64(const uint8_t *data, size_t data_len, uint64_t seed_out
 /*
  * Extract a 256-bit seed from a file.
  *
+ * The file is memory-mapped read-only rather than copied onto the heap.
+ * Only non-empty regular files are accepted.
+ *
  * Parameters:
  *   filepath  - Path to input file
  *   seed_out  - Output buffer (must be at least 32 bytes)
@@ -65,6 +76,10 @@ int rdt_seed_extract_file(const char *filepath, uint8_t seed_out[32]);
 /*
  * Extract a 256-bit seed from multiple files.
  *
+ * Equivalent to extracting from the concatenation of
+ * "FILE:" path "\0" contents "\x1E" for every file, but the mapped files are
+ * read in place instead of being concatenated. Empty files are allowed.
+ *
  * Parameters:
  *   filepaths - Array of file paths
  *   num_files - Number of files
@@ -75,6 +90,205 @@ int rdt_seed_extract_file(const char *filepath, uint8_t seed_out[32]);
  */
 int rdt_seed_extract_files(const char **filepaths, size_t num_files, uint8_t seed_out[32]);
 
+/*
+ * Tree mode (RDT256-SEEDGEN-v2)
+ * -----------------------------
+ * v1 mixes one pool built from the whole input, so it cannot be split
+ * across cores. v2 cuts each input into RDT_SEED_V2_LEAF_BYTES leaves (the
+ * last may be shorter) and conditions every leaf on its own with the v1
+ * stages: numeric records with positions and line numbers relative to the
+ * leaf (a number that straddles two leaves is read as two tokens),
+ * structure fingerprint, raw hash, precursor layer and mixer. Each leaf
+ * gives
+ *
+ *   leaf = SHA-256(D || 0x00 || index (u64) || mixed leaf pool)
+ *
+ * with D = "RDT256-SEEDGEN-v2\x00". Leaves are combined in a Merkle tree of
+ * RFC 6962 shape with node = SHA-256(D || 0x01 || left || right); an input
+ * without leaves has root SHA-256(D || 0x02). The seed is
+ *
+ *   SHA-256(D || "StevenReid:RDT256\x00" || 0x03 || length || leaves || root)
+ *
+ * or, for a file list,
+ *
+ *   SHA-256(D || "StevenReid:RDT256\x00" || 0x04 || file count ||
+ *           for each file: path length || path || length || leaves || root)
+ *
+ * with every count and length a little-endian u64. Leaves are extracted in
+ * parallel on rdt_pool in a fixed amount of memory, and the seed does not
+ * depend on the thread count. v2 seeds differ from v1 seeds; v1 stays the
+ * default.
+ *
+ * rdt_seed_extract_file_v2() gives the same seed as rdt_seed_extract_v2()
+ * over the file's bytes. rdt_seed_extract_files_v2() accepts empty files.
+ *
+ * Returns:
+ *   0 on success, -1 on error
+ */
+#define RDT_SEED_V2_LEAF_BYTES (256u * 1024u)
+
+int rdt_seed_extract_v2(const uint8_t *data, size_t data_len, uint8_t seed_out[32]);
+int rdt_seed_extract_file_v2(const char *filepath, uint8_t seed_out[32]);
+int rdt_seed_extract_files_v2(const char **filepaths, size_t num_files, uint8_t seed_out[32]);
+
+/*
+ * Extract from typed binary input.
+ *
+ * The input is a sequence of records of stride bytes (0 = one value per
+ * record), each holding stride / width little-endian values of the given
+ * format starting at its first byte. Every whole value is fed into the
+ * numeric feature stream as (byte offset, record index, value) in place of
+ * the text scanner's (byte offset, line, number); the structure fingerprint
+ * and raw hash cover all bytes as usual. The pool gains a FORMAT section, so
+ * typed seeds differ from text seeds of the same bytes.
+ *
+ * RDT_SEED_FORMAT_TEXT gives the same seeds as rdt_seed_extract() /
+ * rdt_seed_extract_file(); stride is then ignored.
+ *
+ * Returns:
+ *   0 on success, -1 on error (including an unknown format or a stride
+ *   below the value width or above RDT_SEED_MAX_STRIDE)
+ */
+#define RDT_SEED_FORMAT_TEXT 0u
+#define RDT_SEED_FORMAT_I16LE 1u
+#define RDT_SEED_FORMAT_I32LE 2u
+#define RDT_SEED_FORMAT_F32LE 3u
+#define RDT_SEED_FORMAT_F64LE 4u
+#define RDT_SEED_MAX_STRIDE 65536u
+
+int rdt_seed_extract_typed(const uint8_t *data, size_t data_len, uint32_t format,
+                           size_t stride, uint8_t seed_out[32]);
+int rdt_seed_extract_file_typed(const char *filepath, uint32_t format, size_t stride,
+                                uint8_t seed_out[32]);
+
+/*
+ * Extract with an on-disk feature cache.
+ *
+ * Same seeds as rdt_seed_extract_file() / rdt_seed_extract_files(). Each
+ * file's numeric records and delimiter counts are stored in cache_dir, keyed
+ * by device, inode, size, mtime and a 64-bit checksum of the full contents;
+ * while a file is unchanged, later calls replay them instead of tokenizing
+ * and parsing it again. Every file is still read in full, for the checksum
+ * and the raw-data hash. The checksum is not cryptographic: it catches edits,
+ * not contents crafted to collide with a cached entry.
+ *
+ * cache_dir must exist. Entries that are missing, stale or corrupt are
+ * rebuilt; if the directory is not writable, extraction still succeeds.
+ * Entries are never pruned. Concurrent callers may share a directory.
+ *
+ * Returns:
+ *   0 on success, -1 on error
+ */
+int rdt_seed_extract_file_cached(const char *cache_dir, const char *filepath,
+                                 uint8_t seed_out[32]);
+int rdt_seed_extract_files_cached(const char *cache_dir, const char **filepaths,
+                                  size_t num_files, uint8_t seed_out[32]);
+
+/*
+ * Reusable extraction arena
+ * -------------------------
+ * The functions above allocate their working memory on every call. Callers
+ * that extract many seeds can keep one arena instead: it grows to the largest
+ * input seen and is reused, so repeated calls do not touch the allocator.
+ * The pool is sized before parsing, so it is never reallocated mid-call.
+ *
+ * The arena is wiped after every extraction and holds no input-derived data
+ * between calls. _release wipes and frees it; the arena can be used again
+ * afterwards. An arena may only be used by one thread at a time.
+ *
+ * The _arena variants produce the same seeds as their counterparts above.
+ */
+typedef struct {
+    uint8_t *base;
+    size_t capacity;
+    rdt_health *health;
+} rdt_seed_arena;
+
+void rdt_seed_arena_init(rdt_seed_arena *arena);
+void rdt_seed_arena_release(rdt_seed_arena *arena);
+
+/*
+ * Run the input of every later extraction with this arena through an
+ * SP 800-90B health monitor (NULL detaches it). The monitor sees the
+ * sensor bytes in order, as samples of its configured width; the framing
+ * that _files_arena adds around each file is not tested. While the
+ * monitor has failed, including on an earlier input, extraction returns
+ * RDT_SEED_ERR_HEALTH and produces no seed. Seeds are unchanged otherwise.
+ * The monitor belongs to the caller and is not reset between calls.
+ */
+void rdt_seed_arena_set_health(rdt_seed_arena *arena, rdt_health *health);
+
+int rdt_seed_extract_arena(rdt_seed_arena *arena, const uint8_t *data, size_t data_len,
+                           uint8_t seed_out[32]);
+int rdt_seed_extract_file_arena(rdt_seed_arena *arena, const char *filepath,
+                                uint8_t seed_out[32]);
+int rdt_seed_extract_files_arena(rdt_seed_arena *arena, const char **filepaths,
+                                 size_t num_files, uint8_t seed_out[32]);
+int rdt_seed_extract_file_typed_arena(rdt_seed_arena *arena, const char *filepath,
+                                      uint32_t format, size_t stride, uint8_t seed_out[32]);
+
+/*
+ * Streaming extraction
+ * --------------------
+ * Conditions an input of any length, delivered in pieces, with a fixed-size
+ * state. Numbers are parsed across update boundaries, so the seed depends
+ * only on the concatenated input and not on how it was split.
+ *
+ * The stream format is versioned and is NOT the same function as
+ * rdt_seed_extract(): v1 samples bytes at len/128 intervals and mixes the
+ * whole pool at once, which needs the complete input up front. Stream v1:
+ *   - numeric (pos, line, value) records, packed as in rdt_seed_extract,
+ *     are cut into RDT_SEED_STREAM_BLOCK_BYTES blocks; each block goes
+ *     through the precursor layer and recursive mixer and is chained into
+ *     a running SHA-256
+ *   - structure: total length, delimiter counts, and up to 256 4-byte
+ *     samples at multiples of a stride that starts at 4 and doubles as the
+ *     input grows
+ *   - raw SHA-256 of the input
+ *   - domain tag "RDT256-SEEDSTREAM-v1"
+ * Positions and line numbers are 32-bit and wrap on very long streams.
+ *
+ * The context owns one heap allocation of fixed size made by _init and
+ * released by _final (or _abort). _final wipes it.
+ *
+ * Returns 0 on success, -1 on error (bad arguments, unknown version,
+ * allocation or read failure, use after _final), RDT_SEED_ERR_HEALTH as
+ * described for rdt_seed_extractor_set_health.
+ */
+#define RDT_SEED_STREAM_V1 1u
+#define RDT_SEED_STREAM_BLOCK_BYTES 65536u
+
+typedef struct {
+    uint32_t version;
+    void *state;
+} rdt_seed_extractor_ctx;
+
+int rdt_seed_extractor_init(rdt_seed_extractor_ctx *ctx, uint32_t version);
+int rdt_seed_extractor_update(rdt_seed_extractor_ctx *ctx, const uint8_t *data, size_t len);
+
+/* Read from fd (file, pipe or socket) until end of file. */
+int rdt_seed_extractor_update_fd(rdt_seed_extractor_ctx *ctx, int fd);
+
+int rdt_seed_extractor_final(rdt_seed_extractor_ctx *ctx, uint8_t seed_out[32]);
+
+/*
+ * Seed for the input so far, equal to what _final would return now, without
+ * ending the stream: later updates continue from the same state. Costs one
+ * copy of the state plus mixing the partial block.
+ */
+int rdt_seed_extractor_peek(const rdt_seed_extractor_ctx *ctx, uint8_t seed_out[32]);
+
+/*
+ * Test all later input with a health monitor, as for arenas (NULL detaches
+ * it). Once the monitor has failed, _update still absorbs its input but
+ * returns RDT_SEED_ERR_HEALTH, and _peek / _final return it instead of a
+ * seed (_final releases the context either way).
+ */
+int rdt_seed_extractor_set_health(rdt_seed_extractor_ctx *ctx, rdt_health *health);
+
+/* Release the context without producing a seed. */
+void rdt_seed_extractor_abort(rdt_seed_extractor_ctx *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,7 +1,13 @@
 #include "rdt_sha256.h"
+#include "rdt_pool.h"
+#include "rdt_stats.h"
 
 #include <string.h>
 
+#if defined(__AVX2__) || defined(__SHA__)
+#include <immintrin.h>
+#endif
+
 static void secure_zero(void *ptr, size_t len) {
     volatile uint8_t *p = (volatile uint8_t *)ptr;
     size_t i;
@@ -37,53 +43,124 @@ static const uint32_t sha256_k[64] = {
 #define RDT_SIG0(x) (RDT_ROR32((x), 7u) ^ RDT_ROR32((x), 18u) ^ ((x) >> 3u))
 #define RDT_SIG1(x) (RDT_ROR32((x), 17u) ^ RDT_ROR32((x), 19u) ^ ((x) >> 10u))
 
-static void rdt_sha256_transform(rdt_sha256_ctx *ctx, const uint8_t data[64]) {
+/*
+ * Compression kernel: run blocks consecutive 64-byte blocks through state.
+ * Every hash in the library goes through this one function, so the SHA
+ * extensions are picked up wherever the build enables them.
+ */
+#if defined(__SHA__) && defined(__SSE4_1__)
+#define RDT_SHA256_HAVE_SHANI 1
+
+/* Four rounds; state is kept as ABEF / CDGH as the SHA instructions expect */
+static inline void sha256_rounds4(__m128i *abef, __m128i *cdgh, __m128i w, const uint32_t *k) {
+    __m128i wk = _mm_add_epi32(w, _mm_loadu_si128((const __m128i *)(const void *)k));
+    *cdgh = _mm_sha256rnds2_epu32(*cdgh, *abef, wk);
+    *abef = _mm_sha256rnds2_epu32(*abef, *cdgh, _mm_shuffle_epi32(wk, 0x0E));
+}
+
+/* W[t..t+3] from W[t-16..t-1], held four words per register */
+static inline __m128i sha256_schedule4(__m128i w0, __m128i w1, __m128i w2, __m128i w3) {
+    __m128i x = _mm_add_epi32(_mm_sha256msg1_epu32(w0, w1), _mm_alignr_epi8(w3, w2, 4));
+    return _mm_sha256msg2_epu32(x, w3);
+}
+
+static void sha256_blocks(uint32_t state[8], const uint8_t *data, size_t blocks) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    __m128i dcba = _mm_loadu_si128((const __m128i *)(const void *)&state[0]);
+    __m128i hgfe = _mm_loadu_si128((const __m128i *)(const void *)&state[4]);
+    __m128i cdab = _mm_shuffle_epi32(dcba, 0xB1);
+    __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1B);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+    __m128i feba, dchg;
+
+    RDT_STATS_ADD(RDT_STAT_SHA256_COMPRESSIONS, blocks);
+#if defined(__AVX__)
+    /* The SHA instructions have no VEX form; clean upper halves keep them from stalling */
+    _mm256_zeroupper();
+#endif
+    for (; blocks; blocks--, data += 64) {
+        const __m128i *p = (const __m128i *)(const void *)data;
+        __m128i abef0 = abef;
+        __m128i cdgh0 = cdgh;
+        __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(p), bswap);
+        __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(p + 1), bswap);
+        __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(p + 2), bswap);
+        __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(p + 3), bswap);
+
+        for (int r = 0; r < 64; r += 16) {
+            sha256_rounds4(&abef, &cdgh, w0, sha256_k + r);
+            sha256_rounds4(&abef, &cdgh, w1, sha256_k + r + 4);
+            sha256_rounds4(&abef, &cdgh, w2, sha256_k + r + 8);
+            sha256_rounds4(&abef, &cdgh, w3, sha256_k + r + 12);
+            if (r < 48) {
+                w0 = sha256_schedule4(w0, w1, w2, w3);
+                w1 = sha256_schedule4(w1, w2, w3, w0);
+                w2 = sha256_schedule4(w2, w3, w0, w1);
+                w3 = sha256_schedule4(w3, w0, w1, w2);
+            }
+        }
+        abef = _mm_add_epi32(abef, abef0);
+        cdgh = _mm_add_epi32(cdgh, cdgh0);
+    }
+
+    feba = _mm_shuffle_epi32(abef, 0x1B);
+    dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128((__m128i *)(void *)&state[0], _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128((__m128i *)(void *)&state[4], _mm_alignr_epi8(dchg, feba, 8));
+}
+#else
+static void sha256_blocks(uint32_t state[8], const uint8_t *data, size_t blocks) {
     uint32_t a, b, c, d, e, f, g, h;
     uint32_t t1, t2;
     uint32_t m[64];
     int i;
 
-    for (i = 0; i < 16; i++) {
-        m[i] = ((uint32_t)data[i * 4] << 24)
-             | ((uint32_t)data[i * 4 + 1] << 16)
-             | ((uint32_t)data[i * 4 + 2] << 8)
-             | ((uint32_t)data[i * 4 + 3]);
-    }
-    for (; i < 64; i++) {
-        m[i] = RDT_SIG1(m[i - 2]) + m[i - 7] + RDT_SIG0(m[i - 15]) + m[i - 16];
-    }
+    RDT_STATS_ADD(RDT_STAT_SHA256_COMPRESSIONS, blocks);
+    for (; blocks; blocks--, data += 64) {
+        for (i = 0; i < 16; i++) {
+            m[i] = ((uint32_t)data[i * 4] << 24)
+                 | ((uint32_t)data[i * 4 + 1] << 16)
+                 | ((uint32_t)data[i * 4 + 2] << 8)
+                 | ((uint32_t)data[i * 4 + 3]);
+        }
+        for (; i < 64; i++) {
+            m[i] = RDT_SIG1(m[i - 2]) + m[i - 7] + RDT_SIG0(m[i - 15]) + m[i - 16];
+        }
 
-    a = ctx->state[0];
-    b = ctx->state[1];
-    c = ctx->state[2];
-    d = ctx->state[3];
-    e = ctx->state[4];
-    f = ctx->state[5];
-    g = ctx->state[6];
-    h = ctx->state[7];
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+        f = state[5];
+        g = state[6];
+        h = state[7];
+
+        for (i = 0; i < 64; i++) {
+            t1 = h + RDT_EP1(e) + RDT_CH(e, f, g) + sha256_k[i] + m[i];
+            t2 = RDT_EP0(a) + RDT_MAJ(a, b, c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
 
-    for (i = 0; i < 64; i++) {
-        t1 = h + RDT_EP1(e) + RDT_CH(e, f, g) + sha256_k[i] + m[i];
-        t2 = RDT_EP0(a) + RDT_MAJ(a, b, c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
     }
-
-    ctx->state[0] += a;
-    ctx->state[1] += b;
-    ctx->state[2] += c;
-    ctx->state[3] += d;
-    ctx->state[4] += e;
-    ctx->state[5] += f;
-    ctx->state[6] += g;
-    ctx->state[7] += h;
 }
+#endif
 
 void rdt_sha256_init(rdt_sha256_ctx *ctx) {
     if (!ctx) {
@@ -105,7 +182,7 @@ void rdt_sha256_update(rdt_sha256_ctx *ctx, const uint8_t *data, size_t len) {
     size_t i = 0;
     size_t idx;
 
-    if (!ctx || (!data && len)) {
+    if (!ctx || !data || !len) {
         return;
     }
 
@@ -119,12 +196,14 @@ void rdt_sha256_update(rdt_sha256_ctx *ctx, const uint8_t *data, size_t len) {
             return;
         }
         memcpy(ctx->buffer + idx, data, left);
-        rdt_sha256_transform(ctx, ctx->buffer);
+        sha256_blocks(ctx->state, ctx->buffer, 1u);
         i = left;
     }
 
-    for (; i + 64u <= len; i += 64u) {
-        rdt_sha256_transform(ctx, data + i);
+    if (len - i >= 64u) {
+        size_t blocks = (len - i) / 64u;
+        sha256_blocks(ctx->state, data + i, blocks);
+        i += blocks * 64u;
     }
 
     if (i < len) {
@@ -146,7 +225,7 @@ void rdt_sha256_final(rdt_sha256_ctx *ctx, uint8_t hash[RDT_SHA256_DIGEST_SIZE])
 
     if (idx > 56u) {
         memset(ctx->buffer + idx, 0, 64u - idx);
-        rdt_sha256_transform(ctx, ctx->buffer);
+        sha256_blocks(ctx->state, ctx->buffer, 1u);
         idx = 0;
     }
 
@@ -155,7 +234,7 @@ void rdt_sha256_final(rdt_sha256_ctx *ctx, uint8_t hash[RDT_SHA256_DIGEST_SIZE])
     for (i = 0; i < 8; i++) {
         ctx->buffer[63 - i] = (uint8_t)(bits >> (unsigned)(i * 8));
     }
-    rdt_sha256_transform(ctx, ctx->buffer);
+    sha256_blocks(ctx->state, ctx->buffer, 1u);
 
     for (i = 0; i < 8; i++) {
         hash[i * 4] = (uint8_t)(ctx->state[i] >> 24);
@@ -237,3 +316,313 @@ void rdt_hmac_sha256(const uint8_t *key, size_t key_len,
     rdt_hmac_sha256_final(&ctx, mac);
     secure_zero(&ctx, sizeof(ctx));
 }
+
+/* -------------------------------------------------------------------------- */
+/* HKDF (RFC 5869)                                                            */
+/* -------------------------------------------------------------------------- */
+
+int rdt_hkdf_sha256_extract(const uint8_t *salt, size_t salt_len,
+                            const uint8_t *ikm, size_t ikm_len,
+                            uint8_t prk[RDT_SHA256_DIGEST_SIZE]) {
+    if ((!salt && salt_len) || (!ikm && ikm_len) || !prk) {
+        return -1;
+    }
+    /* A missing salt is HashLen zero bytes, which pads to the same HMAC key */
+    rdt_hmac_sha256(salt, salt_len, ikm, ikm_len, prk);
+    return 0;
+}
+
+int rdt_hkdf_sha256_expand(const uint8_t *prk, size_t prk_len,
+                           const uint8_t *info, size_t info_len,
+                           uint8_t *okm, size_t okm_len) {
+    rdt_hmac_sha256_ctx key;
+    rdt_hmac_sha256_ctx ctx;
+    uint8_t t[RDT_SHA256_DIGEST_SIZE];
+    size_t done = 0;
+    uint8_t counter = 0;
+
+    if (!prk || (!info && info_len) || (!okm && okm_len) || okm_len > RDT_HKDF_SHA256_MAX_OUTPUT) {
+        return -1;
+    }
+
+    rdt_hmac_sha256_init(&key, prk, prk_len);
+    while (done < okm_len) {
+        size_t take = okm_len - done;
+
+        counter++;
+        ctx = key;
+        if (counter > 1u) {
+            rdt_hmac_sha256_update(&ctx, t, sizeof(t));
+        }
+        rdt_hmac_sha256_update(&ctx, info, info_len);
+        rdt_hmac_sha256_update(&ctx, &counter, 1u);
+        rdt_hmac_sha256_final(&ctx, t);
+
+        if (take > sizeof(t)) take = sizeof(t);
+        memcpy(okm + done, t, take);
+        done += take;
+    }
+
+    secure_zero(&key, sizeof(key));
+    secure_zero(&ctx, sizeof(ctx));
+    secure_zero(t, sizeof(t));
+    return 0;
+}
+
+int rdt_hkdf_sha256(const uint8_t *salt, size_t salt_len,
+                    const uint8_t *ikm, size_t ikm_len,
+                    const uint8_t *info, size_t info_len,
+                    uint8_t *okm, size_t okm_len) {
+    uint8_t prk[RDT_SHA256_DIGEST_SIZE];
+    int rc;
+
+    if (rdt_hkdf_sha256_extract(salt, salt_len, ikm, ikm_len, prk) != 0) {
+        return -1;
+    }
+    rc = rdt_hkdf_sha256_expand(prk, sizeof(prk), info, info_len, okm, okm_len);
+    secure_zero(prk, sizeof(prk));
+    return rc;
+}
+
+/* -------------------------------------------------------------------------- */
+/* PBKDF2-HMAC-SHA256 (RFC 8018)                                              */
+/* -------------------------------------------------------------------------- */
+
+/*
+ * After U_1 every PBKDF2 message is the previous 32-byte U, so an
+ * iteration is exactly two compressions: the inner pad midstate over
+ * U || padding, then the outer pad midstate over that digest || padding.
+ * Both midstates come from one rdt_hmac_sha256_init per call.
+ *
+ * Output blocks are independent chains. The pool runs them in groups of
+ * PBKDF2_LANES; with AVX2 and no SHA extensions a group advances eight
+ * chains at once, one per 32-bit lane, otherwise the lanes of a group run
+ * one after another through sha256_blocks.
+ */
+#if defined(__AVX2__) && !defined(RDT_SHA256_HAVE_SHANI)
+#define PBKDF2_LANES 8u
+#else
+#define PBKDF2_LANES 1u
+#endif
+
+/* Message length of both one-block hashes: 64 pad bytes + 32 digest bytes */
+#define PBKDF2_BLOCK_BITS ((RDT_SHA256_BLOCK_SIZE + RDT_SHA256_DIGEST_SIZE) * 8u)
+
+static void store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static uint32_t load_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+#if PBKDF2_LANES == 8u
+#define X8_ROR(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define X8_EP0(x) _mm256_xor_si256(_mm256_xor_si256(X8_ROR((x), 2), X8_ROR((x), 13)), X8_ROR((x), 22))
+#define X8_EP1(x) _mm256_xor_si256(_mm256_xor_si256(X8_ROR((x), 6), X8_ROR((x), 11)), X8_ROR((x), 25))
+#define X8_SIG0(x) _mm256_xor_si256(_mm256_xor_si256(X8_ROR((x), 7), X8_ROR((x), 18)), _mm256_srli_epi32((x), 3))
+#define X8_SIG1(x) _mm256_xor_si256(_mm256_xor_si256(X8_ROR((x), 17), X8_ROR((x), 19)), _mm256_srli_epi32((x), 10))
+
+/* One compression in each of eight lanes; m holds the message words */
+static void sha256_x8(__m256i s[8], const __m256i m[16]) {
+    __m256i w[16];
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3];
+    __m256i e = s[4], f = s[5], g = s[6], h = s[7];
+    int i;
+
+    RDT_STATS_ADD(RDT_STAT_SHA256_COMPRESSIONS, 8);
+    for (i = 0; i < 64; i++) {
+        __m256i t1, t2;
+
+        if (i < 16) {
+            w[i] = m[i];
+        } else {
+            w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(X8_SIG1(w[(i - 2) & 15]), w[(i - 7) & 15]),
+                                         _mm256_add_epi32(X8_SIG0(w[(i - 15) & 15]), w[i & 15]));
+        }
+        t1 = _mm256_add_epi32(_mm256_add_epi32(h, X8_EP1(e)),
+                              _mm256_add_epi32(_mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)),
+                                               _mm256_add_epi32(_mm256_set1_epi32((int)sha256_k[i]), w[i & 15])));
+        t2 = _mm256_add_epi32(X8_EP0(a),
+                              _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b))));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, t2);
+    }
+
+    s[0] = _mm256_add_epi32(s[0], a);
+    s[1] = _mm256_add_epi32(s[1], b);
+    s[2] = _mm256_add_epi32(s[2], c);
+    s[3] = _mm256_add_epi32(s[3], d);
+    s[4] = _mm256_add_epi32(s[4], e);
+    s[5] = _mm256_add_epi32(s[5], f);
+    s[6] = _mm256_add_epi32(s[6], g);
+    s[7] = _mm256_add_epi32(s[7], h);
+}
+
+/* Iterations 2..c of eight chains; u and t are [word][lane] */
+static void pbkdf2_iterate(const rdt_hmac_sha256_ctx *key, uint32_t u[8][PBKDF2_LANES],
+                           uint32_t t[8][PBKDF2_LANES], uint32_t iterations) {
+    __m256i m[16], st[8], uv[8], tv[8], inner[8], outer[8];
+    int j;
+
+    for (j = 0; j < 8; j++) {
+        uv[j] = _mm256_loadu_si256((const __m256i *)(const void *)u[j]);
+        tv[j] = _mm256_loadu_si256((const __m256i *)(const void *)t[j]);
+        inner[j] = _mm256_set1_epi32((int)key->inner.state[j]);
+        outer[j] = _mm256_set1_epi32((int)key->outer.state[j]);
+    }
+    m[8] = _mm256_set1_epi32((int)0x80000000u);
+    for (j = 9; j < 15; j++) m[j] = _mm256_setzero_si256();
+    m[15] = _mm256_set1_epi32((int)PBKDF2_BLOCK_BITS);
+
+    for (; iterations > 1u; iterations--) {
+        for (j = 0; j < 8; j++) {
+            m[j] = uv[j];
+            st[j] = inner[j];
+        }
+        sha256_x8(st, m);
+        for (j = 0; j < 8; j++) {
+            m[j] = st[j];
+            uv[j] = outer[j];
+        }
+        sha256_x8(uv, m);
+        for (j = 0; j < 8; j++) tv[j] = _mm256_xor_si256(tv[j], uv[j]);
+    }
+
+    for (j = 0; j < 8; j++) {
+        _mm256_storeu_si256((__m256i *)(void *)t[j], tv[j]);
+    }
+    secure_zero(m, sizeof(m));
+    secure_zero(st, sizeof(st));
+    secure_zero(uv, sizeof(uv));
+    secure_zero(tv, sizeof(tv));
+}
+#else
+/* Iterations 2..c of each chain in turn; u and t are [word][lane] */
+static void pbkdf2_iterate(const rdt_hmac_sha256_ctx *key, uint32_t u[8][PBKDF2_LANES],
+                           uint32_t t[8][PBKDF2_LANES], uint32_t iterations) {
+    uint8_t block[RDT_SHA256_BLOCK_SIZE];
+    uint32_t st[8], uv[8], tv[8];
+    unsigned lane;
+    int j;
+
+    memset(block, 0, sizeof(block));
+    block[RDT_SHA256_DIGEST_SIZE] = 0x80u;
+    store_be32(block + 60, PBKDF2_BLOCK_BITS);
+
+    for (lane = 0; lane < PBKDF2_LANES; lane++) {
+        uint32_t c;
+
+        for (j = 0; j < 8; j++) {
+            uv[j] = u[j][lane];
+            tv[j] = t[j][lane];
+        }
+        for (c = iterations; c > 1u; c--) {
+            for (j = 0; j < 8; j++) store_be32(block + 4 * j, uv[j]);
+            memcpy(st, key->inner.state, sizeof(st));
+            sha256_blocks(st, block, 1u);
+            for (j = 0; j < 8; j++) store_be32(block + 4 * j, st[j]);
+            memcpy(uv, key->outer.state, sizeof(uv));
+            sha256_blocks(uv, block, 1u);
+            for (j = 0; j < 8; j++) tv[j] ^= uv[j];
+        }
+        for (j = 0; j < 8; j++) t[j][lane] = tv[j];
+    }
+
+    secure_zero(block, sizeof(block));
+    secure_zero(st, sizeof(st));
+    secure_zero(uv, sizeof(uv));
+    secure_zero(tv, sizeof(tv));
+}
+#endif
+
+typedef struct {
+    const rdt_hmac_sha256_ctx *key;     /* password pads only */
+    const rdt_hmac_sha256_ctx *salted;  /* password pads with the salt absorbed */
+    uint32_t iterations;
+    uint8_t *out;
+    size_t out_len;
+} pbkdf2_job;
+
+static void pbkdf2_group_task(void *arg, size_t index) {
+    const pbkdf2_job *job = (const pbkdf2_job *)arg;
+    uint32_t u[8][PBKDF2_LANES];
+    uint32_t t[8][PBKDF2_LANES];
+    uint8_t digest[RDT_SHA256_DIGEST_SIZE];
+    uint8_t block_index[4];
+    size_t first = index * PBKDF2_LANES;
+    unsigned lane;
+    int j;
+
+    memset(u, 0, sizeof(u));
+    for (lane = 0; lane < PBKDF2_LANES; lane++) {
+        rdt_hmac_sha256_ctx ctx = *job->salted;
+
+        if ((first + lane) * RDT_SHA256_DIGEST_SIZE >= job->out_len) break;
+        store_be32(block_index, (uint32_t)(first + lane + 1u));
+        rdt_hmac_sha256_update(&ctx, block_index, sizeof(block_index));
+        rdt_hmac_sha256_final(&ctx, digest);
+        secure_zero(&ctx, sizeof(ctx));
+        for (j = 0; j < 8; j++) u[j][lane] = load_be32(digest + 4 * j);
+    }
+    memcpy(t, u, sizeof(t));
+
+    pbkdf2_iterate(job->key, u, t, job->iterations);
+
+    for (lane = 0; lane < PBKDF2_LANES; lane++) {
+        size_t offset = (first + lane) * RDT_SHA256_DIGEST_SIZE;
+        size_t take;
+
+        if (offset >= job->out_len) break;
+        take = job->out_len - offset;
+        if (take > sizeof(digest)) take = sizeof(digest);
+        for (j = 0; j < 8; j++) store_be32(digest + 4 * j, t[j][lane]);
+        memcpy(job->out + offset, digest, take);
+    }
+
+    secure_zero(u, sizeof(u));
+    secure_zero(t, sizeof(t));
+    secure_zero(digest, sizeof(digest));
+}
+
+int rdt_pbkdf2_sha256(const uint8_t *password, size_t password_len,
+                      const uint8_t *salt, size_t salt_len,
+                      uint32_t iterations,
+                      uint8_t *out, size_t out_len) {
+    rdt_hmac_sha256_ctx key;
+    rdt_hmac_sha256_ctx salted;
+    pbkdf2_job job;
+    size_t blocks;
+
+    if ((!password && password_len) || (!salt && salt_len) || !out || !out_len || !iterations) {
+        return -1;
+    }
+    blocks = (out_len + RDT_SHA256_DIGEST_SIZE - 1u) / RDT_SHA256_DIGEST_SIZE;
+    if ((uint64_t)blocks > 0xFFFFFFFFull) {
+        return -1;
+    }
+
+    rdt_hmac_sha256_init(&key, password, password_len);
+    salted = key;
+    rdt_hmac_sha256_update(&salted, salt, salt_len);
+
+    job.key = &key;
+    job.salted = &salted;
+    job.iterations = iterations;
+    job.out = out;
+    job.out_len = out_len;
+    rdt_pool_run((blocks + PBKDF2_LANES - 1u) / PBKDF2_LANES, pbkdf2_group_task, &job);
+
+    secure_zero(&key, sizeof(key));
+    secure_zero(&salted, sizeof(salted));
+    return 0;
+}
@@ -34,6 +34,42 @@ void rdt_hmac_sha256(const uint8_t *key, size_t key_len,
                      const uint8_t *data, size_t len,
                      uint8_t mac[RDT_SHA256_DIGEST_SIZE]);
 
+/* Longest HKDF-Expand output: 255 blocks */
+#define RDT_HKDF_SHA256_MAX_OUTPUT (255u * RDT_SHA256_DIGEST_SIZE)
+
+/*
+ * HKDF-SHA256 (RFC 5869). Extract turns input keying material into a
+ * pseudorandom key; a NULL or empty salt means HashLen zero bytes. Expand
+ * derives okm_len <= RDT_HKDF_SHA256_MAX_OUTPUT bytes bound to info, keying
+ * HMAC once for all of its blocks. rdt_hkdf_sha256 does both.
+ *
+ * Returns 0 on success, -1 on bad arguments.
+ */
+int rdt_hkdf_sha256_extract(const uint8_t *salt, size_t salt_len,
+                            const uint8_t *ikm, size_t ikm_len,
+                            uint8_t prk[RDT_SHA256_DIGEST_SIZE]);
+int rdt_hkdf_sha256_expand(const uint8_t *prk, size_t prk_len,
+                           const uint8_t *info, size_t info_len,
+                           uint8_t *okm, size_t okm_len);
+int rdt_hkdf_sha256(const uint8_t *salt, size_t salt_len,
+                    const uint8_t *ikm, size_t ikm_len,
+                    const uint8_t *info, size_t info_len,
+                    uint8_t *okm, size_t okm_len);
+
+/*
+ * PBKDF2-HMAC-SHA256 (RFC 8018) with iterations >= 1. The password's HMAC
+ * pads are hashed once and their midstates reused, so each iteration costs
+ * two compressions. Output blocks are computed in parallel on rdt_pool, and
+ * eight at a time per thread with AVX2 when the SHA extensions are not
+ * enabled.
+ *
+ * Returns 0 on success, -1 on bad arguments.
+ */
+int rdt_pbkdf2_sha256(const uint8_t *password, size_t password_len,
+                      const uint8_t *salt, size_t salt_len,
+                      uint32_t iterations,
+                      uint8_t *out, size_t out_len);
+
 #ifdef __cplusplus
 }
 #endif
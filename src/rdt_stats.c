@@ -0,0 +1,154 @@
+#include "rdt_stats.h"
+
+#include <string.h>
+
+#ifdef RDT_STATS
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Every block ever claimed, newest first; blocks are never freed */
+static _Atomic(rdt_stats_block *) blocks = NULL;
+
+/* Used by a thread whose block could not be allocated; its stores may race */
+static rdt_stats_block spill_block;
+
+_Thread_local rdt_stats_block *rdt_stats_tls_ = NULL;
+
+static pthread_key_t release_key;
+static pthread_once_t release_once = PTHREAD_ONCE_INIT;
+
+/* Thread exit: the block keeps its counts and waits for the next new thread */
+static void release_block(void *arg) {
+    rdt_stats_block *b = (rdt_stats_block *)arg;
+    atomic_store_explicit(&b->in_use, 0, memory_order_release);
+}
+
+static void make_release_key(void) {
+    pthread_key_create(&release_key, release_block);
+}
+
+rdt_stats_block *rdt_stats_block_(void) {
+    rdt_stats_block *b;
+
+    pthread_once(&release_once, make_release_key);
+    for (b = atomic_load_explicit(&blocks, memory_order_acquire); b; b = b->next) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong_explicit(&b->in_use, &expected, 1, memory_order_acq_rel,
+                                                    memory_order_relaxed)) {
+            break;
+        }
+    }
+    if (!b) {
+        b = (rdt_stats_block *)calloc(1, sizeof(*b));
+        if (!b) {
+            rdt_stats_tls_ = &spill_block;
+            return rdt_stats_tls_;
+        }
+        atomic_init(&b->in_use, 1);
+        b->next = atomic_load_explicit(&blocks, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&blocks, &b->next, b, memory_order_release,
+                                                      memory_order_relaxed)) {
+        }
+    }
+    pthread_setspecific(release_key, b);
+    rdt_stats_tls_ = b;
+    return b;
+}
+
+uint64_t rdt_stats_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void sum_block(const rdt_stats_block *b, uint64_t v[RDT_STAT_COUNTERS]) {
+    for (unsigned c = 0; c < RDT_STAT_COUNTERS; c++) {
+        v[c] += atomic_load_explicit(&b->v[c], memory_order_relaxed);
+    }
+}
+#endif
+
+int rdt_stats_snapshot(rdt_stats *out) {
+#ifdef RDT_STATS
+    uint64_t v[RDT_STAT_COUNTERS] = {0};
+#endif
+
+    if (!out) return -1;
+    memset(out, 0, sizeof(*out));
+#ifdef RDT_STATS
+    for (const rdt_stats_block *b = atomic_load_explicit(&blocks, memory_order_acquire); b; b = b->next) {
+        sum_block(b, v);
+        out->threads++;
+    }
+    sum_block(&spill_block, v);
+
+    out->enabled = 1;
+    for (unsigned d = 0; d < RDT_STATS_DEPTHS; d++) {
+        out->mix_depth[d] = v[RDT_STAT_MIX_DEPTH + d];
+        out->mix_calls += out->mix_depth[d];
+    }
+    out->sha256_compressions = v[RDT_STAT_SHA256_COMPRESSIONS];
+    out->prng_bytes = v[RDT_STAT_PRNG_BYTES];
+    out->prng_v2_bytes = v[RDT_STAT_PRNG_V2_BYTES];
+    out->drbg_generates = v[RDT_STAT_DRBG_GENERATES];
+    out->drbg_updates = v[RDT_STAT_DRBG_UPDATES];
+    out->drbg_reseeds = v[RDT_STAT_DRBG_RESEEDS];
+    out->drbg_bytes = v[RDT_STAT_DRBG_BYTES];
+    out->drbg_v2_generates = v[RDT_STAT_DRBG_V2_GENERATES];
+    out->drbg_v2_updates = v[RDT_STAT_DRBG_V2_UPDATES];
+    out->drbg_v2_reseeds = v[RDT_STAT_DRBG_V2_RESEEDS];
+    out->drbg_v2_bytes = v[RDT_STAT_DRBG_V2_BYTES];
+    out->seed_extractions = v[RDT_STAT_SEED_EXTRACTIONS];
+    out->seed_input_bytes = v[RDT_STAT_SEED_INPUT_BYTES];
+    out->seed_mix_parallel = v[RDT_STAT_SEED_MIX_PARALLEL];
+    out->seed_features_ns = v[RDT_STAT_SEED_FEATURES_NS];
+    out->seed_structure_ns = v[RDT_STAT_SEED_STRUCTURE_NS];
+    out->seed_mix_ns = v[RDT_STAT_SEED_MIX_NS];
+    out->seed_hash_ns = v[RDT_STAT_SEED_HASH_NS];
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+int rdt_stats_write_json(FILE *f, const rdt_stats *s) {
+    if (!f || !s) return -1;
+
+    const struct {
+        const char *name;
+        uint64_t value;
+    } fields[] = {
+        {"threads", s->threads},
+        {"mix_calls", s->mix_calls},
+        {"sha256_compressions", s->sha256_compressions},
+        {"prng_bytes", s->prng_bytes},
+        {"prng_v2_bytes", s->prng_v2_bytes},
+        {"drbg_generates", s->drbg_generates},
+        {"drbg_updates", s->drbg_updates},
+        {"drbg_reseeds", s->drbg_reseeds},
+        {"drbg_bytes", s->drbg_bytes},
+        {"drbg_v2_generates", s->drbg_v2_generates},
+        {"drbg_v2_updates", s->drbg_v2_updates},
+        {"drbg_v2_reseeds", s->drbg_v2_reseeds},
+        {"drbg_v2_bytes", s->drbg_v2_bytes},
+        {"seed_extractions", s->seed_extractions},
+        {"seed_input_bytes", s->seed_input_bytes},
+        {"seed_mix_parallel", s->seed_mix_parallel},
+        {"seed_features_ns", s->seed_features_ns},
+        {"seed_structure_ns", s->seed_structure_ns},
+        {"seed_mix_ns", s->seed_mix_ns},
+        {"seed_hash_ns", s->seed_hash_ns},
+    };
+
+    fprintf(f, "{\n  \"enabled\": %s", s->enabled ? "true" : "false");
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        fprintf(f, ",\n  \"%s\": %llu", fields[i].name, (unsigned long long)fields[i].value);
+    }
+    fprintf(f, ",\n  \"mix_depth\": [");
+    for (unsigned d = 0; d < RDT_STATS_DEPTHS; d++) {
+        fprintf(f, "%s%llu", d ? ", " : "", (unsigned long long)s->mix_depth[d]);
+    }
+    fprintf(f, "]\n}\n");
+    return ferror(f) ? -1 : 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * RDT Instrumentation Counters
+ * ============================
+ * Optional hot-path counters, compiled in with -DRDT_STATS (make stats):
+ * rdt_mix calls by rdt_depth_fast value (which sets the epsilon round
+ * count), SHA-256 compressions, PRNG and DRBG output, DRBG generate /
+ * update / reseed steps, and time spent in each seed-extractor stage.
+ *
+ * Each thread counts into its own block with plain relaxed stores, so
+ * recording takes no lock and no atomic read-modify-write; blocks are
+ * linked into a list once, on a thread's first event, and
+ * rdt_stats_snapshot() sums them. A thread that exits hands its block to
+ * the next new thread, so counts from finished threads stay in the totals.
+ *
+ * Without RDT_STATS the recording macros expand to nothing and
+ * rdt_stats_snapshot() reports all zeros with enabled == 0.
+ *
+ * Author: Steven Reid
+ * ORCID: 0009-0003-9132-3410
+ * License: MIT
+ */
+
+#ifndef RDT_STATS_H
+#define RDT_STATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* rdt_depth_fast() returns 0..63; rdt_mix runs min(depth, 6) + 1 epsilon rounds */
+#define RDT_STATS_DEPTHS 64u
+
+typedef struct {
+    int enabled;                       /* 0: built without RDT_STATS */
+    uint64_t threads;                  /* per-thread counter blocks in use or kept */
+
+    uint64_t mix_calls;                /* rdt_mix, each rdt_mix4 lane, the v2 stream mixer */
+    uint64_t mix_depth[RDT_STATS_DEPTHS];
+
+    uint64_t sha256_compressions;
+
+    uint64_t prng_bytes;               /* rdt_prng_next */
+    uint64_t prng_v2_bytes;            /* rdt_prng_v2_next, 8 per word (fill rounds up) */
+
+    uint64_t drbg_generates;           /* legacy rdt_drbg_ctx_* */
+    uint64_t drbg_updates;
+    uint64_t drbg_reseeds;
+    uint64_t drbg_bytes;
+
+    uint64_t drbg_v2_generates;
+    uint64_t drbg_v2_updates;
+    uint64_t drbg_v2_reseeds;
+    uint64_t drbg_v2_bytes;
+
+    uint64_t seed_extractions;         /* conditioning runs: one per seed, one per v2 leaf */
+    uint64_t seed_input_bytes;
+    uint64_t seed_mix_parallel;        /* mixer runs split level by level on rdt_pool */
+    uint64_t seed_features_ns;         /* tokenize / parse / typed records and the raw hash */
+    uint64_t seed_structure_ns;        /* structure fingerprint */
+    uint64_t seed_mix_ns;              /* precursor layer and recursive mixer */
+    uint64_t seed_hash_ns;             /* final domain-separated SHA-256 */
+} rdt_stats;
+
+/*
+ * Totals over all threads so far. Returns 0, or -1 (with *out zeroed) when
+ * built without RDT_STATS. Counters still being written by other threads
+ * are read as they stand.
+ */
+int rdt_stats_snapshot(rdt_stats *out);
+
+/* Write a snapshot as one JSON object; 0, or -1 on a write error */
+int rdt_stats_write_json(FILE *f, const rdt_stats *s);
+
+/* ========================================================================== */
+/* Recording (library internals)                                              */
+/* ========================================================================== */
+
+enum {
+    RDT_STAT_MIX_DEPTH,                /* RDT_STATS_DEPTHS slots */
+    RDT_STAT_SHA256_COMPRESSIONS = RDT_STAT_MIX_DEPTH + RDT_STATS_DEPTHS,
+    RDT_STAT_PRNG_BYTES,
+    RDT_STAT_PRNG_V2_BYTES,
+    RDT_STAT_DRBG_GENERATES,
+    RDT_STAT_DRBG_UPDATES,
+    RDT_STAT_DRBG_RESEEDS,
+    RDT_STAT_DRBG_BYTES,
+    RDT_STAT_DRBG_V2_GENERATES,
+    RDT_STAT_DRBG_V2_UPDATES,
+    RDT_STAT_DRBG_V2_RESEEDS,
+    RDT_STAT_DRBG_V2_BYTES,
+    RDT_STAT_SEED_EXTRACTIONS,
+    RDT_STAT_SEED_INPUT_BYTES,
+    RDT_STAT_SEED_MIX_PARALLEL,
+    RDT_STAT_SEED_FEATURES_NS,
+    RDT_STAT_SEED_STRUCTURE_NS,
+    RDT_STAT_SEED_MIX_NS,
+    RDT_STAT_SEED_HASH_NS,
+    RDT_STAT_COUNTERS
+};
+
+#ifdef RDT_STATS
+#include <stdatomic.h>
+
+typedef struct rdt_stats_block {
+    _Atomic uint64_t v[RDT_STAT_COUNTERS];
+    struct rdt_stats_block *next;      /* fixed once the block is published */
+    atomic_int in_use;
+} rdt_stats_block;
+
+extern _Thread_local rdt_stats_block *rdt_stats_tls_;
+
+/* The calling thread's block, claimed on first use */
+rdt_stats_block *rdt_stats_block_(void);
+
+uint64_t rdt_stats_now_ns(void);
+
+/* Only the owning thread writes a block, so load + store is enough */
+static inline void rdt_stats_add_(unsigned counter, uint64_t n) {
+    rdt_stats_block *b = rdt_stats_tls_ ? rdt_stats_tls_ : rdt_stats_block_();
+    atomic_store_explicit(&b->v[counter], atomic_load_explicit(&b->v[counter], memory_order_relaxed) + n,
+                          memory_order_relaxed);
+}
+
+#define RDT_STATS_ADD(counter, n) rdt_stats_add_((unsigned)(counter), (uint64_t)(n))
+/* Declare a stage timer, then add the time since the last lap to counter */
+#define RDT_STATS_TIMER(t) uint64_t t = rdt_stats_now_ns()
+#define RDT_STATS_LAP(counter, t)                          \
+    do {                                                   \
+        uint64_t rdt_stats_now_ = rdt_stats_now_ns();      \
+        RDT_STATS_ADD((counter), rdt_stats_now_ - (t));    \
+        (t) = rdt_stats_now_;                              \
+    } while (0)
+#else
+#define RDT_STATS_ADD(counter, n) ((void)0)
+#define RDT_STATS_TIMER(t) ((void)0)
+#define RDT_STATS_LAP(counter, t) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RDT_STATS_H */
@@ -0,0 +1,214 @@
+#include "rdt_drbg.h"
+#include "rdt_pool.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int hex_to_bytes(const char *hex, uint8_t *out, size_t out_len) {
+    size_t i;
+    if (strlen(hex) != out_len * 2u) {
+        return 0;
+    }
+    for (i = 0; i < out_len; i++) {
+        unsigned value;
+        if (sscanf(hex + i * 2u, "%2x", &value) != 1) {
+            return 0;
+        }
+        out[i] = (uint8_t)value;
+    }
+    return 1;
+}
+
+int main(void) {
+    rdt_drbg_ctx ctx;
+    rdt_drbg_ctx other;
+    uint8_t expected_first[64];
+    uint8_t expected_second[13];
+    uint8_t first[64];
+    uint8_t second[13];
+    uint8_t entropy[100];
+    uint8_t blob[1003];
+    uint8_t whole[1000];
+    uint8_t pieces[1000];
+    rdt_drbg_buf words;
+    uint8_t *serial;
+    uint8_t *parallel;
+    size_t big_len = 2u * RDT_DRBG_PARALLEL_MIN_BYTES + 29u;
+    uint64_t x;
+    size_t i;
+
+    for (i = 0; i < sizeof(entropy); i++) {
+        entropy[i] = (uint8_t)i;
+    }
+    for (i = 0; i < sizeof(blob); i++) {
+        blob[i] = (uint8_t)(i * 31u + 5u);
+    }
+    if (!hex_to_bytes("d35ccda77a0d4fa7dfbed837259950eb2b5d3ffe6e60b10994a2aa56c2097bc0"
+                      "d6f7bfec86b01b31d79c18ca01ec6b83803ac420c39d11e494c6e4d5631d91c4",
+                      expected_first, sizeof(expected_first)) ||
+        !hex_to_bytes("8bf4722a3a408a116c892b240a", expected_second, sizeof(expected_second))) {
+        fprintf(stderr, "failed to parse expected vectors\n");
+        return 1;
+    }
+
+    /* Known-answer vectors through the context-free API */
+    rdt_drbg_init_u64(0x123456789ABCDEF0ULL, 0x0F1E2D3C4B5A6978ULL, 0xA55AA55AA55AA55AULL);
+    if (rdt_drbg_generate(first, sizeof(first), NULL, 0u, 0) != 0 ||
+        rdt_drbg_generate(second, sizeof(second), (const uint8_t *)"rdt-legacy", 10u, 0) != 0) {
+        fprintf(stderr, "generate failed\n");
+        return 1;
+    }
+    if (memcmp(first, expected_first, sizeof(first)) != 0 ||
+        memcmp(second, expected_second, sizeof(second)) != 0) {
+        fprintf(stderr, "legacy DRBG known-answer test failed\n");
+        return 1;
+    }
+    rdt_drbg_reseed(entropy, sizeof(entropy), NULL, 0u);
+    if (rdt_drbg_next_u64() != 0x7fdd30ced176cd2aULL) {
+        fprintf(stderr, "legacy DRBG reseed known-answer test failed\n");
+        return 1;
+    }
+
+    /* The context API must reproduce the same stream */
+    rdt_drbg_ctx_init_u64(&ctx, 0x123456789ABCDEF0ULL, 0x0F1E2D3C4B5A6978ULL, 0xA55AA55AA55AA55AULL);
+    rdt_drbg_ctx_init_u64(&other, 1u, 2u, 3u);
+    if (rdt_drbg_ctx_generate(&ctx, first, sizeof(first), NULL, 0u, 0) != 0 ||
+        rdt_drbg_ctx_generate(&other, whole, 77u, NULL, 0u, 0) != 0 ||
+        rdt_drbg_ctx_generate(&ctx, second, sizeof(second), (const uint8_t *)"rdt-legacy", 10u, 0) != 0) {
+        fprintf(stderr, "context generate failed\n");
+        return 1;
+    }
+    if (memcmp(first, expected_first, sizeof(first)) != 0 ||
+        memcmp(second, expected_second, sizeof(second)) != 0) {
+        fprintf(stderr, "context API diverges from the known-answer vectors\n");
+        return 1;
+    }
+    rdt_drbg_ctx_reseed(&ctx, entropy, sizeof(entropy), NULL, 0u);
+    x = rdt_drbg_ctx_next_u64(&ctx);
+    if (x != 0x7fdd30ced176cd2aULL) {
+        fprintf(stderr, "context reseed known-answer test failed\n");
+        return 1;
+    }
+
+    /* Multi-word reseed input with a partial trailing word on both inputs */
+    rdt_drbg_ctx_init_u64(&ctx, 0x123456789ABCDEF0ULL, 0x0F1E2D3C4B5A6978ULL, 0xA55AA55AA55AA55AULL);
+    rdt_drbg_ctx_reseed(&ctx, blob, sizeof(blob), blob + 1, 37u);
+    if (rdt_drbg_ctx_next_u64(&ctx) != 0xcee016744f803895ULL) {
+        fprintf(stderr, "bulk reseed known-answer test failed\n");
+        return 1;
+    }
+
+    /* A shorter request from the same state is a prefix of a longer one */
+    rdt_drbg_ctx_init_u64(&ctx, 7u, 8u, 9u);
+    if (rdt_drbg_ctx_generate(&ctx, whole, sizeof(whole), NULL, 0u, 0) != 0) {
+        fprintf(stderr, "context generate failed\n");
+        return 1;
+    }
+    for (i = 1; i <= 72u; i++) {
+        rdt_drbg_ctx_init_u64(&other, 7u, 8u, 9u);
+        if (rdt_drbg_ctx_generate(&other, pieces, i, NULL, 0u, 0) != 0 ||
+            memcmp(whole, pieces, i) != 0) {
+            fprintf(stderr, "prefix mismatch at length %zu\n", i);
+            return 1;
+        }
+    }
+
+    /* Buffered words replay one generate call per batch, little-endian */
+    rdt_drbg_ctx_init_u64(&ctx, 21u, 22u, 23u);
+    rdt_drbg_ctx_init_u64(&other, 21u, 22u, 23u);
+    if (rdt_drbg_buf_init(&words, &ctx, 16u) != 0 ||
+        rdt_drbg_buf_init(&words, NULL, 16u) == 0 ||
+        rdt_drbg_buf_init(&words, &ctx, RDT_DRBG_BUF_MAX_WORDS + 1u) == 0 ||
+        rdt_drbg_buf_init(&words, &ctx, 16u) != 0) {
+        fprintf(stderr, "buffered init validation failed\n");
+        return 1;
+    }
+    for (i = 0; i < 2u; i++) {
+        size_t w;
+        if (rdt_drbg_ctx_generate(&other, pieces, 128u, NULL, 0u, 0) != 0) {
+            fprintf(stderr, "generate failed\n");
+            return 1;
+        }
+        for (w = 0; w < 16u; w++) {
+            uint64_t expect = 0;
+            unsigned j;
+            for (j = 0; j < 8u; j++) {
+                expect |= (uint64_t)pieces[w * 8u + j] << (8u * j);
+            }
+            if (w % 2u == 0) {
+                x = rdt_drbg_buf_next_u64(&words);
+            } else {
+                x = rdt_drbg_buf_next_u32(&words);
+                x |= (uint64_t)rdt_drbg_buf_next_u32(&words) << 32;
+            }
+            if (x != expect) {
+                fprintf(stderr, "buffered word %zu of batch %zu mismatch\n", w, i);
+                return 1;
+            }
+        }
+    }
+    (void)rdt_drbg_buf_next_u64(&words);
+    rdt_drbg_buf_discard(&words);
+    if (rdt_drbg_ctx_generate(&other, pieces, 128u, NULL, 0u, 0) != 0 ||
+        rdt_drbg_ctx_generate(&other, pieces, 128u, NULL, 0u, 0) != 0 ||
+        rdt_drbg_buf_next_u64(&words) != (uint64_t)pieces[0] + ((uint64_t)pieces[1] << 8) +
+                                           ((uint64_t)pieces[2] << 16) + ((uint64_t)pieces[3] << 24) +
+                                           ((uint64_t)pieces[4] << 32) + ((uint64_t)pieces[5] << 40) +
+                                           ((uint64_t)pieces[6] << 48) + ((uint64_t)pieces[7] << 56)) {
+        fprintf(stderr, "buffered discard did not start a fresh batch\n");
+        return 1;
+    }
+    rdt_drbg_buf_zeroize(&words);
+
+    /* Threaded large requests match the single-threaded output and state */
+    serial = (uint8_t *)malloc(big_len);
+    parallel = (uint8_t *)malloc(big_len);
+    if (!serial || !parallel) {
+        fprintf(stderr, "allocation failed\n");
+        free(serial);
+        free(parallel);
+        return 1;
+    }
+    rdt_pool_set_threads(1u);
+    rdt_drbg_ctx_init_u64(&ctx, 11u, 12u, 13u);
+    rdt_pool_set_threads(4u);
+    rdt_drbg_ctx_init_u64(&other, 11u, 12u, 13u);
+    rdt_pool_set_threads(1u);
+    if (rdt_drbg_ctx_generate(&ctx, serial, big_len, NULL, 0u, 0) != 0) {
+        fprintf(stderr, "serial generate failed\n");
+        free(serial);
+        free(parallel);
+        return 1;
+    }
+    rdt_pool_set_threads(4u);
+    if (rdt_drbg_ctx_generate(&other, parallel, big_len, NULL, 0u, 0) != 0) {
+        fprintf(stderr, "parallel generate failed\n");
+        free(serial);
+        free(parallel);
+        return 1;
+    }
+    rdt_pool_set_threads(0u);
+    if (memcmp(serial, parallel, big_len) != 0 ||
+        rdt_drbg_ctx_next_u64(&ctx) != rdt_drbg_ctx_next_u64(&other)) {
+        fprintf(stderr, "parallel generate diverges from serial\n");
+        free(serial);
+        free(parallel);
+        return 1;
+    }
+    free(serial);
+    free(parallel);
+
+    if (rdt_drbg_ctx_generate(NULL, first, sizeof(first), NULL, 0u, 0) == 0 ||
+        rdt_drbg_ctx_generate(&ctx, NULL, 1u, NULL, 0u, 0) == 0) {
+        fprintf(stderr, "error-path validation failed\n");
+        return 1;
+    }
+
+    rdt_drbg_ctx_zeroize(&ctx);
+    rdt_drbg_ctx_zeroize(&other);
+    rdt_drbg_zeroize();
+    puts("rdt_drbg_test: ok");
+    return 0;
+}
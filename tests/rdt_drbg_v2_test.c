@@ -64,6 +64,34 @@ int main(void) {
         return 1;
     }
 
+    /* Health-tested reseed: noisy input reseeds, a stuck source is refused */
+    {
+        rdt_health_config config;
+        rdt_health health;
+        rdt_drbg_v2_ctx before;
+        uint8_t noise[256];
+        uint8_t stuck[64];
+
+        for (i = 0; i < sizeof(noise); i++) {
+            noise[i] = (uint8_t)(i * 167u + (i >> 3));
+        }
+        memset(stuck, 0x3C, sizeof(stuck));
+        if (rdt_health_config_init(&config, 4.0, 1u, 0u) != 0 ||
+            rdt_health_init(&health, &config) != 0 ||
+            rdt_drbg_v2_reseed_health(&ctx, &health, noise, sizeof(noise), NULL, 0u) != RDT_DRBG_V2_OK ||
+            ctx.reseed_counter != 1u) {
+            fprintf(stderr, "health-tested reseed failed\n");
+            return 1;
+        }
+        before = ctx;
+        if (rdt_drbg_v2_reseed_health(&ctx, &health, stuck, sizeof(stuck), NULL, 0u) != RDT_DRBG_V2_ERR_HEALTH ||
+            rdt_drbg_v2_reseed_health(&ctx, &health, noise, sizeof(noise), NULL, 0u) != RDT_DRBG_V2_ERR_HEALTH ||
+            memcmp(&before, &ctx, sizeof(ctx)) != 0) {
+            fprintf(stderr, "stuck source was not refused\n");
+            return 1;
+        }
+    }
+
     if (rdt_drbg_v2_init_u64(&ctx, 0x123456789abcdef0ULL, 0x0f1e2d3c4b5a6978ULL, 0xa55aa55aa55aa55aULL) != RDT_DRBG_V2_OK) {
         fprintf(stderr, "u64 init failed\n");
         return 1;
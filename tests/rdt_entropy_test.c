@@ -0,0 +1,183 @@
+/*
+ * Checks for the SP 800-90B estimators: degenerate and structured inputs
+ * must assess near zero, good random data near full entropy, the MCV
+ * estimate must match its closed form, and reports must not depend on the
+ * thread count.
+ */
+#include "rdt_entropy.h"
+#include "rdt_pool.h"
+#include "rdt_test.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void fill_random(uint8_t *buf, size_t len, uint64_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(splitmix64(&seed) >> 56);
+    }
+}
+
+static int assess(const uint8_t *data, size_t len, unsigned bits, size_t max_samples,
+                  rdt_entropy_report *report) {
+    rdt_entropy_config config;
+
+    rdt_entropy_config_init(&config);
+    config.bits_per_symbol = bits;
+    config.max_samples = max_samples;
+    return rdt_entropy_assess(data, len, &config, report);
+}
+
+static void check_arguments(void) {
+    uint8_t data[16] = {0};
+    rdt_entropy_report report;
+    rdt_entropy_config config;
+
+    rdt_entropy_config_init(&config);
+    check(rdt_entropy_assess(NULL, sizeof(data), NULL, &report) == -1, "NULL data rejected");
+    check(rdt_entropy_assess(data, sizeof(data), NULL, NULL) == -1, "NULL report rejected");
+    check(rdt_entropy_assess(data, 1, NULL, &report) == -1, "single sample rejected");
+    config.bits_per_symbol = 9;
+    check(rdt_entropy_assess(data, sizeof(data), &config, &report) == -1, "9 bits per symbol rejected");
+    check(rdt_entropy_assess_file("/nonexistent/rdt_entropy", NULL, &report) == -1, "missing file rejected");
+    check(strcmp(rdt_entropy_estimator_name(RDT_ENTROPY_MULTI_MMC), "multi_mmc") == 0, "estimator name");
+    check(rdt_entropy_estimator_name(RDT_ENTROPY_ESTIMATORS) == NULL, "out of range name");
+}
+
+static void check_constant(void) {
+    uint8_t *data = (uint8_t *)malloc(100000);
+    rdt_entropy_report report;
+
+    if (!data) {
+        check(0, "constant: allocation");
+        return;
+    }
+    memset(data, 0x5A, 100000);
+    check(assess(data, 100000, 8, 0, &report) == 0, "constant: assess");
+    check(report.original[RDT_ENTROPY_MCV] < 0.001, "constant: MCV near 0");
+    check(report.min_entropy < 0.001, "constant: min-entropy near 0");
+    check(report.original[RDT_ENTROPY_COLLISION] < 0, "constant: collision not applicable");
+    free(data);
+}
+
+/*
+ * A fixed 8-sample pattern is perfectly predictable even though every
+ * symbol is equally common, so the counting estimators stay high while
+ * the predictors must catch it.
+ */
+static void check_periodic(void) {
+    static const uint8_t pattern[8] = {3, 141, 59, 26, 53, 58, 97, 93};
+    size_t len = 200000;
+    uint8_t *data = (uint8_t *)malloc(len);
+    rdt_entropy_report report;
+
+    if (!data) {
+        check(0, "periodic: allocation");
+        return;
+    }
+    for (size_t i = 0; i < len; i++) data[i] = pattern[i % 8u];
+    check(assess(data, len, 8, 0, &report) == 0, "periodic: assess");
+    check(report.original[RDT_ENTROPY_MCV] > 2.9, "periodic: MCV sees 8 symbols");
+    check(report.original[RDT_ENTROPY_LAG] < 0.01, "periodic: lag predictor");
+    check(report.original[RDT_ENTROPY_MULTI_MMC] < 0.01, "periodic: MultiMMC predictor");
+    check(report.original[RDT_ENTROPY_LZ78Y] < 0.01, "periodic: LZ78Y predictor");
+    check(report.original[RDT_ENTROPY_LRS] < 0.01, "periodic: LRS");
+    check(report.min_entropy < 0.01, "periodic: min-entropy near 0");
+    free(data);
+}
+
+/* 6.3.1 by hand: p_u = p + 2.576 sqrt(p (1 - p) / (n - 1)) */
+static void check_mcv_formula(void) {
+    size_t len = 10000;
+    uint8_t *data = (uint8_t *)malloc(len);
+    rdt_entropy_report report;
+    double p = 0.25;
+    double pu = p + 2.576 * sqrt(p * (1.0 - p) / (double)(len - 1u));
+
+    if (!data) {
+        check(0, "mcv: allocation");
+        return;
+    }
+    for (size_t i = 0; i < len; i++) data[i] = (uint8_t)((i * 7u) % 4u);
+    check(assess(data, len, 2, 0, &report) == 0, "mcv: assess");
+    check(fabs(report.original[RDT_ENTROPY_MCV] + log2(pu)) < 1e-9, "mcv: matches closed form");
+    free(data);
+}
+
+/*
+ * Independent bits with P(1) = 0.8 have min-entropy -log2(0.8) = 0.32. The
+ * counting estimators should find about that; the assessment as a whole
+ * may only go lower (compression is known to underestimate biased data).
+ */
+static void check_biased_bits(void) {
+    size_t len = 1000000;
+    uint8_t *data = (uint8_t *)malloc(len);
+    uint64_t state = 0x0123456789ABCDEFULL;
+    rdt_entropy_report report;
+
+    if (!data) {
+        check(0, "biased: allocation");
+        return;
+    }
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (uint8_t)((splitmix64(&state) >> 11) < (uint64_t)(0.8 * 9007199254740992.0));
+    }
+    check(assess(data, len, 1, 0, &report) == 0, "biased: assess");
+    check(report.original[RDT_ENTROPY_COLLISION] >= 0, "biased: binary estimators run");
+    check(report.min_entropy == report.h_original, "biased: binary min-entropy is h_original");
+    check(report.original[RDT_ENTROPY_MCV] > 0.30 && report.original[RDT_ENTROPY_MCV] < 0.33,
+          "biased: MCV near 0.32");
+    check(report.original[RDT_ENTROPY_COLLISION] > 0.29 && report.original[RDT_ENTROPY_COLLISION] < 0.33,
+          "biased: collision near 0.32");
+    check(report.original[RDT_ENTROPY_MARKOV] > 0.29 && report.original[RDT_ENTROPY_MARKOV] < 0.33,
+          "biased: Markov near 0.32");
+    check(report.min_entropy > 0.1 && report.min_entropy < 0.33, "biased: min-entropy at most 0.32");
+    free(data);
+}
+
+static void check_random_and_threads(void) {
+    size_t len = 1u << 19;
+    uint8_t *data = (uint8_t *)malloc(len);
+    rdt_entropy_report serial, parallel, prefix, cut;
+
+    if (!data) {
+        check(0, "random: allocation");
+        return;
+    }
+    fill_random(data, len, 42);
+
+    rdt_pool_set_threads(1);
+    check(assess(data, len, 8, 0, &serial) == 0, "random: serial assess");
+    rdt_pool_set_threads(4);
+    check(assess(data, len, 8, 0, &parallel) == 0, "random: parallel assess");
+    rdt_pool_set_threads(0);
+
+    check(serial.original[RDT_ENTROPY_MCV] > 7.8, "random: MCV above 7.8");
+    check(serial.h_original > 6.0, "random: h_original above 6");
+    check(serial.min_entropy > 6.0, "random: min-entropy above 6");
+    check(memcmp(serial.original, parallel.original, sizeof(serial.original)) == 0 &&
+          memcmp(serial.bitstring, parallel.bitstring, sizeof(serial.bitstring)) == 0 &&
+          serial.min_entropy == parallel.min_entropy,
+          "random: report independent of thread count");
+
+    check(assess(data, len, 8, 100000, &prefix) == 0, "random: max_samples assess");
+    check(assess(data, 100000, 8, 0, &cut) == 0, "random: prefix assess");
+    check(prefix.samples == 100000 &&
+          memcmp(prefix.original, cut.original, sizeof(cut.original)) == 0 &&
+          memcmp(prefix.bitstring, cut.bitstring, sizeof(cut.bitstring)) == 0,
+          "random: max_samples equals assessing the prefix");
+    free(data);
+}
+
+int main(void) {
+    check_arguments();
+    check_constant();
+    check_periodic();
+    check_mcv_formula();
+    check_biased_bits();
+    check_random_and_threads();
+
+    return test_finish("rdt_entropy_test");
+}
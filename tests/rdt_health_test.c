@@ -0,0 +1,176 @@
+/*
+ * Tests for the SP 800-90B health tests. The cutoffs must match Table 2 of
+ * SP 800-90B, and the vectorized RCT/APT must count exactly what a
+ * sample-at-a-time implementation of 4.4.1 / 4.4.2 counts, for every
+ * sample width and however the input is split across calls.
+ */
+#include "rdt_health.c"
+#include "rdt_test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* SP 800-90B 4.4.1 and 4.4.2, one sample at a time */
+typedef struct {
+    uint64_t samples, rct_failures, apt_windows, apt_failures;
+    uint64_t last, run;
+    uint64_t ref;
+    uint32_t seen, count;
+} reference;
+
+static void reference_sample(reference *r, const rdt_health_config *c, uint64_t x) {
+    if (r->samples && x == r->last) {
+        if (++r->run == c->rct_cutoff) r->rct_failures++;
+    } else {
+        r->last = x;
+        r->run = 1;
+    }
+
+    if (r->seen == 0) {
+        r->ref = x;
+        r->count = 1;
+    } else if (x == r->ref && ++r->count == c->apt_cutoff) {
+        r->apt_failures++;
+    }
+    if (++r->seen == c->apt_window) {
+        r->apt_windows++;
+        r->seen = 0;
+    }
+    r->samples++;
+}
+
+static void check_cutoffs(void) {
+    /* SP 800-90B Table 2, W = 512 */
+    static const double entropy[5] = {0.5, 1.0, 2.0, 4.0, 8.0};
+    static const uint32_t apt[5] = {410, 311, 177, 62, 13};
+    static const uint32_t rct[5] = {41, 21, 11, 6, 4};
+    rdt_health_config c;
+
+    for (int i = 0; i < 5; i++) {
+        check(rdt_health_config_init(&c, entropy[i], 1, 0) == 0, "config init");
+        check(c.apt_window == 512u && c.apt_cutoff == apt[i], "APT cutoff matches Table 2");
+        check(c.rct_cutoff == rct[i], "RCT cutoff is 1 + ceil(20 / H)");
+    }
+    check(rdt_health_config_init(&c, 1.0, 1, RDT_HEALTH_APT_WINDOW_BINARY) == 0 && c.apt_cutoff == 589u,
+          "binary APT cutoff matches Table 2");
+    check(rdt_health_config_init(&c, 12.0, 2, 0) == 0, "16-bit samples");
+    check(rdt_health_config_init(&c, 9.0, 1, 0) == -1, "entropy above sample width rejected");
+    check(rdt_health_config_init(&c, 0.0, 1, 0) == -1, "zero entropy rejected");
+    check(rdt_health_config_init(&c, 4.0, 3, 0) == -1, "odd sample width rejected");
+    check(rdt_health_config_init(&c, 4.0, 1, 1) == -1, "one-sample window rejected");
+}
+
+/*
+ * Samples from a small alphabet with long runs mixed in, so both tests
+ * fail many times at every width.
+ */
+static void make_samples(uint8_t *buf, size_t n, unsigned w, uint64_t seed) {
+    uint64_t x = 0;
+    size_t i = 0;
+
+    while (i < n) {
+        uint64_t r = splitmix64(&seed);
+        size_t run = (r & 7u) == 0 ? 1u + (size_t)((r >> 8) % 80u) : 1u;
+        if ((r & 0x1F0u) == 0) run += 600u;
+        x = (r >> 32) % ((r & 8u) ? 3u : 200u);
+        if (w > 1) x |= (uint64_t)((r >> 40) & 1u) << (8u * w - 1u);
+        for (; run && i < n; run--, i++) {
+            for (unsigned j = 0; j < w; j++) {
+                buf[i * w + j] = (uint8_t)(x >> (8u * j));
+            }
+        }
+    }
+}
+
+static void check_differential(void) {
+    static const unsigned widths[4] = {1, 2, 4, 8};
+    static const double entropy[3] = {0.5, 2.0, 6.0};
+    size_t n = 200000;
+    uint8_t *buf = (uint8_t *)malloc(n * 8u);
+    uint64_t seed = 7;
+
+    if (!buf) {
+        check(0, "differential: allocation");
+        return;
+    }
+    for (int wi = 0; wi < 4; wi++) {
+        unsigned w = widths[wi];
+
+        for (int hi = 0; hi < 3; hi++) {
+            rdt_health_config c;
+            rdt_health h;
+            reference r = {0};
+            size_t off = 0;
+            int rc = 0;
+
+            make_samples(buf, n, w, splitmix64(&seed));
+            rdt_health_config_init(&c, entropy[hi], w, 0);
+            rdt_health_init(&h, &c);
+            for (size_t i = 0; i < n; i++) {
+                reference_sample(&r, &c, load_sample(buf + i * w, w));
+            }
+            while (off < n * w) {
+                size_t len = (size_t)(splitmix64(&seed) % 3000u);
+                if (len > n * w - off) len = n * w - off;
+                rc = rdt_health_feed(&h, buf + off, len);
+                off += len;
+            }
+
+            check(h.samples == r.samples, "differential: sample count");
+            check(h.rct_failures == r.rct_failures, "differential: RCT failures");
+            check(h.apt_windows == r.apt_windows, "differential: APT windows");
+            check(h.apt_failures == r.apt_failures, "differential: APT failures");
+            check(r.rct_failures > 0 && r.apt_failures > 0, "differential: both tests exercised");
+            check(h.failed && rc == RDT_HEALTH_FAILED, "differential: failure latched");
+        }
+    }
+    free(buf);
+}
+
+static void check_sources(void) {
+    size_t n = 1u << 20;
+    uint8_t *buf = (uint8_t *)malloc(n);
+    uint64_t state = 99;
+    rdt_health_config c;
+    rdt_health h;
+
+    if (!buf) {
+        check(0, "sources: allocation");
+        return;
+    }
+    for (size_t i = 0; i < n; i++) buf[i] = (uint8_t)(splitmix64(&state) >> 56);
+
+    rdt_health_config_init(&c, 6.0, 1, 0);
+    rdt_health_init(&h, &c);
+    check(rdt_health_feed(&h, buf, n) == 0 && !h.failed, "random bytes pass");
+    check(h.samples == n && h.apt_windows == n / 512u, "random bytes counted");
+
+    /* A sensor stuck on one value fails the RCT after rct_cutoff samples */
+    memset(buf + 4096, 0x42, c.rct_cutoff - 1u);
+    rdt_health_reset(&h);
+    check(h.samples == 0 && !h.failed, "reset clears the monitor");
+    check(rdt_health_feed(&h, buf, 8192) == 0, "one sample short of the RCT cutoff passes");
+    memset(buf + 4096, 0x42, c.rct_cutoff);
+    rdt_health_reset(&h);
+    check(rdt_health_feed(&h, buf, 8192) == RDT_HEALTH_FAILED && h.rct_failures == 1,
+          "stuck sensor fails the RCT");
+    check(rdt_health_feed(&h, buf + 8192, 8192) == RDT_HEALTH_FAILED, "failure is latched");
+
+    /* A source stuck between two values passes the RCT but not the APT */
+    for (size_t i = 0; i < 4096; i++) buf[i] = (uint8_t)(i & 1u);
+    rdt_health_reset(&h);
+    check(rdt_health_feed(&h, buf, 4096) == RDT_HEALTH_FAILED && h.rct_failures == 0 &&
+          h.apt_failures == 8, "two-valued source fails the APT");
+
+    check(rdt_health_feed(NULL, buf, 1) == -1, "NULL monitor rejected");
+    check(rdt_health_init(&h, NULL) == -1, "NULL config rejected");
+    free(buf);
+}
+
+int main(void) {
+    check_cutoffs();
+    check_differential();
+    check_sources();
+
+    return test_finish("rdt_health_test");
+}
@@ -1,9 +1,15 @@
+#define _DEFAULT_SOURCE
+#include "rdt_pool.h"
 #include "rdt_seed_extractor.h"
 
+#include <dirent.h>
+#include <fcntl.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 static int hex_to_bytes(const char *hex, uint8_t *out, size_t out_len) {
     size_t i;
@@ -61,6 +67,288 @@ static int read_file(const char *path, uint8_t **data, size_t *len) {
     return 0;
 }
 
+/* Flip one byte in (or truncate) every cache entry so the next run has to rebuild */
+static void damage_cache(const char *dir, int truncate_entries) {
+    char path[512];
+    struct dirent *ent;
+    DIR *d = opendir(dir);
+
+    if (!d) return;
+    while ((ent = readdir(d)) != NULL) {
+        FILE *f;
+        if (ent->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+        if (truncate_entries) {
+            if (truncate(path, 40) != 0) continue;
+        } else if ((f = fopen(path, "r+b")) != NULL) {
+            int c;
+            fseek(f, 130, SEEK_SET);
+            c = fgetc(f);
+            fseek(f, 130, SEEK_SET);
+            fputc(c ^ 0x20, f);
+            fclose(f);
+        }
+    }
+    closedir(d);
+}
+
+static void remove_cache(const char *dir) {
+    char path[512];
+    struct dirent *ent;
+    DIR *d = opendir(dir);
+
+    if (!d) return;
+    while ((ent = readdir(d)) != NULL) {
+        if (ent->d_name[0] == '.') continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+        unlink(path);
+    }
+    closedir(d);
+    rmdir(dir);
+}
+
+/* Typed binary vectors over the CSV fixture's bytes, plus argument checks */
+static int check_typed(const uint8_t *data, size_t len, const uint8_t expected_single[32]) {
+    uint8_t want[32];
+    uint8_t seed[32];
+    uint8_t seed_file[32];
+
+    if (rdt_seed_extract_typed(data, len, RDT_SEED_FORMAT_TEXT, 0u, seed) != 0 ||
+        memcmp(seed, expected_single, 32) != 0) {
+        return 0;
+    }
+    if (!hex_to_bytes("11d83ac1ad99e3fdc289380398da035a250ad2da91af132170dd7bd0e5fe016c",
+                      want, sizeof(want)) ||
+        rdt_seed_extract_typed(data, len, RDT_SEED_FORMAT_I16LE, 0u, seed) != 0 ||
+        memcmp(seed, want, 32) != 0 ||
+        rdt_seed_extract_file_typed("examples/sensor_data.csv", RDT_SEED_FORMAT_I16LE, 2u,
+                                    seed_file) != 0 ||
+        memcmp(seed_file, want, 32) != 0) {
+        return 0;
+    }
+    if (!hex_to_bytes("9ca879e8a7ce3dcf283fd7f74bdd2e27dd94c03353f4c6f391fa3c72c491a277",
+                      want, sizeof(want)) ||
+        rdt_seed_extract_typed(data, len, RDT_SEED_FORMAT_F32LE, 12u, seed) != 0 ||
+        memcmp(seed, want, 32) != 0) {
+        return 0;
+    }
+    return rdt_seed_extract_typed(data, len, RDT_SEED_FORMAT_I32LE, 3u, seed) != 0 &&
+           rdt_seed_extract_typed(data, len, RDT_SEED_FORMAT_F64LE,
+                                  RDT_SEED_MAX_STRIDE + 1u, seed) != 0 &&
+           rdt_seed_extract_typed(data, len, 9u, 0u, seed) != 0;
+}
+
+/* Cold, warm, corrupted and truncated caches must all give the uncached seeds */
+static int check_cache(const char **files, const uint8_t expected_single[32],
+                       const uint8_t expected_duplicate[32]) {
+    char dir[] = "/tmp/rdt_seed_cache_XXXXXX";
+    uint8_t seed[32];
+    int round;
+    int ok = 1;
+
+    if (!mkdtemp(dir)) return 0;
+    for (round = 0; round < 4 && ok; round++) {
+        if (round == 2) damage_cache(dir, 0);
+        if (round == 3) damage_cache(dir, 1);
+        ok = rdt_seed_extract_file_cached(dir, files[0], seed) == 0 &&
+             memcmp(seed, expected_single, 32) == 0 &&
+             rdt_seed_extract_files_cached(dir, files, 2u, seed) == 0 &&
+             memcmp(seed, expected_duplicate, 32) == 0;
+    }
+    ok = ok && rdt_seed_extract_files_cached(NULL, files, 2u, seed) != 0 &&
+         rdt_seed_extract_file_cached(dir, "examples/does_not_exist.csv", seed) != 0;
+    remove_cache(dir);
+    return ok;
+}
+
+/*
+ * An edit that keeps the size and mtime (same-granule writes, restored
+ * timestamps) must still miss the cache: the seed has to follow the new bytes.
+ * The input is the fixture repeated to well over 32 KiB, so the edited byte
+ * is not one a sampling key would have read.
+ */
+static int check_cache_same_stat(const uint8_t *data, size_t data_len) {
+    const size_t reps = 200u;
+    size_t len = data_len * reps;
+    char dir[] = "/tmp/rdt_seed_cache_XXXXXX";
+    char path[64];
+    uint8_t *copy;
+    uint8_t seed[32];
+    uint8_t want[32];
+    struct stat st;
+    struct timespec times[2];
+    FILE *f;
+    int ok;
+
+    if (data_len < 2u || !mkdtemp(dir)) return 0;
+    copy = (uint8_t *)malloc(len);
+    if (!copy) {
+        rmdir(dir);
+        return 0;
+    }
+    for (size_t r = 0; r < reps; r++) {
+        memcpy(copy + r * data_len, data, data_len);
+    }
+    snprintf(path, sizeof(path), "%s.in", dir);
+    f = fopen(path, "wb");
+    ok = f && fwrite(copy, 1, len, f) == len;
+    if (f) ok = (fclose(f) == 0) && ok;
+    ok = ok && stat(path, &st) == 0 &&
+         rdt_seed_extract_file_cached(dir, path, seed) == 0;
+
+    /* Change one digit away from the ends of the file, then put the mtime back */
+    if (ok) {
+        size_t at = len / 2u;
+        while (at < len && (copy[at] < '0' || copy[at] > '8')) at++;
+        ok = at < len;
+        if (ok) {
+            copy[at]++;
+            f = fopen(path, "r+b");
+            ok = f && fseek(f, (long)at, SEEK_SET) == 0 && fputc(copy[at], f) != EOF;
+            if (f) ok = (fclose(f) == 0) && ok;
+        }
+        times[0] = st.st_atim;
+        times[1] = st.st_mtim;
+        ok = ok && utimensat(AT_FDCWD, path, times, 0) == 0;
+    }
+    ok = ok && rdt_seed_extract_file_cached(dir, path, seed) == 0 &&
+         rdt_seed_extract(copy, len, want) == 0 && memcmp(seed, want, 32) == 0;
+
+    unlink(path);
+    remove_cache(dir);
+    free(copy);
+    return ok;
+}
+
+/*
+ * A peek after every step must equal the final seed of a fresh stream over
+ * the same prefix, and must not disturb the seed of the whole input.
+ */
+static int check_peek(const uint8_t *data, size_t len, size_t step,
+                      const uint8_t *expected_whole) {
+    rdt_seed_extractor_ctx live;
+    rdt_seed_extractor_ctx prefix;
+    uint8_t peeked[32];
+    uint8_t seed[32];
+    size_t off;
+    int ok = 1;
+
+    if (rdt_seed_extractor_init(&live, RDT_SEED_STREAM_V1) != 0) return 0;
+    ok = rdt_seed_extractor_peek(&live, peeked) == 0;
+    for (off = 0; ok && off < len; off += step) {
+        size_t n = (len - off < step) ? len - off : step;
+        ok = rdt_seed_extractor_update(&live, data + off, n) == 0 &&
+             rdt_seed_extractor_peek(&live, peeked) == 0 &&
+             rdt_seed_extractor_init(&prefix, RDT_SEED_STREAM_V1) == 0 &&
+             rdt_seed_extractor_update(&prefix, data, off + n) == 0 &&
+             rdt_seed_extractor_final(&prefix, seed) == 0 &&
+             memcmp(peeked, seed, 32) == 0;
+    }
+    ok = ok && rdt_seed_extractor_final(&live, seed) == 0 &&
+         (!expected_whole || memcmp(seed, expected_whole, 32) == 0) &&
+         rdt_seed_extractor_peek(&live, peeked) != 0 &&
+         rdt_seed_extractor_peek(NULL, peeked) != 0;
+    rdt_seed_extractor_abort(&live);
+    return ok;
+}
+
+/*
+ * A monitor that passes leaves every seed unchanged; a stuck sensor blocks
+ * arena and stream output, and the failure outlives the input that caused it.
+ */
+static int check_health(const uint8_t *data, size_t len, const uint8_t expected_single[32],
+                        const uint8_t expected_stream[32]) {
+    static const uint8_t stuck[4096];
+    rdt_health_config config;
+    rdt_health health;
+    rdt_seed_arena arena;
+    rdt_seed_extractor_ctx stream;
+    uint8_t seed[32];
+    int ok;
+
+    if (rdt_health_config_init(&config, 0.3, 1u, 0u) != 0 ||
+        rdt_health_init(&health, &config) != 0) {
+        return 0;
+    }
+    rdt_seed_arena_init(&arena);
+    rdt_seed_arena_set_health(&arena, &health);
+    ok = rdt_seed_extract_arena(&arena, data, len, seed) == 0 &&
+         memcmp(seed, expected_single, 32) == 0 &&
+         health.samples == len && !health.failed;
+    ok = ok && rdt_seed_extract_arena(&arena, stuck, sizeof(stuck), seed) == RDT_SEED_ERR_HEALTH &&
+         rdt_seed_extract_arena(&arena, data, len, seed) == RDT_SEED_ERR_HEALTH;
+    rdt_health_reset(&health);
+    ok = ok && rdt_seed_extract_file_arena(&arena, "examples/sensor_data.csv", seed) == 0 &&
+         memcmp(seed, expected_single, 32) == 0 && health.samples == len;
+    rdt_seed_arena_release(&arena);
+
+    rdt_health_reset(&health);
+    ok = ok && rdt_seed_extractor_init(&stream, RDT_SEED_STREAM_V1) == 0 &&
+         rdt_seed_extractor_set_health(&stream, &health) == 0 &&
+         rdt_seed_extractor_update(&stream, data, len) == 0 &&
+         rdt_seed_extractor_final(&stream, seed) == 0 &&
+         memcmp(seed, expected_stream, 32) == 0;
+
+    rdt_health_reset(&health);
+    ok = ok && rdt_seed_extractor_init(&stream, RDT_SEED_STREAM_V1) == 0 &&
+         rdt_seed_extractor_set_health(&stream, &health) == 0 &&
+         rdt_seed_extractor_update(&stream, data, len) == 0 &&
+         rdt_seed_extractor_update(&stream, stuck, sizeof(stuck)) == RDT_SEED_ERR_HEALTH &&
+         rdt_seed_extractor_peek(&stream, seed) == RDT_SEED_ERR_HEALTH &&
+         rdt_seed_extractor_final(&stream, seed) == RDT_SEED_ERR_HEALTH;
+    return ok && rdt_seed_extractor_set_health(NULL, &health) != 0;
+}
+
+/*
+ * Tree mode vectors: a single-leaf file, a multi-leaf buffer that ends in a
+ * partial leaf, and a file list. Seeds must not depend on the thread count,
+ * and must differ from v1.
+ */
+static int check_tree(const uint8_t *data, size_t len, const uint8_t *big,
+                      const char **files, const uint8_t expected_single[32]) {
+    char empty_path[] = "/tmp/rdt_seed_empty_XXXXXX";
+    const char *with_empty[2];
+    size_t big_len = 4u * RDT_SEED_V2_LEAF_BYTES + 777u;
+    uint8_t want[32];
+    uint8_t seed[32];
+    uint8_t serial[32];
+    int ok;
+    int fd;
+
+    ok = hex_to_bytes("1a06bdd4aebe4ae6584693b59df44a91662341583de9a5ede576540d704ab957",
+                      want, sizeof(want)) &&
+         rdt_seed_extract_v2(data, len, seed) == 0 && memcmp(seed, want, 32) == 0 &&
+         memcmp(seed, expected_single, 32) != 0 &&
+         rdt_seed_extract_file_v2("examples/sensor_data.csv", seed) == 0 &&
+         memcmp(seed, want, 32) == 0;
+
+    rdt_pool_set_threads(1u);
+    ok = ok && rdt_seed_extract_v2(big, big_len, serial) == 0;
+    rdt_pool_set_threads(4u);
+    ok = ok && rdt_seed_extract_v2(big, big_len, seed) == 0 && memcmp(seed, serial, 32) == 0 &&
+         hex_to_bytes("5197ec206cbd09c159fba7b5c1730824d3df1c2a7549ef187ca0f0e55bb4281d", want, sizeof(want)) && memcmp(seed, want, 32) == 0;
+    rdt_pool_set_threads(0u);
+
+    ok = ok && hex_to_bytes("42fa71edb536322313275a9c23df1016ce7e9e496550a3cee369cc637b459fc8",
+                            want, sizeof(want)) &&
+         rdt_seed_extract_files_v2(files, 2u, seed) == 0 && memcmp(seed, want, 32) == 0;
+
+    /* An empty file has no leaves but still counts as a file */
+    fd = mkstemp(empty_path);
+    if (fd < 0) return 0;
+    close(fd);
+    with_empty[0] = files[0];
+    with_empty[1] = empty_path;
+    ok = ok && rdt_seed_extract_files_v2(with_empty, 2u, seed) == 0 &&
+         rdt_seed_extract_files_v2(with_empty, 1u, serial) == 0 && memcmp(seed, serial, 32) != 0;
+    unlink(empty_path);
+
+    return ok && rdt_seed_extract_v2(NULL, len, seed) != 0 &&
+           rdt_seed_extract_v2(data, 0u, seed) != 0 &&
+           rdt_seed_extract_file_v2("examples/does_not_exist.csv", seed) != 0 &&
+           rdt_seed_extract_files_v2(files, 0u, seed) != 0;
+}
+
 int main(void) {
     static const uint64_t expected_words[4] = {
         0x12121de16b74cbf2ULL,
@@ -74,12 +362,21 @@ int main(void) {
     };
     uint8_t expected_single[32];
     uint8_t expected_duplicate[32];
+    uint8_t expected_stream[32];
+    uint8_t seed_stream[32];
+    rdt_seed_extractor_ctx stream;
+    size_t chunk;
+    size_t off;
+    int fd;
     uint8_t seed_api[32];
     uint8_t seed_file[32];
     uint8_t seed_dup_a[32];
     uint8_t seed_dup_b[32];
     uint64_t words[4];
     uint8_t *data = NULL;
+    uint8_t *big;
+    uint8_t seed_serial[32];
+    uint8_t seed_parallel[32];
     size_t len = 0;
     int i;
 
@@ -94,6 +391,12 @@ int main(void) {
         return 1;
     }
 
+    if (!hex_to_bytes("b0a229c8b17728b699725bf3484f852f0d16d39c0798204d40874aa983bef3aa",
+                      expected_stream, sizeof(expected_stream))) {
+        fprintf(stderr, "failed to parse expected stream seed\n");
+        return 1;
+    }
+
     if (read_file("examples/sensor_data.csv", &data, &len) != 0) {
         fprintf(stderr, "failed to read examples/sensor_data.csv\n");
         return 1;
@@ -151,6 +454,152 @@ int main(void) {
         return 1;
     }
 
+    /* Pools over the parallel threshold mix the same way on several threads */
+    big = (uint8_t *)malloc(len * 2048u);
+    if (!big) {
+        fprintf(stderr, "allocation failed\n");
+        free(data);
+        return 1;
+    }
+    for (off = 0; off < 2048u; off++) {
+        memcpy(big + off * len, data, len);
+        big[off * len] ^= (uint8_t)off;
+    }
+    rdt_pool_set_threads(1u);
+    if (rdt_seed_extract(big, len * 2048u, seed_serial) != 0) {
+        fprintf(stderr, "serial extraction failed\n");
+        free(big);
+        free(data);
+        return 1;
+    }
+    rdt_pool_set_threads(4u);
+    if (rdt_seed_extract(big, len * 2048u, seed_parallel) != 0 ||
+        memcmp(seed_serial, seed_parallel, sizeof(seed_serial)) != 0) {
+        fprintf(stderr, "parallel mixer diverges from serial\n");
+        free(big);
+        free(data);
+        return 1;
+    }
+    rdt_pool_set_threads(0u);
+
+    /* One arena reused across inputs of different sizes, wiped after each */
+    {
+        rdt_seed_arena arena;
+        uint8_t seed_arena[32];
+        int ok = 1;
+
+        rdt_seed_arena_init(&arena);
+        ok &= rdt_seed_extract_arena(&arena, data, len, seed_arena) == 0 &&
+              memcmp(seed_arena, expected_single, sizeof(seed_arena)) == 0;
+        ok &= rdt_seed_extract_arena(&arena, big, len * 2048u, seed_arena) == 0 &&
+              memcmp(seed_arena, seed_serial, sizeof(seed_arena)) == 0;
+        ok &= rdt_seed_extract_file_arena(&arena, "examples/sensor_data.csv", seed_arena) == 0 &&
+              memcmp(seed_arena, expected_single, sizeof(seed_arena)) == 0;
+        ok &= rdt_seed_extract_files_arena(&arena, duplicate_files, 2u, seed_arena) == 0 &&
+              memcmp(seed_arena, expected_duplicate, sizeof(seed_arena)) == 0;
+        ok &= rdt_seed_extract_arena(&arena, NULL, len, seed_arena) != 0 &&
+              rdt_seed_extract_arena(NULL, data, len, seed_arena) != 0;
+        for (off = 0; ok && off < arena.capacity; off++) {
+            ok = (arena.base[off] == 0);
+        }
+        rdt_seed_arena_release(&arena);
+        if (!ok || arena.base != NULL) {
+            fprintf(stderr, "arena extraction mismatch or arena not wiped\n");
+            free(big);
+            free(data);
+            return 1;
+        }
+    }
+
+    /* Peeks across several 64 KiB record blocks */
+    if (!check_peek(big, len * 2048u, 150001u, NULL)) {
+        fprintf(stderr, "stream peek mismatch on multi-block input\n");
+        free(big);
+        free(data);
+        return 1;
+    }
+    if (!check_tree(data, len, big, duplicate_files, expected_single)) {
+        fprintf(stderr, "tree mode (v2) seed mismatch\n");
+        free(big);
+        free(data);
+        return 1;
+    }
+    free(big);
+
+    if (!check_typed(data, len, expected_single)) {
+        fprintf(stderr, "typed binary extraction mismatch\n");
+        free(data);
+        return 1;
+    }
+
+    if (!check_cache(duplicate_files, expected_single, expected_duplicate)) {
+        fprintf(stderr, "cached extraction mismatch\n");
+        free(data);
+        return 1;
+    }
+    if (!check_cache_same_stat(data, len)) {
+        fprintf(stderr, "cache reused features of a file edited without a size or mtime change\n");
+        free(data);
+        return 1;
+    }
+
+    /* Streaming v1: same seed for every chunking and for fd input */
+    for (chunk = 1; chunk <= len; chunk = chunk * 3u + 4u) {
+        if (rdt_seed_extractor_init(&stream, RDT_SEED_STREAM_V1) != 0) {
+            fprintf(stderr, "stream init failed\n");
+            free(data);
+            return 1;
+        }
+        for (off = 0; off < len; off += chunk) {
+            size_t n = (len - off < chunk) ? len - off : chunk;
+            if (rdt_seed_extractor_update(&stream, data + off, n) != 0) {
+                fprintf(stderr, "stream update failed\n");
+                rdt_seed_extractor_abort(&stream);
+                free(data);
+                return 1;
+            }
+        }
+        if (rdt_seed_extractor_final(&stream, seed_stream) != 0 ||
+            memcmp(seed_stream, expected_stream, sizeof(seed_stream)) != 0) {
+            fprintf(stderr, "stream seed mismatch for %zu-byte chunks\n", chunk);
+            free(data);
+            return 1;
+        }
+    }
+
+    fd = open("examples/sensor_data.csv", O_RDONLY);
+    if (fd < 0 ||
+        rdt_seed_extractor_init(&stream, RDT_SEED_STREAM_V1) != 0 ||
+        rdt_seed_extractor_update_fd(&stream, fd) != 0 ||
+        rdt_seed_extractor_final(&stream, seed_stream) != 0 ||
+        memcmp(seed_stream, expected_stream, sizeof(seed_stream)) != 0) {
+        fprintf(stderr, "stream fd seed mismatch\n");
+        if (fd >= 0) close(fd);
+        free(data);
+        return 1;
+    }
+    close(fd);
+
+    if (!check_peek(data, len, 7u, expected_stream)) {
+        fprintf(stderr, "stream peek mismatch or peek disturbed the stream\n");
+        free(data);
+        return 1;
+    }
+
+    if (!check_health(data, len, expected_single, expected_stream)) {
+        fprintf(stderr, "health-tested extraction mismatch\n");
+        free(data);
+        return 1;
+    }
+
+    if (rdt_seed_extractor_init(&stream, 99u) == 0 ||
+        rdt_seed_extractor_update(&stream, data, len) == 0 ||
+        rdt_seed_extractor_final(&stream, seed_stream) == 0) {
+        fprintf(stderr, "stream error-path validation failed\n");
+        free(data);
+        return 1;
+    }
+
     if (rdt_seed_extract(NULL, len, seed_api) == 0 ||
         rdt_seed_extract(data, 0u, seed_api) == 0 ||
         rdt_seed_extract_file("examples/does_not_exist.csv", seed_api) == 0) {
@@ -0,0 +1,340 @@
+/*
+ * Differential test for the seed extractor's numeric scanner. The vectorized
+ * tokenizer and fast decimal conversion must emit exactly the records (and
+ * consume exactly the bytes) of the original byte-at-a-time scanner that
+ * copied every token and called strtod(). Typed binary input is checked the
+ * same way against a value-by-value loop.
+ */
+#include "rdt_seed_extractor.c"
+
+#include <ctype.h>
+#include <stdio.h>
+
+/* The scanner before the vectorized tokenizer, kept verbatim as the reference */
+static size_t reference_scan(const uint8_t *data, size_t len, uint64_t base, int final,
+                             uint32_t *line_num, byte_buffer *out) {
+    size_t i = 0;
+
+    while (i < len) {
+        unsigned char ch = data[i];
+        if (ch == '\n') {
+            (*line_num)++;
+            i++;
+            continue;
+        }
+
+        if (!final && len - i < NUMERIC_LOOKAHEAD &&
+            (isdigit((int)ch) || ch == '-' || ch == '+' || ch == '.')) {
+            break;
+        }
+
+        if (isdigit((int)ch) ||
+            ((ch == '-' || ch == '+' || ch == '.') &&
+             i + 1 < len && (isdigit((int)(unsigned char)data[i + 1]) || data[i + 1] == '.'))) {
+
+            uint32_t pos = (uint32_t)(base + i);
+            char num_buf[64];
+            size_t num_len = 0;
+            size_t j = i;
+
+            if (j < len && (data[j] == '-' || data[j] == '+')) {
+                num_buf[num_len++] = (char)data[j++];
+            }
+            while (j < len && isdigit((int)(unsigned char)data[j]) && num_len < 60) {
+                num_buf[num_len++] = (char)data[j++];
+            }
+            if (j < len && data[j] == '.') {
+                num_buf[num_len++] = (char)data[j++];
+                while (j < len && isdigit((int)(unsigned char)data[j]) && num_len < 60) {
+                    num_buf[num_len++] = (char)data[j++];
+                }
+            }
+            if (j < len && (data[j] == 'e' || data[j] == 'E')) {
+                num_buf[num_len++] = (char)data[j++];
+                if (j < len && (data[j] == '-' || data[j] == '+')) {
+                    num_buf[num_len++] = (char)data[j++];
+                }
+                while (j < len && isdigit((int)(unsigned char)data[j]) && num_len < 60) {
+                    num_buf[num_len++] = (char)data[j++];
+                }
+            }
+            num_buf[num_len] = '\0';
+
+            if (num_len > 0 && num_len < 60) {
+                char *endptr;
+                double val = strtod(num_buf, &endptr);
+                if (endptr != num_buf && isfinite(val)) {
+                    buffer_append_u32_le(out, pos);
+                    buffer_append_u32_le(out, *line_num);
+                    buffer_append_double_le(out, val);
+                }
+            }
+            i = j;
+        } else {
+            i++;
+        }
+    }
+    return i;
+}
+
+#define PAD_BYTES 80u
+
+static unsigned long checked = 0;
+
+static void print_input(const uint8_t *data, size_t len) {
+    fputc('"', stderr);
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] == '\n') {
+            fputs("\\n", stderr);
+        } else {
+            fputc(data[i], stderr);
+        }
+    }
+    fputs("\"\n", stderr);
+}
+
+static int compare_once(const uint8_t *data, size_t len, int final) {
+    byte_buffer want, got;
+    uint32_t want_line = 7, got_line = 7;
+    size_t want_used, got_used;
+    int ok;
+
+    buffer_init(&want, 64);
+    buffer_init(&got, 64);
+    want_used = reference_scan(data, len, 1000, final, &want_line, &want);
+    got_used = scan_numbers(data, len, 1000, final, &got_line, &got);
+    ok = !want.failed && !got.failed && want_used == got_used && want_line == got_line &&
+         want.len == got.len && memcmp(want.data, got.data, want.len) == 0;
+    if (!ok) {
+        fprintf(stderr, "scanner mismatch (final=%d, used %zu/%zu, records %zu/%zu) on ",
+                final, want_used, got_used, want.len / 16u, got.len / 16u);
+        print_input(data, len);
+    }
+    buffer_free(&want);
+    buffer_free(&got);
+    checked++;
+    return ok ? 0 : -1;
+}
+
+/*
+ * Check s on its own (scalar tail path), followed by filler so the 64-byte
+ * masked path runs, and behind a prefix so vector skipping runs first.
+ */
+static int compare_input(const uint8_t *s, size_t len) {
+    uint8_t buf[2u * PAD_BYTES + 256u];
+
+    if (len > 256u) return -1;
+    if (compare_once(s, len, 1) != 0 || compare_once(s, len, 0) != 0) return -1;
+
+    memcpy(buf, s, len);
+    memset(buf + len, 'x', PAD_BYTES);
+    if (compare_once(buf, len + PAD_BYTES, 1) != 0 ||
+        compare_once(buf, len + PAD_BYTES, 0) != 0) {
+        return -1;
+    }
+
+    memset(buf, ' ', 37u);
+    buf[11] = '\n';
+    memcpy(buf + 37u, s, len);
+    memset(buf + 37u + len, ';', PAD_BYTES);
+    return compare_once(buf, 37u + len + PAD_BYTES, 1);
+}
+
+/* Every string up to max_len over the alphabet */
+static int exhaustive(const char *alphabet, size_t max_len) {
+    size_t n = strlen(alphabet);
+    size_t idx[16];
+    uint8_t s[16];
+
+    for (size_t len = 1; len <= max_len; len++) {
+        memset(idx, 0, sizeof(idx));
+        for (;;) {
+            size_t k;
+            for (k = 0; k < len; k++) {
+                s[k] = (uint8_t)alphabet[idx[k]];
+            }
+            if (compare_input(s, len) != 0) return -1;
+            for (k = 0; k < len && ++idx[k] == n; k++) {
+                idx[k] = 0;
+            }
+            if (k == len) break;
+        }
+    }
+    return 0;
+}
+
+/* Tokens around the 60-byte digit limit, with every sign and exponent form */
+static int long_tokens(void) {
+    static const char *const signs[] = {"", "-", "+"};
+    static const char *const exps[] = {"", "e", "E+", "e-", "e7", "e-12", "E+308", "e-400"};
+    char s[256];
+
+    for (size_t sg = 0; sg < 3u; sg++) {
+        for (size_t a = 0; a <= 62u; a++) {
+            for (size_t b = 0; b <= 63u; b++) {
+                for (size_t e = 0; e < sizeof(exps) / sizeof(exps[0]); e++) {
+                    size_t n = 0;
+                    n += (size_t)sprintf(s + n, "%s", signs[sg]);
+                    for (size_t k = 0; k < a; k++) s[n++] = (char)('0' + (k + 1u) % 10u);
+                    if (b) {
+                        s[n++] = '.';
+                        for (size_t k = 1; k < b; k++) s[n++] = (char)('0' + (k * 7u) % 10u);
+                    }
+                    n += (size_t)sprintf(s + n, "%s", exps[e]);
+                    if (compare_input((const uint8_t *)s, n) != 0) return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t next_random(void) {
+    uint64_t z = (rng_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Random mantissas up to 25 digits with random point placement and exponents */
+static int random_tokens(size_t count) {
+    char s[128];
+
+    for (size_t t = 0; t < count; t++) {
+        uint64_t r = next_random();
+        size_t digits = 1u + (size_t)(r % 25u);
+        size_t point = (size_t)((r >> 8) % (digits + 2u));
+        size_t n = 0;
+
+        if ((r >> 16) & 1u) s[n++] = ((r >> 17) & 1u) ? '-' : '+';
+        for (size_t k = 0; k < digits; k++) {
+            if (k == point) s[n++] = '.';
+            s[n++] = (char)('0' + next_random() % 10u);
+        }
+        if ((r >> 18) & 1u) {
+            n += (size_t)sprintf(s + n, "e%d", (int)((r >> 20) % 241u) - 120);
+        }
+        if (compare_input((const uint8_t *)s, n) != 0) return -1;
+    }
+    return 0;
+}
+
+/*
+ * Decimal forms of random doubles and of points halfway between neighbours,
+ * which are the cases where a truncated power of five could round wrongly.
+ */
+static int near_halfway(size_t count) {
+    static const char *const formats[] = {"%.15Le", "%.16Le", "%.17Le", "%.18Le", "%.19Le"};
+    char s[128];
+
+    for (size_t t = 0; t < count; t++) {
+        uint64_t bits = next_random();
+        double d;
+        long double mid;
+
+        /* exponents within roughly 1e-100 .. 1e100 */
+        bits = (bits & 0x800FFFFFFFFFFFFFULL) | ((uint64_t)(1023 - 332 + next_random() % 665u) << 52);
+        memcpy(&d, &bits, sizeof(d));
+        mid = ((long double)d + (long double)nextafter(d, INFINITY)) / 2.0L;
+        for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+            int n = snprintf(s, sizeof(s), formats[f], (long double)d);
+            if (compare_input((const uint8_t *)s, (size_t)n) != 0) return -1;
+            n = snprintf(s, sizeof(s), formats[f], mid);
+            if (compare_input((const uint8_t *)s, (size_t)n) != 0) return -1;
+        }
+    }
+    return 0;
+}
+
+static int fixed_cases(void) {
+    static const char *const cases[] = {
+        "9007199254740993", "9007199254740992", "4503599627370496.5", "4503599627370497.5",
+        "2.2250738585072014e-308", "2.2250738585072011e-308", "4.9e-324", "1e-400",
+        "1.7976931348623157e308", "1.7976931348623159e308", "1e309", "-0", "-0.0e5",
+        "0.1", "0.3", "123456789012345678", "1234567890123456789", "12345678901234567890",
+        "0.000000000000000000000000000000000000000000000000001234567890123456789",
+        "1e22", "1e23", "8.98846567431158e307", "5e-324", "3.0e-20", "7.2057594037927933e16",
+        "1,2;3\t4 -5\n+6\n.7\n-.8\n+..9\n1e\n1e+\n2E-\n3e+x\n..\n-.\n+.e5",
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        if (compare_input((const uint8_t *)cases[c], strlen(cases[c])) != 0) return -1;
+    }
+    return 0;
+}
+
+/* Every whole value in record order, decoded one at a time */
+static void reference_typed(const typed_layout *t, const uint8_t *data, size_t len,
+                            byte_buffer *out) {
+    for (size_t rec = 0; rec * t->stride < len; rec++) {
+        for (size_t f = 0; f < t->per_record; f++) {
+            size_t off = rec * t->stride + f * t->width;
+            if (off + t->width > len) break;
+            buffer_append_u32_le(out, (uint32_t)off);
+            buffer_append_u32_le(out, (uint32_t)rec);
+            buffer_append_double_le(out, typed_value(t, data + off));
+        }
+    }
+}
+
+/*
+ * All formats and strides up to 40 bytes, over lengths that end inside
+ * values and records and that cross the 16 KiB slice boundary. The input is
+ * random bytes, so the float formats include NaNs, infinities and denormals.
+ */
+static int typed_cases(void) {
+    static uint8_t data[70000];
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)next_random();
+    }
+    for (uint32_t format = RDT_SEED_FORMAT_I16LE; format <= RDT_SEED_FORMAT_F64LE; format++) {
+        for (size_t stride = 0; stride <= 40u; stride++) {
+            typed_layout t;
+
+            if (typed_layout_init(&t, format, stride) != 0) continue;
+            for (size_t n = 0; n <= 240u; n++) {
+                size_t len = (n < 160u) ? n : (n - 160u) * 850u + n % 7u;
+                size_t cap = typed_value_count(&t, len) * 16u;
+                byte_buffer want, got;
+                uint32_t delims[DELIM_COUNT] = {0};
+                uint8_t hash[32];
+                uint8_t *store = (uint8_t *)malloc(cap + 1u);
+                int ok;
+
+                if (!store) return -1;
+                buffer_init(&want, cap);
+                buffer_borrow(&got, store, cap);
+                reference_typed(&t, data, len, &want);
+                extract_typed_features(&t, data, len, NULL, &got, delims, hash);
+                ok = !want.failed && !got.failed && want.len == got.len &&
+                     memcmp(want.data, got.data, want.len) == 0;
+                buffer_free(&want);
+                free(store);
+                checked++;
+                if (!ok) {
+                    fprintf(stderr, "typed mismatch: format %u, stride %zu, length %zu\n",
+                            format, stride, len);
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    if (fixed_cases() != 0 ||
+        exhaustive("0159.-+eE\n x", 5u) != 0 ||
+        exhaustive("05.-e\n", 7u) != 0 ||
+        long_tokens() != 0 ||
+        random_tokens(300000u) != 0 ||
+        near_halfway(100000u) != 0 ||
+        typed_cases() != 0) {
+        return 1;
+    }
+    printf("rdt_seed_numeric_test: ok (%lu scans)\n", checked);
+    return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * Tests for the SHA-256 module: FIPS 180-4, RFC 4231, RFC 5869 and
+ * PBKDF2-HMAC-SHA256 vectors, and the midstate PBKDF2 against plain
+ * rdt_hmac_sha256 iterations for output lengths on either side of a lane
+ * group and several thread counts.
+ */
+#include "rdt_sha256.h"
+#include "rdt_pool.h"
+#include "rdt_test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int matches_hex(const uint8_t *bytes, size_t len, const char *hex) {
+    char buf[3];
+
+    if (strlen(hex) != 2u * len) return 0;
+    for (size_t i = 0; i < len; i++) {
+        snprintf(buf, sizeof(buf), "%02x", bytes[i]);
+        if (memcmp(buf, hex + 2u * i, 2u) != 0) return 0;
+    }
+    return 1;
+}
+
+static void check_sha256(void) {
+    static const char *abc = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+    static const char *empty = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+    static const char *two_block = "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1";
+    static const char *million = "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0";
+    const char *msg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    uint8_t chunk[1000];
+    uint8_t hash[RDT_SHA256_DIGEST_SIZE];
+    rdt_sha256_ctx ctx;
+
+    rdt_sha256((const uint8_t *)"abc", 3, hash);
+    check(matches_hex(hash, sizeof(hash), abc), "sha256: abc");
+    rdt_sha256(NULL, 0, hash);
+    check(matches_hex(hash, sizeof(hash), empty), "sha256: empty");
+    rdt_sha256((const uint8_t *)msg, strlen(msg), hash);
+    check(matches_hex(hash, sizeof(hash), two_block), "sha256: two blocks");
+
+    /* Uneven updates cross block boundaries at every offset */
+    memset(chunk, 'a', sizeof(chunk));
+    rdt_sha256_init(&ctx);
+    for (size_t done = 0, step = 1; done < 1000000u; step = step % 997u + 1u) {
+        size_t take = (1000000u - done < step) ? 1000000u - done : step;
+        rdt_sha256_update(&ctx, chunk, take);
+        done += take;
+    }
+    rdt_sha256_final(&ctx, hash);
+    check(matches_hex(hash, sizeof(hash), million), "sha256: one million a");
+}
+
+static void check_hmac(void) {
+    static const char *jefe = "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843";
+    const char *data = "what do ya want for nothing?";
+    uint8_t mac[RDT_SHA256_DIGEST_SIZE];
+
+    rdt_hmac_sha256((const uint8_t *)"Jefe", 4, (const uint8_t *)data, strlen(data), mac);
+    check(matches_hex(mac, sizeof(mac), jefe), "hmac: RFC 4231 case 2");
+}
+
+static void check_hkdf(void) {
+    uint8_t ikm[80], salt[80], info[80];
+    uint8_t prk[RDT_SHA256_DIGEST_SIZE];
+    uint8_t okm[82];
+    uint8_t big[RDT_HKDF_SHA256_MAX_OUTPUT + 1u];
+
+    /* RFC 5869 A.1 */
+    memset(ikm, 0x0b, 22);
+    for (int i = 0; i < 13; i++) salt[i] = (uint8_t)i;
+    for (int i = 0; i < 10; i++) info[i] = (uint8_t)(0xf0 + i);
+    check(rdt_hkdf_sha256_extract(salt, 13, ikm, 22, prk) == 0, "hkdf: A.1 extract");
+    check(matches_hex(prk, sizeof(prk), "077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5"),
+          "hkdf: A.1 PRK");
+    check(rdt_hkdf_sha256(salt, 13, ikm, 22, info, 10, okm, 42) == 0, "hkdf: A.1");
+    check(matches_hex(okm, 42, "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf"
+                               "34007208d5b887185865"), "hkdf: A.1 OKM");
+
+    /* RFC 5869 A.2: long inputs, three blocks */
+    for (int i = 0; i < 80; i++) {
+        ikm[i] = (uint8_t)i;
+        salt[i] = (uint8_t)(0x60 + i);
+        info[i] = (uint8_t)(0xb0 + i);
+    }
+    check(rdt_hkdf_sha256(salt, 80, ikm, 80, info, 80, okm, 82) == 0, "hkdf: A.2");
+    check(matches_hex(okm, 82, "b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c"
+                               "59045a99cac7827271cb41c65e590e09da3275600c2f09b8367793a9aca3db71"
+                               "cc30c58179ec3e87c14c01d5c1f3434f1d87"), "hkdf: A.2 OKM");
+
+    /* RFC 5869 A.3: no salt, no info */
+    memset(ikm, 0x0b, 22);
+    check(rdt_hkdf_sha256(NULL, 0, ikm, 22, NULL, 0, okm, 42) == 0, "hkdf: A.3");
+    check(matches_hex(okm, 42, "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d"
+                               "9d201395faa4b61a96c8"), "hkdf: A.3 OKM");
+
+    check(rdt_hkdf_sha256_expand(prk, sizeof(prk), NULL, 0, big, RDT_HKDF_SHA256_MAX_OUTPUT) == 0,
+          "hkdf: 255 blocks allowed");
+    check(rdt_hkdf_sha256_expand(prk, sizeof(prk), NULL, 0, big, sizeof(big)) == -1,
+          "hkdf: 256 blocks rejected");
+    check(rdt_hkdf_sha256_expand(NULL, 32, NULL, 0, okm, 32) == -1, "hkdf: NULL PRK rejected");
+    check(rdt_hkdf_sha256_extract(NULL, 0, NULL, 1, prk) == -1, "hkdf: NULL IKM rejected");
+}
+
+/* PBKDF2 straight from RFC 8018, one full HMAC per iteration */
+static void reference_pbkdf2(const uint8_t *password, size_t password_len, const uint8_t *salt,
+                             size_t salt_len, uint32_t iterations, uint8_t *out, size_t out_len) {
+    uint8_t msg[256];
+    uint8_t u[RDT_SHA256_DIGEST_SIZE], t[RDT_SHA256_DIGEST_SIZE];
+
+    for (uint32_t block = 1; out_len; block++) {
+        size_t take = out_len < sizeof(t) ? out_len : sizeof(t);
+
+        memcpy(msg, salt, salt_len);
+        msg[salt_len] = (uint8_t)(block >> 24);
+        msg[salt_len + 1] = (uint8_t)(block >> 16);
+        msg[salt_len + 2] = (uint8_t)(block >> 8);
+        msg[salt_len + 3] = (uint8_t)block;
+        rdt_hmac_sha256(password, password_len, msg, salt_len + 4u, u);
+        memcpy(t, u, sizeof(t));
+        for (uint32_t c = 1; c < iterations; c++) {
+            rdt_hmac_sha256(password, password_len, u, sizeof(u), u);
+            for (size_t i = 0; i < sizeof(t); i++) t[i] ^= u[i];
+        }
+        memcpy(out, t, take);
+        out += take;
+        out_len -= take;
+    }
+}
+
+static void check_pbkdf2(void) {
+    static const uint8_t password[] = "password";
+    static const uint8_t salt[] = "salt";
+    static const size_t lengths[] = {1, 31, 32, 33, 64, 255, 256, 257, 300};
+    uint8_t out[300], want[300];
+    uint8_t long_password[100];
+
+    check(rdt_pbkdf2_sha256(password, 8, salt, 4, 1, out, 32) == 0, "pbkdf2: c=1");
+    check(matches_hex(out, 32, "120fb6cffcf8b32c43e7225256c4f837a86548c92ccc35480805987cb70be17b"), "pbkdf2: c=1 DK");
+    check(rdt_pbkdf2_sha256(password, 8, salt, 4, 2, out, 32) == 0, "pbkdf2: c=2");
+    check(matches_hex(out, 32, "ae4d0c95af6b46d32d0adff928f06dd02a303f8ef3c251dfd6e2d85a95474c43"), "pbkdf2: c=2 DK");
+    check(rdt_pbkdf2_sha256(password, 8, salt, 4, 4096, out, 32) == 0, "pbkdf2: c=4096");
+    check(matches_hex(out, 32, "c5e478d59288c841aa530db6845c4c8d962893a001ce4e11a4963873aa98134a"), "pbkdf2: c=4096 DK");
+
+    /* RFC 7914 section 11 */
+    check(rdt_pbkdf2_sha256((const uint8_t *)"passwd", 6, salt, 4, 1, out, 64) == 0, "pbkdf2: RFC 7914 1");
+    check(matches_hex(out, 64, "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+                               "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783"),
+          "pbkdf2: RFC 7914 1 DK");
+    check(rdt_pbkdf2_sha256((const uint8_t *)"Password", 8, (const uint8_t *)"NaCl", 4, 80000, out, 64) == 0,
+          "pbkdf2: RFC 7914 2");
+    check(matches_hex(out, 64, "4ddcd8f60b98be21830cee5ef22701f9641a4418d04c0414aeff08876b34ab56"
+                               "a1d425a1225833549adb841b51c9b3176a272bdebba1d078478f62b397f33c8d"),
+          "pbkdf2: RFC 7914 2 DK");
+
+    /* A password longer than a block is hashed before padding */
+    for (size_t i = 0; i < sizeof(long_password); i++) long_password[i] = (uint8_t)(i * 37u + 1u);
+    for (unsigned threads = 1; threads <= 4; threads += 3) {
+        rdt_pool_set_threads(threads);
+        for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+            reference_pbkdf2(long_password, sizeof(long_password), salt, 4, 37, want, lengths[i]);
+            memset(out, 0xAA, sizeof(out));
+            check(rdt_pbkdf2_sha256(long_password, sizeof(long_password), salt, 4, 37, out, lengths[i]) == 0 &&
+                  memcmp(out, want, lengths[i]) == 0,
+                  "pbkdf2: matches plain HMAC iterations");
+            check(lengths[i] == sizeof(out) || out[lengths[i]] == 0xAA, "pbkdf2: no write past the output");
+        }
+    }
+    rdt_pool_set_threads(0);
+
+    check(rdt_pbkdf2_sha256(password, 8, salt, 4, 0, out, 32) == -1, "pbkdf2: zero iterations rejected");
+    check(rdt_pbkdf2_sha256(password, 8, salt, 4, 1, NULL, 32) == -1, "pbkdf2: NULL output rejected");
+    check(rdt_pbkdf2_sha256(password, 8, salt, 4, 1, out, 0) == -1, "pbkdf2: empty output rejected");
+    check(rdt_pbkdf2_sha256(NULL, 8, salt, 4, 1, out, 32) == -1, "pbkdf2: NULL password rejected");
+}
+
+int main(void) {
+    check_sha256();
+    check_hmac();
+    check_hkdf();
+    check_pbkdf2();
+
+    return test_finish("rdt_sha256_test");
+}
@@ -0,0 +1,333 @@
+/*
+ * Tests for the instrumentation counters (built with -DRDT_STATS): the
+ * rdt_mix depth histogram against a reference rdt_depth_fast, SHA-256
+ * compression counts from the padded length, DRBG generate / update /
+ * reseed steps for both DRBGs, PRNG output bytes, seed-extractor stages,
+ * and totals across threads, including blocks handed on after thread exit,
+ * and which mixer large extractions take inside and outside pool tasks.
+ * Every check compares the difference between two snapshots.
+ */
+#include "rdt_stats.h"
+#include "rdt.h"
+#include "rdt_core.h"
+#include "rdt_drbg.h"
+#include "rdt_drbg_v2.h"
+#include "rdt_sha256.h"
+#include "rdt256_stream_v2.h"
+#include "rdt_seed_extractor.h"
+#include "rdt_pool.h"
+#include "rdt_test.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MIX_THREADS 4
+#define MIX_CALLS_PER_THREAD 1000u
+#define BATCH_FILES 3
+#define BATCH_FILE_BYTES (1100u * 1024u)
+
+static rdt_stats snap(void) {
+    rdt_stats s;
+    check(rdt_stats_snapshot(&s) == 0, "snapshot succeeds");
+    return s;
+}
+
+/* Same as rdt_core.c */
+static uint32_t ref_depth(uint64_t x) {
+    uint32_t bl = x ? (uint32_t)(64u - (uint32_t)__builtin_clzll(x)) : 0u;
+    uint32_t pc = (uint32_t)__builtin_popcountll(x);
+    uint32_t mid = bl ? (uint32_t)(x >> (bl >> 1)) : 0u;
+    return (bl ^ (pc << 1) ^ mid) & 63u;
+}
+
+static void check_mix(void) {
+    static const uint64_t K[4] = {1, 2, 3, 4};
+    uint64_t expect[RDT_STATS_DEPTHS] = {0};
+    uint64_t x = 0x0123456789ABCDEFULL;
+    uint64_t in4[4] = {0, 1, ~0ULL, 0x8000000000000000ULL};
+    uint64_t out4[4];
+    rdt_stats a = snap(), b;
+    int same = 1;
+
+    for (unsigned i = 0; i < 5000u; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t v = (i & 7u) ? x : x >> (i % 64u);
+        expect[ref_depth(v)]++;
+        (void)rdt_mix(v, K);
+    }
+    rdt_mix4(in4, K, out4);
+    for (unsigned l = 0; l < 4u; l++) expect[ref_depth(in4[l])]++;
+
+    b = snap();
+    check(b.mix_calls - a.mix_calls == 5004u, "mix: one count per rdt_mix call and rdt_mix4 lane");
+    for (unsigned d = 0; d < RDT_STATS_DEPTHS; d++) {
+        if (b.mix_depth[d] - a.mix_depth[d] != expect[d]) same = 0;
+    }
+    check(same, "mix: depth histogram matches rdt_depth_fast");
+}
+
+static void check_sha256(void) {
+    static const size_t lengths[] = {0, 55, 56, 64, 119, 120, 1000};
+    static uint8_t data[1000];
+
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        uint8_t digest[32];
+        rdt_stats a = snap(), b;
+
+        rdt_sha256(data, lengths[i], digest);
+        b = snap();
+        check(b.sha256_compressions - a.sha256_compressions == (lengths[i] + 9u + 63u) / 64u,
+              "sha256: one compression per padded block");
+    }
+}
+
+static void check_prng(void) {
+    uint8_t buf[100];
+    rdt_stats a, b;
+
+    rdt_prng_init(42);
+    a = snap();
+    for (int i = 0; i < 10; i++) (void)rdt_prng_next();
+    b = snap();
+    check(b.prng_bytes - a.prng_bytes == 80u, "prng: 8 bytes per rdt_prng_next");
+
+    a = snap();
+    (void)rdt_prng_v2_next();
+    rdt_prng_v2_fill(buf, sizeof(buf));
+    b = snap();
+    check(b.prng_v2_bytes - a.prng_v2_bytes == 8u + 104u, "prng v2: whole words, fill rounds up");
+}
+
+static void check_drbg(void) {
+    static const uint8_t entropy[48] = {1};
+    static const uint8_t extra[32] = {2};
+    uint8_t out[100];
+    rdt_drbg_ctx ctx;
+    rdt_stats a, b;
+
+    a = snap();
+    rdt_drbg_ctx_init_u64(&ctx, 1, 2, 3);
+    b = snap();
+    check(b.drbg_updates - a.drbg_updates == 1u && b.drbg_generates == a.drbg_generates,
+          "drbg: init is one update");
+
+    a = snap();
+    check(rdt_drbg_ctx_generate(&ctx, out, sizeof(out), NULL, 0, 0) == 0, "drbg: generate");
+    check(rdt_drbg_ctx_generate(&ctx, out, 16, extra, sizeof(extra), 0) == 0, "drbg: generate with input");
+    b = snap();
+    check(b.drbg_generates - a.drbg_generates == 2u, "drbg: generates counted");
+    check(b.drbg_updates - a.drbg_updates == 3u, "drbg: additional input adds an update");
+    check(b.drbg_bytes - a.drbg_bytes == sizeof(out) + 16u, "drbg: bytes counted");
+
+    a = snap();
+    rdt_drbg_ctx_reseed(&ctx, entropy, sizeof(entropy), NULL, 0);
+    b = snap();
+    check(b.drbg_reseeds - a.drbg_reseeds == 1u && b.drbg_updates - a.drbg_updates == 1u,
+          "drbg: reseed is one update");
+}
+
+static void check_drbg_v2(void) {
+    static const uint8_t entropy[48] = {3};
+    static const uint8_t extra[32] = {4};
+    uint8_t out[100];
+    rdt_drbg_v2_ctx ctx;
+    rdt_stats a, b;
+
+    a = snap();
+    check(rdt_drbg_v2_instantiate(&ctx, entropy, sizeof(entropy), NULL, 0, NULL, 0) == RDT_DRBG_V2_OK,
+          "drbg v2: instantiate");
+    b = snap();
+    check(b.drbg_v2_updates - a.drbg_v2_updates == 1u && b.drbg_v2_reseeds == a.drbg_v2_reseeds,
+          "drbg v2: instantiate is one update");
+
+    a = snap();
+    check(rdt_drbg_v2_generate(&ctx, out, sizeof(out), NULL, 0, 0) == RDT_DRBG_V2_OK, "drbg v2: generate");
+    check(rdt_drbg_v2_generate(&ctx, out, 16, extra, sizeof(extra), 0) == RDT_DRBG_V2_OK,
+          "drbg v2: generate with input");
+    check(rdt_drbg_v2_generate(&ctx, out, sizeof(out), NULL, 0, 1) != RDT_DRBG_V2_OK,
+          "drbg v2: prediction resistance refused");
+    b = snap();
+    check(b.drbg_v2_generates - a.drbg_v2_generates == 2u, "drbg v2: only successful generates counted");
+    check(b.drbg_v2_updates - a.drbg_v2_updates == 3u, "drbg v2: additional input adds an update");
+    check(b.drbg_v2_bytes - a.drbg_v2_bytes == sizeof(out) + 16u, "drbg v2: bytes counted");
+
+    a = snap();
+    check(rdt_drbg_v2_reseed(&ctx, entropy, sizeof(entropy), NULL, 0) == RDT_DRBG_V2_OK, "drbg v2: reseed");
+    b = snap();
+    check(b.drbg_v2_reseeds - a.drbg_v2_reseeds == 1u && b.drbg_v2_updates - a.drbg_v2_updates == 1u,
+          "drbg v2: reseed is one update");
+    rdt_drbg_v2_zeroize(&ctx);
+}
+
+static void check_seed_extractor(void) {
+    static const char text[] = "alpha 1.5 beta 2.25 gamma 3 delta 4e3\nepsilon, zeta; eta: 42\n";
+    uint8_t seed[32];
+    rdt_stats a = snap(), b;
+
+    check(rdt_seed_extract((const uint8_t *)text, sizeof(text) - 1u, seed) == 0, "seed: extract");
+    b = snap();
+    check(b.seed_extractions - a.seed_extractions == 1u, "seed: one extraction");
+    check(b.seed_input_bytes - a.seed_input_bytes == sizeof(text) - 1u, "seed: input bytes");
+    check(b.seed_mix_ns > a.seed_mix_ns, "seed: mixer stage timed");
+    check(b.sha256_compressions > a.sha256_compressions, "seed: final hash counted");
+}
+
+/* One file per task with its own arena, as rdt_seed_extractor --each does */
+typedef struct {
+    char paths[BATCH_FILES][64];
+    uint8_t seeds[BATCH_FILES][32];
+    int status[BATCH_FILES];
+} batch_files;
+
+static void batch_task(void *arg, size_t index) {
+    batch_files *job = (batch_files *)arg;
+    rdt_seed_arena arena;
+
+    rdt_seed_arena_init(&arena);
+    job->status[index] = rdt_seed_extract_file_arena(&arena, job->paths[index], job->seeds[index]);
+    rdt_seed_arena_release(&arena);
+}
+
+static int run_batch(batch_files *job, unsigned threads, uint64_t *parallel_mixes) {
+    rdt_stats a, b;
+
+    rdt_pool_set_threads(threads);
+    a = snap();
+    rdt_pool_run(BATCH_FILES, batch_task, job);
+    b = snap();
+    *parallel_mixes = b.seed_mix_parallel - a.seed_mix_parallel;
+    for (int i = 0; i < BATCH_FILES; i++) {
+        if (job->status[i] != 0) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Dense numeric files over 1 MiB give pools well past the level-by-level
+ * mixer threshold. Inside batch tasks the pool is busy, so the recursive
+ * mixer must run there; the idle caller gets the level-by-level one. Seeds
+ * are the same either way.
+ */
+static void check_batch_mixer(void) {
+    static batch_files one, four;
+    uint8_t *text = (uint8_t *)malloc(BATCH_FILE_BYTES);
+    uint8_t seed[32];
+    uint64_t state = 7, mixes = 0;
+    rdt_stats a, b;
+    int ok = text != NULL;
+
+    for (int i = 0; ok && i < BATCH_FILES; i++) {
+        FILE *f;
+
+        snprintf(one.paths[i], sizeof(one.paths[i]), "/tmp/rdt_stats_batch_%ld_%d.csv", (long)getpid(), i);
+        memcpy(four.paths[i], one.paths[i], sizeof(one.paths[i]));
+        for (size_t j = 0; j + 1u < BATCH_FILE_BYTES; j += 2u) {
+            text[j] = (uint8_t)('0' + splitmix64(&state) % 10u);
+            text[j + 1u] = (j % 40u == 38u) ? '\n' : ',';
+        }
+        f = fopen(one.paths[i], "wb");
+        ok = f && fwrite(text, 1, BATCH_FILE_BYTES, f) == BATCH_FILE_BYTES;
+        if (f) ok = (fclose(f) == 0) && ok;
+    }
+    free(text);
+    check(ok, "batch: fixtures written");
+
+    if (ok) {
+        check(run_batch(&one, 1u, &mixes) && mixes == 0u, "batch: -j 1 runs the recursive mixer");
+        check(run_batch(&four, 4u, &mixes) && mixes == 0u, "batch: tasks at -j 4 run the recursive mixer");
+        check(memcmp(one.seeds, four.seeds, sizeof(one.seeds)) == 0, "batch: same seeds at -j 1 and -j 4");
+
+        a = snap();
+        check(rdt_seed_extract_file(one.paths[0], seed) == 0 && memcmp(seed, one.seeds[0], 32) == 0,
+              "batch: idle caller gives the same seed");
+        b = snap();
+        check(b.seed_mix_parallel - a.seed_mix_parallel == 1u, "batch: idle caller mixes level by level");
+    }
+    rdt_pool_set_threads(0);
+    for (int i = 0; i < BATCH_FILES; i++) {
+        unlink(one.paths[i]);
+    }
+}
+
+static void *mix_worker(void *arg) {
+    static const uint64_t K[4] = {5, 6, 7, 8};
+    uint64_t x = (uint64_t)(size_t)arg;
+
+    for (unsigned i = 0; i < MIX_CALLS_PER_THREAD; i++) x = rdt_mix(x + i, K);
+    return NULL;
+}
+
+static int run_mix_threads(void) {
+    pthread_t threads[MIX_THREADS];
+    int started = 0;
+
+    for (int t = 0; t < MIX_THREADS; t++) {
+        if (pthread_create(&threads[t], NULL, mix_worker, (void *)(size_t)(t + 1)) != 0) break;
+        started++;
+    }
+    for (int t = 0; t < started; t++) pthread_join(threads[t], NULL);
+    return started;
+}
+
+static void check_threads(void) {
+    rdt_stats a = snap(), b, c;
+    int started;
+
+    started = run_mix_threads();
+    b = snap();
+    check(started == MIX_THREADS, "threads: started");
+    check(b.mix_calls - a.mix_calls == (uint64_t)started * MIX_CALLS_PER_THREAD,
+          "threads: counts kept after exit");
+    check(b.threads > a.threads && b.threads <= a.threads + MIX_THREADS, "threads: one block per thread");
+
+    /* Joined threads have released their blocks; later threads take them over */
+    for (int t = 0; t < MIX_THREADS; t++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, mix_worker, NULL) != 0) {
+            check(0, "threads: sequential start");
+            return;
+        }
+        pthread_join(thread, NULL);
+    }
+    c = snap();
+    check(c.mix_calls - b.mix_calls == MIX_THREADS * MIX_CALLS_PER_THREAD, "threads: sequential counts");
+    check(c.threads == b.threads, "threads: blocks reused after exit");
+}
+
+static void check_json(void) {
+    rdt_stats s = snap();
+    char buf[4096];
+    size_t n;
+    FILE *f = tmpfile();
+
+    if (!f) {
+        check(0, "json: tmpfile");
+        return;
+    }
+    check(rdt_stats_write_json(f, &s) == 0, "json: written");
+    check(rdt_stats_write_json(f, NULL) == -1, "json: NULL snapshot rejected");
+    rewind(f);
+    n = fread(buf, 1, sizeof(buf) - 1u, f);
+    buf[n] = '\0';
+    fclose(f);
+    check(strncmp(buf, "{\n  \"enabled\": true,\n", 21) == 0, "json: enabled");
+    check(strstr(buf, "\"drbg_v2_reseeds\": ") != NULL, "json: counter field");
+    check(strstr(buf, "\"mix_depth\": [") != NULL && buf[n - 2u] == '}', "json: depth array and close");
+}
+
+int main(void) {
+    check_mix();
+    check_sha256();
+    check_prng();
+    check_drbg();
+    check_drbg_v2();
+    check_seed_extractor();
+    check_threads();
+    check_batch_mixer();
+    check_json();
+
+    return test_finish("rdt_stats_test");
+}
@@ -0,0 +1,38 @@
+/*
+ * Shared harness for the standalone tests that collect failures instead of
+ * stopping at the first one: check() reports a failed condition and carries
+ * on, test_finish() prints the verdict and gives main's exit status.
+ * splitmix64() generates reproducible fixture data.
+ */
+#ifndef RDT_TEST_H
+#define RDT_TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+static inline void check(int ok, const char *what) {
+    if (!ok) {
+        fprintf(stderr, "FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static inline int test_finish(const char *name) {
+    if (failures) {
+        fprintf(stderr, "%s: %d check(s) failed\n", name, failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+static inline uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+#endif /* RDT_TEST_H */
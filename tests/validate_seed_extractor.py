@@ -16,13 +16,16 @@ EXAMPLE = ROOT / "examples" / "sensor_data.csv"
 EXAMPLE_REL = EXAMPLE.relative_to(ROOT).as_posix()
 EXPECTED_SINGLE = "f2cb746be11d12125cacd7d2b3e09a9dd7f9775dde8e12edfdc0391a920b1e8e"
 EXPECTED_DOUBLE = "654a9d34e91286afe2203ee6eddfd108021bd966046f737bea5b6f5b94af60a1"
+EXPECTED_STREAM = "b0a229c8b17728b699725bf3484f852f0d16d39c0798204d40874aa983bef3aa"
+EXPECTED_V2 = "1a06bdd4aebe4ae6584693b59df44a91662341583de9a5ede576540d704ab957"
 
 
-def run_seed(args: list[str], binary: bool = False) -> bytes | str:
+def run_seed(args: list[str], binary: bool = False, stdin: bytes | None = None) -> bytes | str:
     result = subprocess.run(
         ["./rdt_seed_extractor", *args],
         cwd=ROOT,
         check=True,
+        input=stdin,
         stdout=subprocess.PIPE,
         stderr=subprocess.PIPE,
     )
@@ -47,6 +50,89 @@ def measure_cli(sample_runs: int) -> tuple[list[float], str]:
     return timings, last
 
 
+def check_batch_mode() -> None:
+    """--each and --from-list must match one process per file, in input order."""
+    source = EXAMPLE.read_bytes()
+    with tempfile.TemporaryDirectory(dir=ROOT) as tmp:
+        tmp_dir = Path(tmp)
+        (tmp_dir / "nested").mkdir()
+        expected = []
+        for i, cut in enumerate((len(source), 97, len(source) // 3, len(source) - 1)):
+            sub = "nested" if i % 2 else ""
+            path = tmp_dir / sub / f"part{i}.csv"
+            path.write_bytes(source[:cut])
+        for path in sorted(p.relative_to(ROOT).as_posix() for p in tmp_dir.rglob("*.csv")):
+            expected.append(f"{path}\t{run_seed([path])}")
+        rel_dir = tmp_dir.relative_to(ROOT).as_posix()
+
+        batch = run_seed(["--each", "-j", "3", rel_dir])
+        if batch.splitlines() != expected:
+            raise SystemExit("--each output does not match per-file extraction")
+
+        list_file = tmp_dir / "list.txt"
+        list_file.write_text("\n".join(line.split("\t")[0] for line in expected) + "\n", encoding="utf-8")
+        listed = run_seed(["--from-list", list_file.relative_to(ROOT).as_posix()])
+        if listed.splitlines() != expected:
+            raise SystemExit("--from-list output does not match per-file extraction")
+
+
+def check_batch_large() -> None:
+    """Files over 1 MiB in --each must give the same seeds at -j 1 and -j 4."""
+    source = EXAMPLE.read_bytes()
+    with tempfile.TemporaryDirectory(dir=ROOT) as tmp:
+        tmp_dir = Path(tmp)
+        expected = []
+        for i, copies in enumerate((1800, 2100, 2400)):
+            # large enough for the level-by-level mixer outside a batch
+            path = tmp_dir / f"large{i}.csv"
+            path.write_bytes(source * copies)
+            rel = path.relative_to(ROOT).as_posix()
+            expected.append(f"{rel}\t{run_seed(['-j', '4', rel])}")
+        rel_dir = tmp_dir.relative_to(ROOT).as_posix()
+
+        for threads in ("1", "4"):
+            batch = run_seed(["--each", "-j", threads, rel_dir])
+            if batch.splitlines() != expected:
+                raise SystemExit(f"--each -j {threads} does not match per-file extraction on large files")
+
+
+def check_stdin_and_follow() -> None:
+    """- must match the file; --follow --every must give stream seeds of each prefix."""
+    source = EXAMPLE.read_bytes()
+    if run_seed(["-"], stdin=source) != EXPECTED_SINGLE:
+        raise SystemExit("stdin seed does not match the file seed")
+
+    followed = run_seed(["--follow", "--every", "250", "-"], stdin=source).splitlines()
+    if len(followed) != 3 or followed[-1] != EXPECTED_STREAM:
+        raise SystemExit(f"unexpected --follow output: {followed}")
+    prefix = run_seed(["--follow", "--every", "250", "-"], stdin=source[:250])
+    if prefix != followed[0]:
+        raise SystemExit("--follow seed does not match the stream seed of its prefix")
+
+
+def check_tree_mode() -> None:
+    """--v2 must match its vector on every input path and not depend on -j."""
+    source = EXAMPLE.read_bytes()
+    if run_seed(["--v2", EXAMPLE_REL]) != EXPECTED_V2:
+        raise SystemExit("unexpected --v2 seed")
+    if run_seed(["--v2", "-"], stdin=source) != EXPECTED_V2:
+        raise SystemExit("--v2 stdin seed does not match the file seed")
+
+    with tempfile.NamedTemporaryFile(dir=ROOT, suffix=".csv", delete=False) as tmp:
+        # several leaves, the last one partial
+        tmp.write(source * 3000)
+        tmp_path = Path(tmp.name)
+    try:
+        rel = tmp_path.relative_to(ROOT).as_posix()
+        seeds = {run_seed(["-j", str(threads), "--v2", rel]) for threads in (1, 3, 8)}
+        if len(seeds) != 1:
+            raise SystemExit("--v2 seed depends on the thread count")
+        if seeds == {run_seed([rel])}:
+            raise SystemExit("--v2 seed equals the v1 seed")
+    finally:
+        tmp_path.unlink(missing_ok=True)
+
+
 def main() -> None:
     subprocess.run(["make", "rdt_seed_extractor"], cwd=ROOT, check=True)
 
@@ -64,6 +150,11 @@ def main() -> None:
     if binary_seed.hex() != EXPECTED_SINGLE:
         raise SystemExit("binary output mismatch")
 
+    check_batch_mode()
+    check_batch_large()
+    check_stdin_and_follow()
+    check_tree_mode()
+
     repeated = [run_seed([EXAMPLE_REL]) for _ in range(8)]
     if len(set(repeated)) != 1:
         raise SystemExit("seed extraction is not deterministic across repeated runs")